@@ -0,0 +1,100 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+"""
+benchmark of the deframing in mp2_decode_bs: unpacked bits (bitwise syncword search and
+frame assembly), packed bytes (byte aligned frames decoded in place) and packed bytes with
+the frames at a bit offset (bitwise fallback), in microseconds per MP2 frame; the frames
+are decoded the same way on all paths, so the differences are the deframing overhead
+"""
+
+from gnuradio import gr, blocks
+from gnuradio.eng_option import eng_option
+from optparse import OptionParser
+import dab
+import math
+import time
+
+
+def mp2_frame(samples, bit_rate):
+    # MPEG-2 LSF layer II frame at 24 kHz, mono and no CRC, only subband 0 is allocated
+    bits = []
+
+    def put(value, length):
+        bits.extend([(value >> (length - 1 - i)) & 1 for i in range(length)])
+
+    put(0xFFF5, 16)  # syncword, MPEG-2, layer II, no CRC
+    put(bit_rate // 8, 4)  # bit rate index (8 kbit/s steps up to 64 kbit/s)
+    put(1, 2)  # 24 kHz
+    put(0, 2)  # no padding, private bit
+    put(0xC, 4)  # mono
+    put(0, 4)  # copyright, original, emphasis
+    put(5, 4)  # allocation of subband 0
+    put(0, 3 * 4 + 7 * 3 + 19 * 2)  # subbands 1 to 29 are not allocated
+    put(2, 2)  # scfsi: one scalefactor for all parts
+    put(6, 6)  # scalefactor
+    for s in samples:  # 3 parts * 4 granules * 3 samples
+        put(s, 5)
+    put(0, 6 * bit_rate * 8 - len(bits))
+    return bits
+
+
+def pack(bits):
+    return [sum(bits[8 * i + k] << (7 - k) for k in range(8)) for i in range(len(bits) // 8)]
+
+
+def run_benchmark(data, packed, bit_rate, num_frames):
+    tb = gr.top_block()
+    src = blocks.vector_source_b(data, True)
+    # 24 kHz: one MP2 frame per 48 ms
+    head = blocks.head(gr.sizeof_char, num_frames * 6 * bit_rate * (1 if packed else 8))
+    mp2_decode = dab.mp2_decode_bs_make(bit_rate // 8, False, packed)
+    tb.connect(src, head, mp2_decode)
+    for i in range(4):
+        tb.connect((mp2_decode, i), blocks.null_sink(gr.sizeof_short if i < 2 else gr.sizeof_float))
+    start = time.time()
+    tb.run()
+    return (time.time() - start) / num_frames
+
+
+def main():
+    parser = OptionParser(option_class=eng_option, usage="%prog: [options]")
+    parser.add_option("-b", "--bit-rate", type="int", default=64,
+                      help="bit rate in kbit/s, a multiple of 8 up to 64 [default=%default]")
+    parser.add_option("-n", "--num-frames", type="int", default=20000,
+                      help="number of MP2 frames per run [default=%default]")
+    parser.add_option("-r", "--runs", type="int", default=3,
+                      help="number of runs, the best one is reported [default=%default]")
+    (options, args) = parser.parse_args()
+
+    bits = []
+    for f in range(50):
+        bits += mp2_frame([int(round(15 + 14 * math.sin(0.3 * (36 * f + n)))) for n in range(36)], options.bit_rate)
+    paths = [("unpacked bits", bits, False),
+             ("packed bytes", pack(bits), True),
+             ("packed, bit offset 3", pack([0, 1, 1] + bits + [0] * 5), True)]
+    for (name, data, packed) in paths:
+        duration = min(run_benchmark(data, packed, options.bit_rate, options.num_frames) for _ in range(options.runs))
+        print("%-22s %8.2f us per frame" % (name, duration * 1e6))
+
+
+if __name__ == '__main__':
+    main()
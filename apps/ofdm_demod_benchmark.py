@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+"""
+benchmark of the OFDM demodulation after the synchronization:
+the single block chain (fft_vcc, multiply_const_vcc, ofdm_coarse_frequency_correction_vcvc,
+diff_phasor_vcc, frequency_interleaver_vcc) against ofdm_demod_core_vcvc, in symbols per second
+"""
+
+from gnuradio import gr, blocks, fft
+from gnuradio.eng_option import eng_option
+from optparse import OptionParser
+from math import sqrt
+import dab
+import pmt
+import random
+import time
+
+
+def run_benchmark(dp, num_symbols, fused):
+    tb = gr.top_block()
+    # one frame of random samples with the frame start tag, repeated
+    frame = [complex(random.gauss(0, 1), random.gauss(0, 1))
+             for _ in range(dp.symbols_per_frame * dp.fft_length)]
+    tag = gr.tag_t()
+    tag.offset = 0
+    tag.key = pmt.intern("Start")
+    tag.value = pmt.from_float(0)
+    src = blocks.vector_source_c(frame, True, 1, [tag])
+    head = blocks.head(gr.sizeof_gr_complex, num_symbols * dp.fft_length)
+    s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, dp.fft_length)
+    sink = blocks.null_sink(gr.sizeof_gr_complex * dp.num_carriers)
+    if fused:
+        demod = [dab.ofdm_demod_core_vcvc_make(dp.fft_length, dp.num_carriers,
+                                               dp.frequency_deinterleaving_sequence_array)]
+    else:
+        demod = [fft.fft_vcc(dp.fft_length, True, [], True),
+                 blocks.multiply_const_vcc([1.0 / sqrt(2048)] * dp.fft_length),
+                 dab.ofdm_coarse_frequency_correction_vcvc_make(dp.fft_length, dp.num_carriers, dp.cp_length),
+                 dab.diff_phasor_vcc_make(dp.num_carriers),
+                 dab.frequency_interleaver_vcc_make(dp.frequency_deinterleaving_sequence_array)]
+    tb.connect(*([src, head, s2v] + demod + [sink]))
+    start = time.time()
+    tb.run()
+    return num_symbols / (time.time() - start)
+
+
+def main():
+    parser = OptionParser(option_class=eng_option, usage="%prog: [options]")
+    parser.add_option("-m", "--dab-mode", type="int", default=1,
+                      help="DAB mode [default=%default]")
+    parser.add_option("-n", "--num-symbols", type="int", default=100000,
+                      help="number of OFDM symbols per run [default=%default]")
+    parser.add_option("-r", "--runs", type="int", default=3,
+                      help="number of runs, the best one is reported [default=%default]")
+    (options, args) = parser.parse_args()
+
+    dp = dab.parameters.dab_parameters(options.dab_mode, verbose=False)
+    for (name, fused) in [("single blocks", False), ("ofdm_demod_core_vcvc", True)]:
+        rate = max(run_benchmark(dp, options.num_symbols, fused) for _ in range(options.runs))
+        print("%-22s %10.0f symbols/s (%.1f x real time)" %
+              (name, rate, rate * dp.frame_length / float(dp.symbols_per_frame) / dp.sample_rate))
+
+
+if __name__ == '__main__':
+    main()
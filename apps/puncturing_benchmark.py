@@ -0,0 +1,146 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+"""
+benchmark of unpuncture_vff (receiver) and puncture_bb (transmitter)
+for the FIC and the EEP-A protection levels of parameters.py at several bit rates,
+in soft bits per second of the unpunctured codeword; the blocks are compared with
+a numpy reference of the puncturing, which also checks their output
+"""
+
+from gnuradio import gr, blocks
+from gnuradio.eng_option import eng_option
+from optparse import OptionParser
+import dab
+import numpy
+import time
+
+# the sources repeat this many codewords
+NUM_SOURCE_CODEWORDS = 16
+
+
+def unpuncture_reference(puncturing_vector, data, fillval=0):
+    """ unpunctured codewords: the input at the ones of the puncturing vector, fillval at the zeros """
+    mask = numpy.array(puncturing_vector, dtype=bool)
+    out = numpy.full((len(data) // mask.sum(), len(mask)), fillval, dtype=numpy.float32)
+    out[:, mask] = numpy.reshape(data, (-1, mask.sum()))
+    return out.ravel()
+
+
+def puncture_reference(puncturing_vector, data):
+    """ punctured codewords: the input at the ones of the puncturing vector """
+    mask = numpy.array(puncturing_vector, dtype=bool)
+    return numpy.reshape(data, (-1, len(mask)))[:, mask].ravel()
+
+
+def run_reference(reference, puncturing_vector, data, num_codewords):
+    start = time.time()
+    for _ in range(num_codewords // NUM_SOURCE_CODEWORDS):
+        reference(puncturing_vector, data)
+    return num_codewords // NUM_SOURCE_CODEWORDS * NUM_SOURCE_CODEWORDS * len(puncturing_vector) / (time.time() - start)
+
+
+def run_block(src, block, sink, head=None):
+    tb = gr.top_block()
+    if head is None:
+        tb.connect(src, block, sink)
+    else:
+        tb.connect(src, head, block, sink)
+    start = time.time()
+    tb.run()
+    return time.time() - start
+
+
+def unpuncture_data(puncturing_vector):
+    return numpy.random.normal(0, 1, sum(puncturing_vector) * NUM_SOURCE_CODEWORDS).astype(numpy.float32)
+
+
+def puncture_data(puncturing_vector):
+    return numpy.random.randint(0, 2, len(puncturing_vector) * NUM_SOURCE_CODEWORDS).astype(numpy.uint8)
+
+
+def run_unpuncture(puncturing_vector, data, num_codewords):
+    ones = sum(puncturing_vector)
+    src = blocks.vector_source_f(data.tolist(), True, ones)
+    head = blocks.head(gr.sizeof_float * ones, num_codewords)
+    sink = blocks.null_sink(gr.sizeof_float * len(puncturing_vector))
+    duration = run_block(src, dab.unpuncture_vff_make(puncturing_vector, 0), sink, head=head)
+    return num_codewords * len(puncturing_vector) / duration
+
+
+def run_puncture(puncturing_vector, data, num_codewords):
+    src = blocks.vector_source_b(data.tolist(), True)
+    head = blocks.head(gr.sizeof_char, num_codewords * len(puncturing_vector))
+    sink = blocks.null_sink(gr.sizeof_char)
+    duration = run_block(src, dab.puncture_bb_make(puncturing_vector), sink, head=head)
+    return num_codewords * len(puncturing_vector) / duration
+
+
+def check_unpuncture(puncturing_vector, data):
+    sink = blocks.vector_sink_f(len(puncturing_vector))
+    run_block(blocks.vector_source_f(data.tolist(), False, sum(puncturing_vector)),
+              dab.unpuncture_vff_make(puncturing_vector, 0), sink)
+    return numpy.array_equal(numpy.array(sink.data(), dtype=numpy.float32),
+                             unpuncture_reference(puncturing_vector, data))
+
+
+def check_puncture(puncturing_vector, data):
+    sink = blocks.vector_sink_b()
+    run_block(blocks.vector_source_b(data.tolist()), dab.puncture_bb_make(puncturing_vector), sink)
+    return numpy.array_equal(numpy.array(sink.data(), dtype=numpy.uint8),
+                             puncture_reference(puncturing_vector, data))
+
+
+def main():
+    parser = OptionParser(option_class=eng_option, usage="%prog: [options]")
+    parser.add_option("-b", "--bit-rates", type="string", default="32,64,128,192",
+                      help="comma separated sub-channel bit rates in kbit/s, multiples of 8 [default=%default]")
+    parser.add_option("-n", "--num-codewords", type="int", default=20000,
+                      help="number of codewords per run [default=%default]")
+    parser.add_option("-r", "--runs", type="int", default=3,
+                      help="number of runs, the best one is reported [default=%default]")
+    (options, args) = parser.parse_args()
+
+    dp = dab.parameters.dab_parameters(1, verbose=False)
+    profiles = [("FIC", dp.assembled_fic_puncturing_sequence)]
+    for bit_rate in [int(b) for b in options.bit_rates.split(",")]:
+        for protection in range(4):
+            size = bit_rate // 8 * dp.subch_size_multiple_n[protection]
+            msc = dab.msc_decode(dp, 0, size, protection)
+            profiles.append(("EEP %d-A %d kbit/s (%d CUs)" % (protection + 1, bit_rate, size),
+                             msc.assembled_msc_puncturing_sequence))
+
+    print("%-30s %31s   %31s" % ("Mbit/s", "unpuncture_vff numpy/block", "puncture_bb numpy/block"))
+    for (name, puncturing_vector) in profiles:
+        result = []
+        for (data, reference, run, check) in [
+                (unpuncture_data(puncturing_vector), unpuncture_reference, run_unpuncture, check_unpuncture),
+                (puncture_data(puncturing_vector), puncture_reference, run_puncture, check_puncture)]:
+            numpy_rate = max(run_reference(reference, puncturing_vector, data, options.num_codewords)
+                             for _ in range(options.runs))
+            block_rate = max(run(puncturing_vector, data, options.num_codewords) for _ in range(options.runs))
+            result += [numpy_rate / 1e6, block_rate / 1e6, block_rate / numpy_rate,
+                       "ok" if check(puncturing_vector, data) else "FAIL"]
+        print("%-30s %8.1f %8.1f (%5.1fx) %4s   %8.1f %8.1f (%5.1fx) %4s" % tuple([name] + result))
+
+
+if __name__ == '__main__':
+    main()
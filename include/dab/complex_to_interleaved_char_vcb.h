@@ -0,0 +1,65 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DAB_COMPLEX_TO_INTERLEAVED_CHAR_VCB_H
+#define INCLUDED_DAB_COMPLEX_TO_INTERLEAVED_CHAR_VCB_H
+
+#include <dab/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief 8 bit soft bits out of a complex vector
+     * \ingroup dab
+     *
+     * Quantizing version of complex_to_interleaved_float_vcf: the first half of the output
+     * vector are the real parts of the input vector, followed by the imaginary parts. Each
+     * value is multiplied with scale, rounded and saturated to a signed 8 bit integer.
+     *
+     * @param length Length of the complex input vector.
+     * @param scale Factor applied before the quantization.
+     */
+    class DAB_API complex_to_interleaved_char_vcb : virtual public gr::sync_block
+    {
+     public:
+      typedef boost::shared_ptr<complex_to_interleaved_char_vcb> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::complex_to_interleaved_char_vcb.
+       *
+       * To avoid accidental use of raw pointers, dab::complex_to_interleaved_char_vcb's
+       * constructor is in a private implementation
+       * class. dab::complex_to_interleaved_char_vcb::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(unsigned int length, float scale);
+
+      virtual void set_scale(float scale) = 0;
+
+      virtual float scale() const = 0;
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_COMPLEX_TO_INTERLEAVED_CHAR_VCB_H */
@@ -24,6 +24,7 @@
 
 #include <dab/api.h>
 #include <gnuradio/block.h>
+#include <vector>
 
 namespace gr {
   namespace dab {
@@ -46,7 +47,21 @@ namespace gr {
        * class. dab::demux_cc::make is the public interface for
        * creating new instances.
        */
-      static sptr make(unsigned int symbol_length, unsigned int symbols_fic, unsigned int symbol_msc, gr_complex fillval = gr_complex(0,0));
+      static sptr make(unsigned int symbol_length, unsigned int symbols_fic, unsigned int symbol_msc, gr_complex fillval = gr_complex(0,0),
+                       const std::vector<unsigned char> &symbol_mask = std::vector<unsigned char>());
+
+      /*!
+       * \brief Sets the mask of the symbols which were left out by the synchronization.
+       *
+       * The missing MSC symbols are replaced with fillval, so that the MSC output
+       * keeps its frame structure. A mask in the "Start" tag of a frame (written by
+       * ofdm_synchronization_cvf) takes precedence, this mask is applied to frames
+       * whose tag carries none, starting with the next frame.
+       *
+       * \param symbol_mask One entry per symbol of the frame, starting with the phase
+       * reference symbol, empty if all symbols are passed.
+       */
+      virtual void set_symbol_mask(const std::vector<unsigned char> &symbol_mask) = 0;
     };
 
   } // namespace dab
@@ -0,0 +1,62 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_ENERGY_DISPERSAL_BB_H
+#define INCLUDED_DAB_ENERGY_DISPERSAL_BB_H
+
+#include <dab/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief applies or removes the energy dispersal of packed bytes
+     * \ingroup dab
+     *
+     * XORs the stream of packed bytes (MSB first) with the energy dispersal PRBS of
+     * ETSI EN 300 401 chapter 10 (polynomial x^9 + x^5 + 1, initial state 111111111).
+     * The PRBS restarts every length bits, counted from the first byte of the stream.
+     * Replaces the chain packed_to_unpacked_bb, xor_bb with a PRBS vector source and
+     * unpacked_to_packed_bb. The same block scrambles and descrambles.
+     *
+     * @param length Number of bits after which the PRBS restarts, a multiple of 8
+     * (e.g. 768 for a FIC codeword in mode I or the bits of a logical frame of an MSC sub-channel).
+     */
+    class DAB_API energy_dispersal_bb : virtual public gr::sync_block
+    {
+     public:
+      typedef boost::shared_ptr<energy_dispersal_bb> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::energy_dispersal_bb.
+       *
+       * To avoid accidental use of raw pointers, dab::energy_dispersal_bb's
+       * constructor is in a private implementation
+       * class. dab::energy_dispersal_bb::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(unsigned int length);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_ENERGY_DISPERSAL_BB_H */
@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_ENSEMBLE_MSC_DECODER_H
+#define INCLUDED_DAB_ENSEMBLE_MSC_DECODER_H
+
+#include <dab/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief decodes several sub-channels of the MSC at once
+     * \ingroup dab
+     *
+     * Multi sub-channel version of msc_decode_vcb for monitoring a whole ensemble.
+     * The input are the MSC symbols of the demux (beginning with the first symbol of a CIF).
+     * Each CIF is split into the configured sub-channels in one pass; time deinterleaving,
+     * Viterbi decoding and removal of the energy dispersal of the sub-channels run in
+     * parallel on an internal thread pool.
+     *
+     * The logical frame of every sub-channel and CIF is published as a PDU on the message
+     * port "subchannels". The metadata dictionary holds the keys "subch_index" (position in
+     * the parameter vectors), "address" and "size", the data are the packed bytes, bit exact
+     * with msc_decode_vcb. The PDUs of one CIF are published in the order of the parameter vectors.
+     *
+     * @param symbol_length Number of carriers per OFDM symbol.
+     * @param addresses Start addresses of the sub-channels in CUs.
+     * @param sizes Sizes of the sub-channels in CUs.
+     * @param protections EEP-A protection levels of the sub-channels (0 for 1-A to 3 for 4-A).
+     * @param num_threads Number of decoding threads, 0 for one per CPU core.
+     */
+    class DAB_API ensemble_msc_decoder : virtual public gr::block
+    {
+     public:
+      typedef boost::shared_ptr<ensemble_msc_decoder> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::ensemble_msc_decoder.
+       *
+       * To avoid accidental use of raw pointers, dab::ensemble_msc_decoder's
+       * constructor is in a private implementation
+       * class. dab::ensemble_msc_decoder::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(unsigned int symbol_length,
+                       const std::vector<unsigned int> &addresses,
+                       const std::vector<unsigned int> &sizes,
+                       const std::vector<int> &protections,
+                       unsigned int num_threads = 0);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_ENSEMBLE_MSC_DECODER_H */
@@ -29,9 +29,17 @@ namespace gr {
   namespace dab {
 
     /*!
-     * \brief <+description of block+>
+     * \brief interprets the FIBs (Fast Information Blocks) of the FIC
      * \ingroup dab
      *
+     * Checks the CRC of each FIB and keeps the multiplex configuration and the
+     * service information (ensemble, sub-channels, service components, labels and
+     * programme types) in a database. Each change of the database is published as
+     * a dictionary on the message port "ensemble", with the entry type in "type"
+     * and the database version in "version"; "complete" is true once the ensemble
+     * label and the sub-channel and label of every service are known. A change of the ensemble reference
+     * invalidates all earlier entries. The get_* methods return the current state
+     * as JSON strings, which are only built when called.
      */
     class DAB_API fib_sink_vb : virtual public gr::sync_block
     {
@@ -54,6 +62,8 @@ namespace gr {
       virtual std::string get_service_labels() = 0;
       virtual std::string get_subch_info() = 0;
       virtual std::string get_programme_type() = 0;
+      /*! Number of changes of the ensemble database, to poll the JSON strings only when needed. */
+      virtual unsigned int get_version() = 0;
       virtual bool get_crc_passed() = 0;
     };
 
@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DAB_FIC_DECODE_VB_H
+#define INCLUDED_DAB_FIC_DECODE_VB_H
+
+#include <dab/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief decodes the FIBs (Fast Information Blocks) out of the demodulated FIC symbols
+     * \ingroup dab
+     *
+     * Single block version of the channel decoding in fic_decode_vc: depuncturing,
+     * Viterbi decoding and removal of the energy dispersal of all FIC codewords of a
+     * transmission frame, followed by the CRC check of each FIB. The input are the FIC
+     * symbols of the demux (beginning with the first FIC symbol of a frame).
+     * FIBs with a correct CRC are written to the output stream (32 byte vectors)
+     * and published on the message port "fib" as PDUs.
+     *
+     * With duty_cycle > 1 the decoder goes into a low power mode once the multiplex
+     * configuration is complete and stable, i.e. the last message on the input port
+     * "ensemble" (connect the port "ensemble" of fib_sink_vb) reported a complete
+     * ensemble database, and since then no message arrived and no FIB failed the CRC
+     * check for about 10 seconds. Then only every duty_cycle-th frame is decoded, the other
+     * frames are dropped. The decoder returns to full rate immediately when FIG 0/0
+     * signals a reconfiguration, the CIF counter of FIG 0/0 jumps, several FIBs in a
+     * row fail the CRC check or a change of the ensemble database arrives.
+     *
+     * @param transmission_mode DAB transmission mode (1 to 4).
+     * @param duty_cycle Decode only every duty_cycle-th frame in the low power mode, 1 to always decode all frames.
+     */
+    class DAB_API fic_decode_vb : virtual public gr::block
+    {
+     public:
+      typedef boost::shared_ptr<fic_decode_vb> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::fic_decode_vb.
+       *
+       * To avoid accidental use of raw pointers, dab::fic_decode_vb's
+       * constructor is in a private implementation
+       * class. dab::fic_decode_vb::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int transmission_mode, int duty_cycle = 1);
+
+      /*! True if the CRC of the last decoded FIB was correct. */
+      virtual bool get_crc_passed() = 0;
+
+      /*! True if only every duty_cycle-th frame is decoded. */
+      virtual bool get_duty_cycling() = 0;
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_FIC_DECODE_VB_H */
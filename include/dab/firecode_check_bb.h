@@ -29,8 +29,24 @@ namespace gr {
   namespace dab {
 
     /*!
-     * checks firecode of logical frames
+     * \brief superframe synchronization with the fire code of DAB+ (ETSI TS 102 563 clause 5.2)
+     * \ingroup dab
      *
+     * In acquisition, the fire code is checked at each logical frame until it passes.
+     * Then the block tracks the superframes and checks only the expected position,
+     * every 5 logical frames (120 ms). Superframes with a failed fire code are passed on
+     * in tracking (the Reed-Solomon decoder may repair the header), until more than
+     * max_misses superframes in a row failed. Then the block goes back to acquisition.
+     *
+     * The first byte of each superframe at the output carries a "superframe_start" tag,
+     * its value is true if the fire code passed.
+     *
+     * A "bit_rate_n" tag at the input (see msc_decode_vcb) switches to the new data rate:
+     * the rest of the old sub-channel is dropped, the block goes back to acquisition and
+     * passes the tag on to the first byte of the new sub-channel at its output.
+     *
+     * @param bit_rate_n data rate in multiples of 8kbit/s
+     * @param max_misses number of consecutive failed fire codes that are tolerated in tracking
      */
     class DAB_API firecode_check_bb : virtual public gr::block
     {
@@ -45,9 +61,13 @@ namespace gr {
        * class. dab::firecode_check_bb::make is the public interface for
        * creating new instances.
        */
-      static sptr make(int bit_rate_n);
-      
+      static sptr make(int bit_rate_n, int max_misses = 2);
+
+      /*! True if the fire code of the last checked superframe passed. */
       virtual bool get_firecode_passed() = 0;
+
+      /*! True while the block tracks the superframes. */
+      virtual bool get_synced() = 0;
     };
 
   } // namespace dab
@@ -32,6 +32,15 @@ namespace gr {
      * \brief block that decodes DAB audio frames (= MPEG2 audio frames) to PCM frames
      * \ingroup dab
      *
+     * The outputs 0 and 1 are the left and right channel as 16 bit PCM. The optional
+     * outputs 2 and 3 are the same channels as float PCM, full scale is 1.0.
+     *
+     * By default the synthesis filterbank is computed in float with a fast DCT and SIMD
+     * windowing. The fixed-point synthesis is still available, its 16 bit output is
+     * bit-exact the same as before.
+     *
+     * The input are either unpacked bits or, with less overhead, the packed bytes of the
+     * sub-channel (e.g. the output of msc_decode).
      */
     class DAB_API mp2_decode_bs : virtual public gr::block
     {
@@ -45,8 +54,12 @@ namespace gr {
        * constructor is in a private implementation
        * class. dab::mp2_decode_bs::make is the public interface for
        * creating new instances.
+       *
+       * \param bit_rate_n data rate in multiples of 8kbit/s
+       * \param fixed_point use the fixed-point synthesis filterbank instead of the float one
+       * \param packed input are packed bytes instead of unpacked bits
        */
-      static sptr make(int bit_rate_n);
+      static sptr make(int bit_rate_n, bool fixed_point = false, bool packed = false);
       
       virtual int32_t get_sample_rate() = 0;
     };
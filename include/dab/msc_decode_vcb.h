@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DAB_MSC_DECODE_VCB_H
+#define INCLUDED_DAB_MSC_DECODE_VCB_H
+
+#include <dab/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief decodes one sub-channel out of the demodulated MSC symbols
+     * \ingroup dab
+     *
+     * Single block version of the hier block msc_decode: selects the CUs of the
+     * sub-channel, does time deinterleaving, depuncturing, Viterbi decoding and removes
+     * the energy dispersal. The input are the MSC symbols of the demux (beginning with
+     * the first symbol of a CIF), the output are the packed bytes of the sub-channel,
+     * bit exact with msc_decode.
+     *
+     * The block can be retuned to another sub-channel at runtime with a message on the
+     * input port "config": a dict with "address", "size" and "protection" (and optionally
+     * "bit_rate_n" as a check). The new configuration takes effect at the next CIF, or at
+     * the CIF with the index "cif" (counted from the start of the stream) if given. The
+     * first byte of its logical frames carries a "bit_rate_n" tag with the new data rate
+     * in multiples of 8 kbit/s, which firecode_check_bb, reed_solomon_decode_bb,
+     * mp4_decode_bs and mp2_decode_bs (packed input) follow. The time deinterleaver of
+     * the new sub-channel starts empty, unless warm_history is set: then the soft bits of
+     * the whole MSC of the last 15 CIFs are kept as 8 bit (810 kB) and the new sub-channel
+     * is deinterleaved from its first CIF on. This needs all MSC symbols, i.e. no symbol
+     * mask in the OFDM demodulator.
+     *
+     * @param symbol_length Number of carriers per OFDM symbol.
+     * @param address Start address of the sub-channel in CUs.
+     * @param size Size of the sub-channel in CUs.
+     * @param protection EEP-A protection level (0 for 1-A to 3 for 4-A).
+     * @param warm_history Keep the last CIFs of the whole MSC for instant retuning.
+     */
+    class DAB_API msc_decode_vcb : virtual public gr::block
+    {
+     public:
+      typedef boost::shared_ptr<msc_decode_vcb> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::msc_decode_vcb.
+       *
+       * To avoid accidental use of raw pointers, dab::msc_decode_vcb's
+       * constructor is in a private implementation
+       * class. dab::msc_decode_vcb::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(unsigned int symbol_length, unsigned int address, unsigned int size, int protection,
+                       bool warm_history = false);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_MSC_DECODE_VCB_H */
@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DAB_OFDM_DEMOD_CORE_VCVC_H
+#define INCLUDED_DAB_OFDM_DEMOD_CORE_VCVC_H
+
+#include <dab/api.h>
+#include <gnuradio/sync_block.h>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief demodulation of the synchronized OFDM symbols in one block
+     * \ingroup dab
+     *
+     * Does the work of fft_vcc, multiply_const_vcc, ofdm_coarse_frequency_correction_vcvc,
+     * diff_phasor_vcc and frequency_interleaver_vcc in ofdm_demod_cc in one pass per symbol:
+     * FFT of the symbol, differential demodulation of the occupied carriers against the
+     * previous symbol and frequency deinterleaving. The coarse frequency offset is measured
+     * at each symbol with a "Start" tag (phase reference symbol) and applied to the whole frame.
+     * The output is scaled like the one of the single blocks (1/sqrt(2048) per FFT).
+     *
+     * @param fft_length Length of the FFT (number of samples per symbol without cyclic prefix).
+     * @param num_carriers Number of occupied sub-carriers.
+     * @param deinterleaving_sequence Frequency deinterleaving sequence, carrier k of the
+     * symbol is written to position deinterleaving_sequence[k] of the output.
+     */
+    class DAB_API ofdm_demod_core_vcvc : virtual public gr::sync_block
+    {
+     public:
+      typedef boost::shared_ptr<ofdm_demod_core_vcvc> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::ofdm_demod_core_vcvc.
+       *
+       * To avoid accidental use of raw pointers, dab::ofdm_demod_core_vcvc's
+       * constructor is in a private implementation
+       * class. dab::ofdm_demod_core_vcvc::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int fft_length, int num_carriers,
+                       const std::vector<short> &deinterleaving_sequence);
+
+      /*! SNR in dB, measured at the last phase reference symbol. */
+      virtual float get_snr() = 0;
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_OFDM_DEMOD_CORE_VCVC_H */
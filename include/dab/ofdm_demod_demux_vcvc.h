@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_OFDM_DEMOD_DEMUX_VCVC_H
+#define INCLUDED_DAB_OFDM_DEMOD_DEMUX_VCVC_H
+
+#include <dab/api.h>
+#include <gnuradio/block.h>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief demodulation of the synchronized OFDM symbols, separated into FIC and MSC
+     * \ingroup dab
+     *
+     * Combines ofdm_demod_core_vcvc and demux_cc: each symbol is demodulated
+     * (FFT, differential demodulation, frequency deinterleaving) directly into the
+     * FIC or the MSC output, without an intermediate stream of all symbols.
+     * The phase reference symbol of a frame (marked with a "Start" tag) is used for
+     * the coarse frequency correction and the differential demodulation, but not written out.
+     * The frame handling is the one of demux_cc: incomplete frames are filled with zeros and
+     * MSC symbols left out by the symbol mask are filled with zeros.
+     *
+     * @param fft_length Length of the FFT (number of samples per symbol without cyclic prefix).
+     * @param num_carriers Number of occupied sub-carriers.
+     * @param deinterleaving_sequence Frequency deinterleaving sequence.
+     * @param symbols_fic Number of FIC symbols per transmission frame.
+     * @param symbols_msc Number of MSC symbols per transmission frame.
+     * @param symbol_mask Symbols of the frame which are passed by the synchronization,
+     * starting with the phase reference symbol, empty for all symbols.
+     */
+    class DAB_API ofdm_demod_demux_vcvc : virtual public gr::block
+    {
+     public:
+      typedef boost::shared_ptr<ofdm_demod_demux_vcvc> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::ofdm_demod_demux_vcvc.
+       *
+       * To avoid accidental use of raw pointers, dab::ofdm_demod_demux_vcvc's
+       * constructor is in a private implementation
+       * class. dab::ofdm_demod_demux_vcvc::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int fft_length, int num_carriers,
+                       const std::vector<short> &deinterleaving_sequence,
+                       unsigned int symbols_fic, unsigned int symbols_msc,
+                       const std::vector<unsigned char> &symbol_mask = std::vector<unsigned char>());
+
+      /*!
+       * \brief Sets the mask of the symbols which were left out by the synchronization.
+       *
+       * A mask in the "Start" tag of a frame takes precedence, see demux_cc::set_symbol_mask.
+       */
+      virtual void set_symbol_mask(const std::vector<unsigned char> &symbol_mask) = 0;
+
+      /*! SNR in dB, measured at the last phase reference symbol. */
+      virtual float get_snr() = 0;
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_OFDM_DEMOD_DEMUX_VCVC_H */
@@ -29,6 +29,7 @@
 
 #include <dab/api.h>
 #include <gnuradio/block.h>
+#include <vector>
 
 namespace gr {
   namespace dab {
@@ -51,7 +52,22 @@ namespace gr {
        * class. dab::ofdm_synchronization_cvf::make is the public interface for
        * creating new instances.
        */
-      static sptr make(int symbol_length, int cyclic_prefix_lenght, int fft_length, int symbols_per_frame);
+      static sptr make(int symbol_length, int cyclic_prefix_lenght, int fft_length, int symbols_per_frame,
+                       const std::vector<unsigned char> &symbol_mask = std::vector<unsigned char>());
+
+      /*!
+       * \brief Selects the OFDM symbols of each frame which are passed to the output.
+       *
+       * Symbols with a 0 in the mask are only tracked, they are not written to
+       * the output. The first symbol (phase reference symbol) carries the frame
+       * start tag and is always passed. The new mask is applied with the start
+       * of the next frame. The "Start" tag of each frame carries the mask it was
+       * written with, demux_cc and ofdm_demod_demux_vcvc apply it from there.
+       *
+       * \param symbol_mask One entry per symbol of the frame (without the NULL symbol),
+       * empty to pass all symbols.
+       */
+      virtual void set_symbol_mask(const std::vector<unsigned char> &symbol_mask) = 0;
     };
 
   } // namespace dab
@@ -0,0 +1,64 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_SELECT_SUBCHANNELS_VFVF_H
+#define INCLUDED_DAB_SELECT_SUBCHANNELS_VFVF_H
+
+#include <dab/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief selects the CUs (capacity units) of several sub-channels of a vector stream
+     * \ingroup dab
+     *
+     * Multi sub-channel version of select_cus_vfvf: the CUs of sub-channel i
+     * are written to output port i. Each frame is read once, whatever the number
+     * of sub-channels.
+     *
+     * @param vlen Vector size of input and output vectors (e.g. 64 soft bits of a CU).
+     * @param frame_len Length in items of a frame (e.g. 864 CUs of a CIF).
+     * @param addresses Number of the first item in each frame of each sub-channel.
+     * @param sizes Number of items in each frame of each sub-channel.
+     */
+    class DAB_API select_subchannels_vfvf : virtual public gr::block
+    {
+     public:
+      typedef boost::shared_ptr<select_subchannels_vfvf> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::select_subchannels_vfvf.
+       *
+       * To avoid accidental use of raw pointers, dab::select_subchannels_vfvf's
+       * constructor is in a private implementation
+       * class. dab::select_subchannels_vfvf::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(unsigned int vlen, unsigned int frame_len,
+                       const std::vector<unsigned int> &addresses,
+                       const std::vector<unsigned int> &sizes);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_SELECT_SUBCHANNELS_VFVF_H */
@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DAB_UNPUNCTURE_VBB_H
+#define INCLUDED_DAB_UNPUNCTURE_VBB_H
+
+#include <dab/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief unpuncturing of a vector of 8 bit soft bits
+     * \ingroup dab
+     *
+     * Version of unpuncture_vff for the 8 bit soft decision path: writes an input
+     * element at each 1 of the puncturing vector and fillval at each 0.
+     *
+     * @param puncturing_vector Puncturing sequence, its length is the output vector length.
+     * @param fillval Value for the erased elements.
+     */
+    class DAB_API unpuncture_vbb : virtual public gr::sync_block
+    {
+     public:
+      typedef boost::shared_ptr<unpuncture_vbb> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::unpuncture_vbb.
+       *
+       * To avoid accidental use of raw pointers, dab::unpuncture_vbb's
+       * constructor is in a private implementation
+       * class. dab::unpuncture_vbb::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(const std::vector<unsigned char> &puncturing_vector, int fillval=0);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_UNPUNCTURE_VBB_H */
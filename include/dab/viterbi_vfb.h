@@ -0,0 +1,67 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DAB_VITERBI_VFB_H
+#define INCLUDED_DAB_VITERBI_VFB_H
+
+#include <dab/api.h>
+#include <gnuradio/sync_interpolator.h>
+
+namespace gr {
+  namespace dab {
+
+    /*!
+     * \brief Viterbi decoder for the DAB convolutional mother code (rate 1/4, K=7)
+     * \ingroup dab
+     *
+     * Decodes codewords of 4*length+24 unpunctured soft bits (positive values for a logical 0,
+     * zero for an erasure) to length unpacked information bits. The 6 tail bits are removed.
+     * Replaces trellis.viterbi_combined_fb with the DAB generator polynomials followed by dab.prune.
+     *
+     * If a puncturing vector is given, the input vectors are punctured codewords
+     * (one soft bit per 1 in the puncturing vector) and the erased bits are skipped
+     * by the decoder. This replaces dab.unpuncture_vff in front of the decoder.
+     *
+     * @param length Number of information bits per codeword (I in ETSI EN 300 401 chapter 11).
+     * @param puncturing_vector Assembled puncturing sequence of the codeword (4*length+24 elements)
+     * or empty for unpunctured input.
+     */
+    class DAB_API viterbi_vfb : virtual public gr::sync_interpolator
+    {
+     public:
+      typedef boost::shared_ptr<viterbi_vfb> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of dab::viterbi_vfb.
+       *
+       * To avoid accidental use of raw pointers, dab::viterbi_vfb's
+       * constructor is in a private implementation
+       * class. dab::viterbi_vfb::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int length,
+                       const std::vector<unsigned char> &puncturing_vector = std::vector<unsigned char>());
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_VITERBI_VFB_H */
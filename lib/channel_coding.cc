@@ -0,0 +1,113 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "channel_coding.h"
+#include <boost/format.hpp>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace gr {
+  namespace dab {
+
+    namespace {
+      // puncturing vectors PI=1..24 (table 29), MSB first
+      const uint32_t PUNCTURING_VECTORS[25] = {
+              0x00000000,
+              0xc8888888, 0xc888c888, 0xc8c8c888, 0xc8c8c8c8, 0xccc8c8c8, 0xccc8ccc8,
+              0xccccccc8, 0xcccccccc, 0xeccccccc, 0xeccceccc, 0xecececcc, 0xecececec,
+              0xeeececec, 0xeeeceeec, 0xeeeeeeec, 0xeeeeeeee, 0xfeeeeeee, 0xfeeefeee,
+              0xfefefeee, 0xfefefefe, 0xfffefefe, 0xfffefffe, 0xfffffffe, 0xffffffff
+      };
+      // puncturing of the 24 tail bits (V_T)
+      const unsigned char TAIL_PUNCTURING[24] = {1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0,
+                                                 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0};
+      // sub-channel size of n = 1 in CUs for protection levels 1-A to 4-A (table 7)
+      const unsigned int SUBCH_SIZE_MULTIPLE[4] = {12, 8, 6, 4};
+      // PI of the first and second part of the codeword for 1-A to 4-A (table 33)
+      const int PI1[4] = {24, 14, 8, 3};
+      const int PI2[4] = {23, 13, 7, 2};
+
+      void
+      append_blocks(std::vector<unsigned char> &seq, int num_blocks, int pi) {
+        // each block of 128 bits uses the puncturing vector 4 times
+        for (int b = 0; b < 4 * num_blocks; b++) {
+          for (int i = 31; i >= 0; i--) {
+            seq.push_back((PUNCTURING_VECTORS[pi] >> i) & 1);
+          }
+        }
+      }
+
+      std::vector<unsigned char>
+      assemble(int L1, int pi1, int L2, int pi2) {
+        std::vector<unsigned char> seq;
+        seq.reserve((L1 + L2) * 128 + 24);
+        append_blocks(seq, L1, pi1);
+        append_blocks(seq, L2, pi2);
+        seq.insert(seq.end(), TAIL_PUNCTURING, TAIL_PUNCTURING + 24);
+        return seq;
+      }
+    }
+
+    std::vector<unsigned char>
+    fic_puncturing_vector(int transmission_mode) {
+      switch (transmission_mode) {
+        case 1:
+        case 2:
+        case 4:
+          return assemble(21, 16, 3, 15);
+        case 3:
+          return assemble(29, 16, 3, 15);
+        default:
+          throw std::invalid_argument((boost::format("Transmission mode %d doesn't exist")
+                                       % transmission_mode).str());
+      }
+    }
+
+    std::vector<unsigned char>
+    eep_puncturing_vector(unsigned int size, int protection) {
+      if (protection < 0 || protection > 3)
+        throw std::invalid_argument((boost::format("EEP protection level %d doesn't exist") % protection).str());
+      if (size == 0 || size % SUBCH_SIZE_MULTIPLE[protection] != 0)
+        throw std::invalid_argument((boost::format("sub-channel size %d is no multiple of %d CUs")
+                                     % size % SUBCH_SIZE_MULTIPLE[protection]).str());
+      int n = size / SUBCH_SIZE_MULTIPLE[protection];
+      if (protection == 1 && n == 1) {
+        // exception of table 33 for 2-A with n = 1
+        return assemble(5, 13, 1, 12);
+      }
+      const int L1[4] = {6 * n - 3, 2 * n - 3, 6 * n - 3, 4 * n - 3};
+      const int L2[4] = {3, 4 * n + 3, 3, 2 * n + 3};
+      return assemble(L1[protection], PI1[protection], L2[protection], PI2[protection]);
+    }
+
+    std::vector<unsigned char>
+    energy_dispersal_prbs(unsigned int length) {
+      std::vector<unsigned char> prbs(length / 8, 0);
+      unsigned int reg = 0x1ff;
+      for (unsigned int i = 0; i < length; i++) {
+        unsigned int bit = ((reg >> 8) ^ (reg >> 4)) & 1;
+        reg = ((reg << 1) | bit) & 0x1ff;
+        prbs[i / 8] |= bit << (7 - i % 8);
+      }
+      return prbs;
+    }
+
+  }
+}
@@ -0,0 +1,62 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_CHANNEL_CODING_H
+#define INCLUDED_DAB_CHANNEL_CODING_H
+
+#include <vector>
+
+/*
+ * Constant sequences of the DAB channel coding
+ * that are shared between the FIC and MSC decoders.
+ */
+
+namespace gr {
+  namespace dab {
+
+    /*! \brief Assembled puncturing sequence of the FIC (ETSI EN 300 401 chapter 11.2).
+     *
+     * @param transmission_mode DAB transmission mode (1 to 4).
+     * @return 4*I+24 elements, I = 768 in mode I, II and IV and I = 1024 in mode III.
+     */
+    std::vector<unsigned char> fic_puncturing_vector(int transmission_mode);
+
+    /*! \brief Assembled puncturing sequence of an EEP-A sub-channel (ETSI EN 300 401 chapter 11.3.2).
+     *
+     * Throws std::invalid_argument if size is no multiple of the
+     * sub-channel size unit of this protection level.
+     *
+     * @param size Size of the sub-channel in CUs.
+     * @param protection EEP-A protection level (0 for 1-A to 3 for 4-A).
+     */
+    std::vector<unsigned char> eep_puncturing_vector(unsigned int size, int protection);
+
+    /*! \brief PRBS of the energy dispersal (ETSI EN 300 401 chapter 10), packed MSB first.
+     *
+     * Generated with the polynomial p(x) = x^9 + x^5 + 1 and initial state 111111111.
+     *
+     * @param length Number of bits in the sequence, a multiple of 8.
+     */
+    std::vector<unsigned char> energy_dispersal_prbs(unsigned int length);
+
+  }
+}
+
+#endif /* INCLUDED_DAB_CHANNEL_CODING_H */
@@ -0,0 +1,59 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_COMPLEX_TO_INTERLEAVED_CHAR_VCB_IMPL_H
+#define INCLUDED_DAB_COMPLEX_TO_INTERLEAVED_CHAR_VCB_IMPL_H
+
+#include <dab/complex_to_interleaved_char_vcb.h>
+
+namespace gr {
+  namespace dab {
+/*! \brief transforms a complex vector into a vector of 8 bit soft bits
+ *  The first half of the output vector includes the quantized real parts of the
+ *  complex input vector, followed by the quantized imaginary parts.
+ *
+ *  @param length length of the complex input vector
+ *  @param scale factor applied before the quantization
+ */
+    class complex_to_interleaved_char_vcb_impl : public complex_to_interleaved_char_vcb {
+    private:
+      unsigned int d_length; /*!< length of the complex input vector */
+      float d_scale; /*!< factor applied before the quantization */
+      float *d_real; /*!< real parts of the current input vector */
+      float *d_imag; /*!< imaginary parts of the current input vector */
+
+    public:
+      complex_to_interleaved_char_vcb_impl(unsigned int length, float scale);
+
+      ~complex_to_interleaved_char_vcb_impl();
+
+      void set_scale(float scale) { d_scale = scale; }
+
+      float scale() const { return d_scale; }
+
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_COMPLEX_TO_INTERLEAVED_CHAR_VCB_IMPL_H */
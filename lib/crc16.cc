@@ -1,21 +1,148 @@
-#include <inttypes.h>
-#include <stdio.h>
-#include <iostream>
-
-uint16_t crc16(const char *bytestream, int length, uint16_t generator, uint16_t initial_state) {
-  uint16_t state;
-  char byte;
-  
-  state = bytestream[0]*256+bytestream[1];
-  state = ~state;
-  for (int i=2; i<length; i++) {
-    byte = bytestream[i];
-    for (int j=7; j>=0; j--) {
-      if (((state>>15)&1) == 1)
-        state = (((state<<1) + ((byte>>j)&1)) ^ generator);
-      else
-        state = (state<<1) + ((byte>>j)&1);
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "crc16.h"
+
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__SSE2__)
+#define DAB_CRC_X86
+#include <immintrin.h>
+#endif
+
+namespace gr {
+  namespace dab {
+
+    namespace {
+      const int NUM_TABLES = 8;
+      const int MIN_CLMUL_LENGTH = 32;
+
+      /*! x^k mod (x^16 + generator) */
+      uint64_t
+      x_pow_mod(int k, uint16_t generator) {
+        uint32_t r = 1;
+        for (int i = 0; i < k; i++) {
+          r <<= 1;
+          if (r & 0x10000)
+            r ^= 0x10000 | generator;
+        }
+        return r;
+      }
+    }
+
+    crc16::crc16(uint16_t generator, uint16_t initial_state, uint16_t final_xor)
+            : d_initial_state(initial_state),
+              d_final_xor(final_xor),
+              d_table(NUM_TABLES * 256),
+              d_clmul(false) {
+      for (int b = 0; b < 256; b++) {
+        uint16_t v = (uint16_t) (b << 8);
+        for (int j = 0; j < 8; j++)
+          v = (uint16_t) ((v & 0x8000) ? (v << 1) ^ generator : v << 1);
+        d_table[b] = v;
+      }
+      for (int k = 1; k < NUM_TABLES; k++) {
+        for (int b = 0; b < 256; b++) {
+          uint16_t v = d_table[(k - 1) * 256 + b];
+          d_table[k * 256 + b] = (uint16_t) ((v << 8) ^ d_table[v >> 8]);
+        }
+      }
+      d_fold[0] = x_pow_mod(192, generator);
+      d_fold[1] = x_pow_mod(128, generator);
+      d_fold[2] = x_pow_mod(80, generator);
+      d_fold[3] = x_pow_mod(64, generator);
+#ifdef DAB_CRC_X86
+      d_clmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+#endif
+    }
+
+    crc16::~crc16() {
+    }
+
+    uint16_t
+    crc16::update_table(uint16_t state, const uint8_t *data, int length) const {
+      const uint16_t *t = &d_table[0];
+      for (; length >= 8; length -= 8, data += 8) {
+        state = t[7 * 256 + (data[0] ^ (state >> 8))] ^ t[6 * 256 + (data[1] ^ (state & 0xff))] ^
+                t[5 * 256 + data[2]] ^ t[4 * 256 + data[3]] ^
+                t[3 * 256 + data[4]] ^ t[2 * 256 + data[5]] ^
+                t[1 * 256 + data[6]] ^ t[data[7]];
+      }
+      for (; length > 0; length--, data++)
+        state = (uint16_t) ((state << 8) ^ t[(state >> 8) ^ *data]);
+      return state;
+    }
+
+#ifdef DAB_CRC_X86
+    __attribute__((target("pclmul,ssse3"))) uint16_t
+    crc16::update_clmul(uint16_t state, const uint8_t *data, int length) const {
+      // the 16 byte blocks are byte reversed, so that the first bit of the block is bit 127
+      const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+      const __m128i fold128 = _mm_set_epi64x((long long) d_fold[1], (long long) d_fold[0]);
+      const __m128i fold64 = _mm_set_epi64x((long long) d_fold[3], (long long) d_fold[2]);
+
+      // the shift register state is added to the first 16 bits of the message
+      __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) data), reverse);
+      a = _mm_xor_si128(a, _mm_slli_si128(_mm_cvtsi32_si128(state), 14));
+      int pos = 16;
+      for (; pos + 16 <= length; pos += 16) {
+        // a * x^128 + b with the upper and lower half of a reduced by x^192 and x^128 mod generator
+        __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + pos)), reverse);
+        a = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(a, fold128, 0x01),
+                                        _mm_clmulepi64_si128(a, fold128, 0x10)), b);
+      }
+
+      // the state is a * x^16 mod generator: reduce a to 80 bits, then to 64 bits
+      __m128i t = _mm_xor_si128(_mm_clmulepi64_si128(a, fold64, 0x01),
+                                _mm_slli_si128(_mm_move_epi64(a), 2));
+      t = _mm_xor_si128(_mm_clmulepi64_si128(t, fold64, 0x11), _mm_move_epi64(t));
+      uint64_t v = (uint64_t) _mm_cvtsi128_si64(t);
+      // v mod generator is the state after the upper 48 bits of v, XOR the lower 16 bits
+      uint16_t s = 0;
+      for (int shift = 56; shift >= 16; shift -= 8)
+        s = (uint16_t) ((s << 8) ^ d_table[(s >> 8) ^ ((v >> shift) & 0xff)]);
+      s ^= (uint16_t) v;
+
+      return update_table(s, data + pos, length - pos);
+    }
+#else
+    uint16_t
+    crc16::update_clmul(uint16_t state, const uint8_t *data, int length) const {
+      return update_table(state, data, length);
+    }
+#endif
+
+    uint16_t
+    crc16::compute(const uint8_t *data, int length) const {
+      if (d_clmul && length >= MIN_CLMUL_LENGTH)
+        return update_clmul(d_initial_state, data, length) ^ d_final_xor;
+      return update_table(d_initial_state, data, length) ^ d_final_xor;
+    }
+
+    uint16_t
+    crc16::compute_table(const uint8_t *data, int length) const {
+      return update_table(d_initial_state, data, length) ^ d_final_xor;
     }
+
+    bool
+    crc16::check(const uint8_t *data, int length) const {
+      return compute(data, length) == ((data[length] << 8) | data[length + 1]);
+    }
+
   }
-  return ~state;
 }
@@ -1,6 +1,81 @@
-#ifndef _CRC16_H
-#define _CRC16_H 
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
 
-uint16_t crc16(const char *bitstream, int length, uint16_t generator, uint16_t initial_state);
+#ifndef INCLUDED_DAB_CRC16_H
+#define INCLUDED_DAB_CRC16_H
 
-#endif /* _CRC16_H */
+#include <stdint.h>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief CRC16 engine, MSB first.
+ *
+ * Computes the 16 bit CRC of a byte sequence with the bits of each byte taken MSB first,
+ * as used for the FIBs (ETSI EN 300 401 chapter 5.2.1) and the DAB+ access units
+ * (ETSI TS 102 563 chapter 5.2). The defaults are the DAB CRC with the
+ * generator x^16+x^12+x^5+1, the register preset to ones and the CRC sent inverted.
+ *
+ * The CRC is computed with 8 tables of 256 entries, 8 bytes per step (slicing-by-8).
+ * Messages of at least 32 bytes are folded with carry-less multiplications in 16 byte
+ * blocks if the CPU supports PCLMULQDQ. Both paths give identical results.
+ *
+ * @param generator Generator polynomial without the x^16 term.
+ * @param initial_state Initial state of the shift register.
+ * @param final_xor Value the shift register is XORed with to get the CRC.
+ */
+    class crc16 {
+    public:
+      crc16(uint16_t generator = 0x1021, uint16_t initial_state = 0xffff, uint16_t final_xor = 0xffff);
+
+      ~crc16();
+
+      /*! CRC of length bytes. */
+      uint16_t compute(const uint8_t *data, int length) const;
+
+      /*! \brief Checks a CRC protected message.
+       *
+       * @param data length bytes, followed by the 2 CRC bytes (MSB first).
+       * @param length Length of the message without the CRC.
+       * @return true if the CRC is correct.
+       */
+      bool check(const uint8_t *data, int length) const;
+
+      /*! CRC computed with the tables only, for comparison with compute(). */
+      uint16_t compute_table(const uint8_t *data, int length) const;
+
+    private:
+      uint16_t update_table(uint16_t state, const uint8_t *data, int length) const;
+
+      uint16_t update_clmul(uint16_t state, const uint8_t *data, int length) const;
+
+      uint16_t d_initial_state;
+      uint16_t d_final_xor;
+      std::vector<uint16_t> d_table;
+      /*!< 8 tables: entry b of table k is b * x^(16+8k) mod generator. */
+      uint64_t d_fold[4];
+      /*!< x^192, x^128, x^80 and x^64 mod generator for the carry-less folding. */
+      bool d_clmul;
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_CRC16_H */
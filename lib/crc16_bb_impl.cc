@@ -25,6 +25,7 @@
 #include <gnuradio/io_signature.h>
 #include "crc16_bb_impl.h"
 #include "crc16.h"
+#include <string.h>
 
 namespace gr {
   namespace dab {
@@ -42,8 +43,8 @@ namespace gr {
                         gr::io_signature::make(1, 1, length * sizeof(char)),
                         /*Output item: FIB with CRC16.*/
                         gr::io_signature::make(1, 1, length * sizeof(char))),
-              d_length(length), d_generator(generator),
-              d_initial_state(initial_state) {
+              d_length(length),
+              d_crc16(generator, initial_state) {
     }
 
     crc16_bb_impl::~crc16_bb_impl() {
@@ -64,11 +65,9 @@ namespace gr {
 
       for (int n = 0; n < noutput_items; n++) {
         //push bytes through
-        for (int i = 0; i < d_length; i++) {
-          out[i + n * d_length] = in[i + n * d_length];
-        }
-        //calculate crc16 word
-        d_crc = crc16(in + n * d_length, d_length, d_generator, d_initial_state);
+        memcpy(out + n * d_length, in + n * d_length, d_length);
+        //calculate crc16 word over all bytes but the last 2
+        d_crc = d_crc16.compute((const uint8_t *) in + n * d_length, d_length - 2);
 
         //sanity check (last 2 bytes should be zeros)
         if (in[30 + n * d_length] != 0 || in[31 + n * d_length] != 0) {
@@ -79,7 +78,7 @@ namespace gr {
         // Add MSByte first to FIB.
         out[d_length - 2 + n * d_length] = (char) (d_crc >> 8);
         // Add LSByte second to FIB.
-        out[d_length - 1 + n * d_length] = (char) (out[d_length - 2 + n * d_length] << 8) ^ d_crc;
+        out[d_length - 1 + n * d_length] = (char) (d_crc & 0xff);
       }
       // Tell runtime system how many input items we consumed on
       // each input stream.
@@ -0,0 +1,87 @@
+/* Speed test of the CRC16 engine
+ *
+ * Computes the DAB CRC of FIBs (30 bytes) and of DAB+ access units (up to 960 bytes)
+ * with crc16::compute (carry-less multiplication if the CPU supports it), with the
+ * slicing-by-8 tables and with the former bit by bit loop, and reports MB per second.
+ * The results of all three are compared, also for all lengths up to 1024 bytes.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <vector>
+#include "crc16.h"
+
+using gr::dab::crc16;
+
+static double cpu_time(){
+  struct rusage r;
+  getrusage(RUSAGE_SELF,&r);
+  return r.ru_utime.tv_sec + 1e-6*r.ru_utime.tv_usec;
+}
+
+/* the bit by bit CRC of the former mp4_decode_bs */
+static uint16_t crc_reference(const uint8_t *msg,int len){
+  uint16_t accumulator = 0xFFFF;
+  for(int i=0;i<len;i++){
+    uint16_t data = msg[i] << 8;
+    for(int j=8;j>0;j--){
+      if((data ^ accumulator) & 0x8000)
+        accumulator = ((accumulator << 1) ^ 0x1021) & 0xFFFF;
+      else
+        accumulator = (accumulator << 1) & 0xFFFF;
+      data = (data << 1) & 0xFFFF;
+    }
+  }
+  return ~accumulator & 0xFFFF;
+}
+
+int main(int argc,char *argv[]){
+  int trials = argc > 1 ? atoi(argv[1]) : 200000;
+  const int lengths[] = {30,120,480,960};
+  const crc16 crc;
+  std::vector<uint8_t> data(1024*64);
+  int failures = 0;
+
+  srandom(1);
+  for(size_t i=0;i<data.size();i++)
+    data[i] = random() & 0xff;
+
+  for(int len=0;len<=1024;len++){
+    const uint8_t *msg = &data[random() % (data.size() - 1024)];
+    uint16_t ref = crc_reference(msg,len);
+    if(crc.compute(msg,len) != ref || crc.compute_table(msg,len) != ref){
+      printf("length %d: CRC differs\n",len);
+      failures++;
+    }
+  }
+
+  for(int l=0;l<4;l++){
+    int len = lengths[l];
+    int num = data.size() / len;
+    int n = len < 100 ? trials : trials / 10;
+    unsigned int sum[2] = {0,0};
+    volatile uint16_t sink = 0;
+    double time[3];
+
+    double start = cpu_time();
+    for(int t=0;t<n;t++)
+      sum[0] += crc.compute(&data[(t % num) * len],len);
+    time[0] = cpu_time() - start;
+    start = cpu_time();
+    for(int t=0;t<n;t++)
+      sum[1] += crc.compute_table(&data[(t % num) * len],len);
+    time[1] = cpu_time() - start;
+    start = cpu_time();
+    for(int t=0;t<n/10;t++)
+      sink = crc_reference(&data[(t % num) * len],len);
+    time[2] = (cpu_time() - start) * 10;
+
+    (void) sink;
+    if(sum[0] != sum[1])
+      failures++;
+    printf("%4d bytes: %8.1f MB/s (tables: %8.1f MB/s, bit by bit: %6.1f MB/s)\n",len,
+           1e-6*n*len/time[0],1e-6*n*len/time[1],1e-6*n*len/time[2]);
+  }
+  exit(failures ? 1 : 0);
+}
@@ -0,0 +1,63 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "cu_selector.h"
+#include <algorithm>
+#include <string.h>
+
+namespace gr {
+  namespace dab {
+
+    cu_selector::cu_selector(unsigned int item_size, unsigned int frame_len,
+                             unsigned int address, unsigned int size)
+            : d_item_size(item_size),
+              d_frame_len(frame_len),
+              d_address(address),
+              d_size(size),
+              d_frame_pos(0) {
+    }
+
+    cu_selector::~cu_selector() {
+    }
+
+    unsigned int
+    cu_selector::select(const char *in, char *out, unsigned int num_items) {
+      unsigned int nwritten = 0;
+      unsigned int consumed = 0;
+
+      while (consumed < num_items) {
+        // rest of the current frame within this call
+        const unsigned int num = std::min(d_frame_len - d_frame_pos, num_items - consumed);
+        const unsigned int begin = std::max(d_frame_pos, d_address);
+        const unsigned int end = std::min(d_frame_pos + num, d_address + d_size);
+        if (begin < end) {
+          //these cus are part of the selected subchannel -> copy them to ouput buffer
+          memcpy(&out[nwritten * d_item_size], &in[(consumed + begin - d_frame_pos) * d_item_size],
+                 (end - begin) * d_item_size);
+          nwritten += end - begin;
+        }
+        consumed += num;
+        d_frame_pos = (d_frame_pos + num) % d_frame_len;
+      }
+      return nwritten;
+    }
+
+  }
+}
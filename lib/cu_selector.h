@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_CU_SELECTOR_H
+#define INCLUDED_DAB_CU_SELECTOR_H
+
+namespace gr {
+  namespace dab {
+/*! \brief Copies the items [address, address+size) of each frame out of a stream.
+ *
+ * Shared by select_cus_vfvf and select_cus_vbvb, which select the CUs of one MSC
+ * sub-channel out of a transmission frame. Works on items of item_size bytes,
+ * the position in the frame is kept between the calls.
+ *
+ * @param item_size Size of an item in bytes.
+ * @param frame_len Length in items of a frame.
+ * @param address Number of the first item in each frame to be copied.
+ * @param size Number of items to copy in each frame.
+ */
+    class cu_selector {
+    public:
+      cu_selector(unsigned int item_size, unsigned int frame_len,
+                  unsigned int address, unsigned int size);
+
+      ~cu_selector();
+
+      /*! \brief Copies the selected items of num input items to out.
+       * @return Number of items written to out.
+       */
+      unsigned int select(const char *in, char *out, unsigned int num);
+
+    private:
+      unsigned int d_item_size;
+      unsigned int d_frame_len;
+      unsigned int d_address;
+      unsigned int d_size;
+      unsigned int d_frame_pos; // position of the next input item in its frame
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_CU_SELECTOR_H */
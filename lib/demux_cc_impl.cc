@@ -24,9 +24,12 @@
 
 #include <gnuradio/io_signature.h>
 #include "demux_cc_impl.h"
+#include "frame_start_tag.h"
 #include <stdio.h>
 #include <sstream>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
 
 using namespace boost;
 
@@ -35,9 +38,10 @@ namespace gr {
 
     demux_cc::sptr
     demux_cc::make(unsigned int symbol_length, unsigned int symbols_fic,
-                   unsigned int symbol_msc, gr_complex fillval) {
+                   unsigned int symbol_msc, gr_complex fillval,
+                   const std::vector<unsigned char> &symbol_mask) {
       return gnuradio::get_initial_sptr(new demux_cc_impl(symbol_length, symbols_fic,
-                                                          symbol_msc, fillval));
+                                                          symbol_msc, fillval, symbol_mask));
     }
 
     /*
@@ -45,17 +49,21 @@ namespace gr {
      */
     demux_cc_impl::demux_cc_impl(unsigned int symbol_length,
                                  unsigned int symbols_fic,
-                                 unsigned int symbol_msc, gr_complex fillval)
+                                 unsigned int symbol_msc, gr_complex fillval,
+                                 const std::vector<unsigned char> &symbol_mask)
             : gr::block("demux_cc",
                         gr::io_signature::make(1, 1, sizeof(gr_complex) * symbol_length),
                         gr::io_signature::make(2, 2, sizeof(gr_complex) * symbol_length)),
               d_symbol_lenght(symbol_length),
               d_symbols_fic(symbols_fic),
               d_symbols_msc(symbol_msc),
-              d_fillval(fillval) {
+              d_fillval(fillval),
+              d_start_key(pmt::intern("Start")) {
       set_tag_propagation_policy(TPP_DONT);
       d_fic_counter = 0;
       d_msc_counter = 0;
+      set_symbol_mask(symbol_mask);
+      d_symbol_mask = d_next_symbol_mask;
     }
 
     /*
@@ -64,6 +72,29 @@ namespace gr {
     demux_cc_impl::~demux_cc_impl() {
     }
 
+    void
+    demux_cc_impl::set_symbol_mask(const std::vector<unsigned char> &symbol_mask) {
+      if (!symbol_mask.empty() && symbol_mask.size() != 1 + d_symbols_fic + d_symbols_msc) {
+        throw std::invalid_argument((boost::format("symbol mask has %d entries, expected %d")
+                                     % symbol_mask.size() % (1 + d_symbols_fic + d_symbols_msc)).str());
+      }
+      gr::thread::scoped_lock guard(d_setlock);
+      d_next_symbol_mask = symbol_mask;
+    }
+
+    void
+    demux_cc_impl::apply_symbol_mask(const pmt::pmt_t &start_tag_value) {
+      // the mask this frame was written with by the synchronization, the own mask for tags without one
+      std::vector<unsigned char> mask;
+      if (frame_start_tag_mask(start_tag_value, mask) &&
+          (mask.empty() || mask.size() == 1 + d_symbols_fic + d_symbols_msc)) {
+        d_symbol_mask.swap(mask);
+      } else {
+        gr::thread::scoped_lock guard(d_setlock);
+        d_symbol_mask = d_next_symbol_mask;
+      }
+    }
+
     void
     demux_cc_impl::forecast(int noutput_items,
                             gr_vector_int &ninput_items_required) {
@@ -84,13 +115,16 @@ namespace gr {
 
       // get tags for the beginning of a frame
       std::vector <gr::tag_t> tags;
-      const std::string s = "Start";
-      pmt::pmt_t d_key = pmt::string_to_symbol(s);
       unsigned int tag_count = 0;
-      get_tags_in_window(tags, 0, 0, noutput_items, d_key);
+      get_tags_in_window(tags, 0, 0, noutput_items, d_start_key);
 
       for (int i = 0; i < noutput_items; ++i) {
-        if (tag_count < tags.size() &&
+        if (d_fic_counter == d_symbols_fic && d_msc_counter < d_symbols_msc && !d_symbol_mask.empty() &&
+            !d_symbol_mask[1 + d_symbols_fic + d_msc_counter]) {
+          // This msc symbol was left out by the synchronization, fill it in.
+          std::fill_n(&msc_out[msc_syms_written++ * d_symbol_lenght], d_symbol_lenght, d_fillval);
+          d_msc_counter++;
+        } else if (tag_count < tags.size() &&
             tags[tag_count].offset - nitems_read(0) - nconsumed == 0) {
           // This input symbol is tagged: a new frame begins here.
           if (d_fic_counter % d_symbols_fic == 0 &&
@@ -102,6 +136,7 @@ namespace gr {
             nconsumed++;
             d_fic_counter = 0;
             d_msc_counter = 0;
+            apply_symbol_mask(tags[tag_count - 1].value);
           } else {
             /* We did not finish the last frame, maybe we lost track in sync during a frame.
              * Let's fill the remaining symbols with fillval
@@ -128,6 +163,10 @@ namespace gr {
                  &in[nconsumed++ * d_symbol_lenght],
                  d_symbol_lenght * sizeof(gr_complex));
           d_msc_counter++;
+        } else {
+          /* The frame is complete, but the next frame does not start yet.
+           * This happens if the symbol mask changed within a frame. Drop the symbol. */
+          nconsumed++;
         }
       }
       // Tell runtime system how many input items we consumed on
@@ -30,6 +30,7 @@ namespace gr {
      * \param symbols_fic number of symbols in the fic per transmission frame
      * \param symobls_mic number of symbols in the msc per transmission frame
      * \param fillval complex value to fill in if sync has been lost during frame
+     * \param symbol_mask symbols of the frame which were passed by the synchronization, empty for all symbols
      */
 
     class demux_cc_impl : public demux_cc {
@@ -49,13 +50,24 @@ namespace gr {
        * The number of fic symbols per transmission frame does not match
        * with the number of transmitted fibs. */
       unsigned int d_msc_counter; /*!< Counts the symbols containing msc data. */
+      std::vector<unsigned char> d_symbol_mask;
+      /*!< Symbols of the current frame which are in the input stream (empty for all symbols). */
+      std::vector<unsigned char> d_next_symbol_mask;
+      /*!< Symbol mask which is applied to frames whose "Start" tag carries no mask. */
+      pmt::pmt_t d_start_key;
+
+      /*! \brief Sets d_symbol_mask for the frame which starts with a "Start" tag with this value. */
+      void apply_symbol_mask(const pmt::pmt_t &start_tag_value);
 
     public:
       demux_cc_impl(unsigned int symbol_length, unsigned int symbols_fic,
-                    unsigned int symbol_msc, gr_complex fillval);
+                    unsigned int symbol_msc, gr_complex fillval,
+                    const std::vector<unsigned char> &symbol_mask);
 
       ~demux_cc_impl();
 
+      void set_symbol_mask(const std::vector<unsigned char> &symbol_mask);
+
       // Where all the action really happens
       void forecast(int noutput_items, gr_vector_int &ninput_items_required);
 
@@ -0,0 +1,136 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+#include "energy_dispersal_bb_impl.h"
+#include "channel_coding.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DAB_ENERGY_DISPERSAL_X86
+#include <immintrin.h>
+#endif
+
+namespace gr {
+  namespace dab {
+
+    namespace {
+      const unsigned int BLOCK = 32;
+    }
+
+    energy_dispersal_bb::sptr
+    energy_dispersal_bb::make(unsigned int length) {
+      return gnuradio::get_initial_sptr(new energy_dispersal_bb_impl(length));
+    }
+
+    /*
+     * The private constructor
+     */
+    energy_dispersal_bb_impl::energy_dispersal_bb_impl(unsigned int length)
+            : gr::sync_block("energy_dispersal_bb",
+                             gr::io_signature::make(1, 1, sizeof(unsigned char)),
+                             gr::io_signature::make(1, 1, sizeof(unsigned char))),
+              d_period(length / 8),
+              d_pos(0) {
+      if (length == 0 || length % 8 != 0)
+        throw std::invalid_argument((boost::format("PRBS length %d is no multiple of 8 bits") % length).str());
+      d_prbs = energy_dispersal_prbs(length);
+      for (unsigned int i = 0; i < BLOCK; i++) {
+        d_prbs.push_back(d_prbs[i % d_period]);
+      }
+#ifdef DAB_ENERGY_DISPERSAL_X86
+      d_avx2 = __builtin_cpu_supports("avx2");
+#else
+      d_avx2 = false;
+#endif
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    energy_dispersal_bb_impl::~energy_dispersal_bb_impl() {
+    }
+
+    void
+    energy_dispersal_bb_impl::scramble(const unsigned char *in, unsigned char *out, unsigned int num) {
+      unsigned int i = 0;
+      for (; i + BLOCK <= num; i += BLOCK) {
+        const unsigned char *prbs = &d_prbs[d_pos];
+        for (unsigned int w = 0; w < BLOCK; w += 8) {
+          uint64_t a, b;
+          memcpy(&a, in + i + w, 8);
+          memcpy(&b, prbs + w, 8);
+          a ^= b;
+          memcpy(out + i + w, &a, 8);
+        }
+        d_pos = (d_pos + BLOCK) % d_period;
+      }
+      for (; i < num; i++) {
+        out[i] = in[i] ^ d_prbs[d_pos];
+        if (++d_pos == d_period)
+          d_pos = 0;
+      }
+    }
+
+#ifdef DAB_ENERGY_DISPERSAL_X86
+    __attribute__((target("avx2"))) void
+    energy_dispersal_bb_impl::scramble_avx2(const unsigned char *in, unsigned char *out, unsigned int num) {
+      unsigned int i = 0;
+      for (; i + BLOCK <= num; i += BLOCK) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (in + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *) &d_prbs[d_pos]);
+        _mm256_storeu_si256((__m256i *) (out + i), _mm256_xor_si256(a, b));
+        d_pos = (d_pos + BLOCK) % d_period;
+      }
+      scramble(in + i, out + i, num - i);
+    }
+#else
+    void
+    energy_dispersal_bb_impl::scramble_avx2(const unsigned char *in, unsigned char *out, unsigned int num) {
+      scramble(in, out, num);
+    }
+#endif
+
+    int
+    energy_dispersal_bb_impl::work(int noutput_items,
+                                   gr_vector_const_void_star &input_items,
+                                   gr_vector_void_star &output_items) {
+      const unsigned char *in = (const unsigned char *) input_items[0];
+      unsigned char *out = (unsigned char *) output_items[0];
+
+      if (d_avx2)
+        scramble_avx2(in, out, noutput_items);
+      else
+        scramble(in, out, noutput_items);
+
+      // Tell runtime system how many output items we produced.
+      return noutput_items;
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
@@ -0,0 +1,63 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_ENERGY_DISPERSAL_BB_IMPL_H
+#define INCLUDED_DAB_ENERGY_DISPERSAL_BB_IMPL_H
+
+#include <dab/energy_dispersal_bb.h>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief XORs packed bytes with the energy dispersal PRBS.
+ *
+ * The PRBS bytes of one period are computed once, followed by a copy of the
+ * first 32 bytes so that a 32 byte block starting anywhere in the period can
+ * be read without wrapping. The XOR runs on 32 bytes at a time, with AVX2 if
+ * the CPU supports it.
+ *
+ * @param length Number of bits after which the PRBS restarts, a multiple of 8.
+ */
+    class energy_dispersal_bb_impl : public energy_dispersal_bb {
+    private:
+      void scramble(const unsigned char *in, unsigned char *out, unsigned int num);
+
+      void scramble_avx2(const unsigned char *in, unsigned char *out, unsigned int num);
+
+      unsigned int d_period; // PRBS period in bytes
+      std::vector<unsigned char> d_prbs; // one period plus 32 bytes
+      unsigned int d_pos; // position of the next byte in the period
+      bool d_avx2;
+
+    public:
+      energy_dispersal_bb_impl(unsigned int length);
+
+      ~energy_dispersal_bb_impl();
+
+      // Where all the action really happens
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_ENERGY_DISPERSAL_BB_IMPL_H */
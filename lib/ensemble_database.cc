@@ -0,0 +1,281 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ensemble_database.h"
+#include <string.h>
+#include <stdio.h>
+#include <sstream>
+
+namespace gr {
+  namespace dab {
+
+    namespace {
+      /*! Writes a label as JSON string, bytes outside of printable ASCII are escaped. */
+      void
+      write_label(std::stringstream &ss, const char *label) {
+        ss << '"';
+        for (int i = 0; i < 16 && label[i] != '\0'; i++) {
+          uint8_t c = (uint8_t) label[i];
+          if (c == '"' || c == '\\') {
+            ss << '\\' << (char) c;
+          } else if (c < 0x20 || c >= 0x7f) {
+            char esc[8];
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            ss << esc;
+          } else {
+            ss << (char) c;
+          }
+        }
+        ss << '"';
+      }
+    }
+
+    ensemble_database::ensemble_database()
+            : d_version(0) {
+      clear();
+      d_version = 0;
+    }
+
+    ensemble_database::~ensemble_database() {
+    }
+
+    void
+    ensemble_database::clear() {
+      d_has_ensemble = false;
+      d_ensemble_reference = 0;
+      d_has_ensemble_label = false;
+      d_ensemble_country_ID = 0;
+      memset(d_ensemble_label, 0, sizeof(d_ensemble_label));
+      memset(d_subchannels, 0, sizeof(d_subchannels));
+      memset(d_components, 0, sizeof(d_components));
+      d_services.clear();
+      d_version++;
+    }
+
+    bool
+    ensemble_database::set_ensemble(uint16_t reference, uint8_t country_ID) {
+      if (d_has_ensemble && d_ensemble_reference == reference && d_ensemble_country_ID == country_ID)
+        return false;
+      if (d_has_ensemble && d_ensemble_reference != reference)
+        clear();
+      d_has_ensemble = true;
+      d_ensemble_reference = reference;
+      d_ensemble_country_ID = country_ID;
+      d_version++;
+      return true;
+    }
+
+    bool
+    ensemble_database::set_ensemble_label(uint8_t country_ID, const char *label) {
+      if (d_has_ensemble_label && d_ensemble_country_ID == country_ID &&
+          memcmp(d_ensemble_label, label, 16) == 0)
+        return false;
+      d_has_ensemble_label = true;
+      d_ensemble_country_ID = country_ID;
+      memcpy(d_ensemble_label, label, 16);
+      d_version++;
+      return true;
+    }
+
+    bool
+    ensemble_database::set_subchannel_eep(uint8_t subchID, uint16_t address, uint8_t option,
+                                          uint8_t protection, uint16_t size) {
+      subchannel &s = d_subchannels[subchID % NUM_SUBCHANNELS];
+      if (s.present && s.eep && s.address == address && s.option == option &&
+          s.protection == protection && s.size == size)
+        return false;
+      s.present = true;
+      s.eep = true;
+      s.address = address;
+      s.option = option;
+      s.protection = protection;
+      s.size = size;
+      s.table_index = 0;
+      d_version++;
+      return true;
+    }
+
+    bool
+    ensemble_database::set_subchannel_uep(uint8_t subchID, uint16_t address, uint8_t table_index) {
+      subchannel &s = d_subchannels[subchID % NUM_SUBCHANNELS];
+      if (s.present && !s.eep && s.address == address && s.table_index == table_index)
+        return false;
+      s.present = true;
+      s.eep = false;
+      s.address = address;
+      s.option = 0;
+      s.protection = 0;
+      s.size = 0;
+      s.table_index = table_index;
+      d_version++;
+      return true;
+    }
+
+    bool
+    ensemble_database::set_component(uint8_t subchID, uint16_t reference, uint8_t tmid, uint8_t type,
+                                     bool primary) {
+      component &c = d_components[subchID % NUM_SUBCHANNELS];
+      if (c.present && c.reference == reference && c.tmid == tmid && c.type == type && c.primary == primary)
+        return false;
+      c.present = true;
+      c.reference = reference;
+      c.tmid = tmid;
+      c.type = type;
+      c.primary = primary;
+      d_version++;
+      return true;
+    }
+
+    bool
+    ensemble_database::complete() const {
+      if (!d_has_ensemble || !d_has_ensemble_label)
+        return false;
+      bool has_component = false;
+      for (int i = 0; i < NUM_SUBCHANNELS; i++) {
+        const component &c = d_components[i];
+        if (!c.present)
+          continue;
+        if (!d_subchannels[i].present)
+          return false;
+        if (c.tmid == 0) {
+          bool has_label = false;
+          for (size_t k = 0; k < d_services.size(); k++) {
+            if (d_services[k].reference == c.reference)
+              has_label = d_services[k].has_label;
+          }
+          if (!has_label)
+            return false;
+        }
+        has_component = true;
+      }
+      return has_component;
+    }
+
+    ensemble_database::service &
+    ensemble_database::find_service(uint16_t reference) {
+      for (size_t i = 0; i < d_services.size(); i++) {
+        if (d_services[i].reference == reference)
+          return d_services[i];
+      }
+      service s;
+      memset(&s, 0, sizeof(s));
+      s.reference = reference;
+      d_services.push_back(s);
+      return d_services.back();
+    }
+
+    bool
+    ensemble_database::set_service_label(uint16_t reference, const char *label) {
+      service &s = find_service(reference);
+      if (s.has_label && memcmp(s.label, label, 16) == 0)
+        return false;
+      s.has_label = true;
+      memcpy(s.label, label, 16);
+      d_version++;
+      return true;
+    }
+
+    bool
+    ensemble_database::set_programme_type(uint16_t reference, uint8_t programme_type) {
+      service &s = find_service(reference);
+      if (s.has_programme_type && s.programme_type == programme_type)
+        return false;
+      s.has_programme_type = true;
+      s.programme_type = programme_type;
+      d_version++;
+      return true;
+    }
+
+    std::string
+    ensemble_database::ensemble_json() const {
+      if (!d_has_ensemble_label)
+        return "";
+      std::stringstream ss;
+      ss << "{";
+      write_label(ss, d_ensemble_label);
+      ss << ":{\"country_ID\":" << (int) d_ensemble_country_ID << "}}";
+      return ss.str();
+    }
+
+    std::string
+    ensemble_database::service_json() const {
+      std::stringstream ss;
+      for (int i = 0; i < NUM_SUBCHANNELS; i++) {
+        const component &c = d_components[i];
+        if (!c.present || c.tmid != 0)
+          continue;
+        ss << (ss.tellp() > 0 ? "," : "[") << "{\"reference\":" << (int) c.reference
+           << ",\"ID\":" << i
+           << ",\"primary\":" << (c.primary ? "true" : "false")
+           << ",\"DAB+\":" << (c.type == 63 ? "true" : "false") << "}";
+      }
+      if (ss.tellp() > 0)
+        ss << "]";
+      return ss.str();
+    }
+
+    std::string
+    ensemble_database::service_labels_json() const {
+      std::stringstream ss;
+      for (size_t i = 0; i < d_services.size(); i++) {
+        if (!d_services[i].has_label)
+          continue;
+        ss << (ss.tellp() > 0 ? "," : "[") << "{\"label\":";
+        write_label(ss, d_services[i].label);
+        ss << ",\"reference\":" << (int) d_services[i].reference << "}";
+      }
+      if (ss.tellp() > 0)
+        ss << "]";
+      return ss.str();
+    }
+
+    std::string
+    ensemble_database::subchannel_json() const {
+      std::stringstream ss;
+      for (int i = 0; i < NUM_SUBCHANNELS; i++) {
+        const subchannel &s = d_subchannels[i];
+        if (!s.present || !s.eep)
+          continue;
+        ss << (ss.tellp() > 0 ? "," : "[") << "{\"ID\":" << i
+           << ",\"address\":" << (int) s.address
+           << ",\"protection\":" << (int) s.protection
+           << ",\"size\":" << (int) s.size << "}";
+      }
+      if (ss.tellp() > 0)
+        ss << "]";
+      return ss.str();
+    }
+
+    std::string
+    ensemble_database::programme_type_json() const {
+      std::stringstream ss;
+      for (size_t i = 0; i < d_services.size(); i++) {
+        if (!d_services[i].has_programme_type)
+          continue;
+        ss << (ss.tellp() > 0 ? "," : "[") << "{\"reference\":" << (int) d_services[i].reference
+           << ",\"programme_type\":" << (int) d_services[i].programme_type << "}";
+      }
+      if (ss.tellp() > 0)
+        ss << "]";
+      return ss.str();
+    }
+
+  }
+}
@@ -0,0 +1,150 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_ENSEMBLE_DATABASE_H
+#define INCLUDED_DAB_ENSEMBLE_DATABASE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief Multiplex configuration and service information of one ensemble.
+ *
+ * Typed model of the ensemble (FIG 0/0, FIG 1/0), the sub-channels (FIG 0/1),
+ * the stream service components (FIG 0/2), the programme service labels (FIG 1/1)
+ * and the programme types (FIG 0/17), see ETSI EN 300 401 chapters 6 and 8.
+ * The setters return true if the stored value changed and count the changes in
+ * version(). Updating an entry that is already known does not allocate; the
+ * JSON strings for the GUI are only built on request.
+ */
+    class ensemble_database {
+    public:
+      /*! Number of sub-channel IDs. */
+      static const int NUM_SUBCHANNELS = 64;
+
+      struct subchannel {
+        bool present;
+        /*! true for equal error protection (long form), false for a UEP table index */
+        bool eep;
+        uint16_t address;
+        /*! size in CUs, 0 if unknown (UEP) */
+        uint16_t size;
+        /*! EEP protection level 0..3 (option 0: 1-A..4-A, option 1: 1-B..4-B) */
+        uint8_t protection;
+        uint8_t option;
+        uint8_t table_index;
+      };
+
+      /*! Stream mode service component carried in a sub-channel. */
+      struct component {
+        bool present;
+        uint16_t reference;
+        /*! transport mechanism: 0 audio stream, 1 data stream */
+        uint8_t tmid;
+        /*! ASCTy or DSCTy, 63 is DAB+ audio */
+        uint8_t type;
+        bool primary;
+      };
+
+      struct service {
+        uint16_t reference;
+        bool has_label;
+        char label[17];
+        bool has_programme_type;
+        uint8_t programme_type;
+      };
+
+      ensemble_database();
+
+      ~ensemble_database();
+
+      /*! Forgets everything, e.g. after retuning to another ensemble. */
+      void clear();
+
+      /*! Number of changes since construction. */
+      unsigned int version() const { return d_version; }
+
+      /*! \brief True once the ensemble and its label, and for every service component
+       * the sub-channel and (audio services) the service label are known. */
+      bool complete() const;
+
+      /*! FIG 0/0. A different ensemble reference clears the database first. */
+      bool set_ensemble(uint16_t reference, uint8_t country_ID);
+
+      /*! FIG 1/0, label with 16 characters. */
+      bool set_ensemble_label(uint8_t country_ID, const char *label);
+
+      /*! FIG 0/1 long form. */
+      bool set_subchannel_eep(uint8_t subchID, uint16_t address, uint8_t option, uint8_t protection, uint16_t size);
+
+      /*! FIG 0/1 short form. */
+      bool set_subchannel_uep(uint8_t subchID, uint16_t address, uint8_t table_index);
+
+      /*! FIG 0/2 stream mode component (TMID 0 or 1). */
+      bool set_component(uint8_t subchID, uint16_t reference, uint8_t tmid, uint8_t type, bool primary);
+
+      /*! FIG 1/1, label with 16 characters. */
+      bool set_service_label(uint16_t reference, const char *label);
+
+      /*! FIG 0/17 */
+      bool set_programme_type(uint16_t reference, uint8_t programme_type);
+
+      bool has_ensemble_label() const { return d_has_ensemble_label; }
+      const char *ensemble_label() const { return d_ensemble_label; }
+      uint8_t ensemble_country_ID() const { return d_ensemble_country_ID; }
+      const subchannel &get_subchannel(int subchID) const { return d_subchannels[subchID]; }
+      const component &get_component(int subchID) const { return d_components[subchID]; }
+      const std::vector<service> &services() const { return d_services; }
+
+      /*! \brief JSON in the format of fib_sink_vb::get_ensemble_info(), empty if no label is known. */
+      std::string ensemble_json() const;
+
+      /*! \brief JSON list of the audio components, empty if there are none. */
+      std::string service_json() const;
+
+      /*! \brief JSON list of the service labels, empty if there are none. */
+      std::string service_labels_json() const;
+
+      /*! \brief JSON list of the EEP sub-channels, empty if there are none. */
+      std::string subchannel_json() const;
+
+      /*! \brief JSON list of the programme types, empty if there are none. */
+      std::string programme_type_json() const;
+
+    private:
+      service &find_service(uint16_t reference);
+
+      unsigned int d_version;
+      bool d_has_ensemble;
+      uint16_t d_ensemble_reference;
+      bool d_has_ensemble_label;
+      uint8_t d_ensemble_country_ID;
+      char d_ensemble_label[17];
+      subchannel d_subchannels[NUM_SUBCHANNELS];
+      component d_components[NUM_SUBCHANNELS];
+      std::vector<service> d_services;
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_ENSEMBLE_DATABASE_H */
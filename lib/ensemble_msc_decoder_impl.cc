@@ -0,0 +1,154 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <boost/bind.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "ensemble_msc_decoder_impl.h"
+
+namespace gr {
+  namespace dab {
+
+    ensemble_msc_decoder::sptr
+    ensemble_msc_decoder::make(unsigned int symbol_length,
+                               const std::vector<unsigned int> &addresses,
+                               const std::vector<unsigned int> &sizes,
+                               const std::vector<int> &protections,
+                               unsigned int num_threads) {
+      return gnuradio::get_initial_sptr
+              (new ensemble_msc_decoder_impl(symbol_length, addresses, sizes, protections, num_threads));
+    }
+
+    /*
+     * The private constructor
+     */
+    ensemble_msc_decoder_impl::ensemble_msc_decoder_impl(unsigned int symbol_length,
+                                                         const std::vector<unsigned int> &addresses,
+                                                         const std::vector<unsigned int> &sizes,
+                                                         const std::vector<int> &protections,
+                                                         unsigned int num_threads)
+            : gr::block("ensemble_msc_decoder",
+                        gr::io_signature::make(1, 1, sizeof(gr_complex) * symbol_length),
+                        gr::io_signature::make(0, 0, 0)),
+              d_symbol_length(symbol_length),
+              d_pool(num_threads),
+              d_num_cifs(0),
+              d_port(pmt::mp("subchannels")) {
+      const unsigned int cif_bits = msc_subchannel_decoder::NUM_CUS * msc_subchannel_decoder::CU_SIZE;
+      if (symbol_length == 0 || cif_bits % (2 * symbol_length) != 0)
+        throw std::invalid_argument((boost::format("symbol length %d does not divide a CIF") % symbol_length).str());
+      d_symbols_per_cif = cif_bits / (2 * symbol_length);
+      if (addresses.empty() || sizes.size() != addresses.size() || protections.size() != addresses.size())
+        throw std::invalid_argument((boost::format("got %d addresses, %d sizes and %d protection levels")
+                                     % addresses.size() % sizes.size() % protections.size()).str());
+
+      d_subchannels.resize(addresses.size());
+      std::vector<std::pair<unsigned int, unsigned int> > by_address, by_size;
+      for (unsigned int s = 0; s < addresses.size(); s++) {
+        subchannel &sub = d_subchannels[s];
+        sub.decoder.reset(new msc_subchannel_decoder(addresses[s], sizes[s], protections[s]));
+        sub.soft.resize(MAX_CIFS * sizes[s] * msc_subchannel_decoder::CU_SIZE);
+        sub.frames.resize(MAX_CIFS * sub.decoder->bytes());
+        sub.meta = pmt::make_dict();
+        sub.meta = pmt::dict_add(sub.meta, pmt::mp("subch_index"), pmt::from_long(s));
+        sub.meta = pmt::dict_add(sub.meta, pmt::mp("address"), pmt::from_long(addresses[s]));
+        sub.meta = pmt::dict_add(sub.meta, pmt::mp("size"), pmt::from_long(sizes[s]));
+        by_address.push_back(std::make_pair(addresses[s], s));
+        by_size.push_back(std::make_pair(sizes[s], s));
+      }
+      std::sort(by_address.begin(), by_address.end());
+      std::sort(by_size.rbegin(), by_size.rend());
+      for (unsigned int i = 0; i < by_address.size(); i++) {
+        d_by_address.push_back(by_address[i].second);
+        d_by_size.push_back(by_size[i].second);
+      }
+
+      message_port_register_out(d_port);
+      set_tag_propagation_policy(TPP_DONT);
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ensemble_msc_decoder_impl::~ensemble_msc_decoder_impl() {
+    }
+
+    void
+    ensemble_msc_decoder_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required) {
+      ninput_items_required[0] = d_symbols_per_cif;
+    }
+
+    void
+    ensemble_msc_decoder_impl::decode_subchannel(unsigned int task) {
+      subchannel &sub = d_subchannels[d_by_size[task]];
+      const unsigned int cif_bits = sub.decoder->size() * msc_subchannel_decoder::CU_SIZE;
+      for (int c = 0; c < d_num_cifs; c++) {
+        sub.decoder->decode(&sub.soft[c * cif_bits], &sub.frames[c * sub.decoder->bytes()]);
+      }
+    }
+
+    int
+    ensemble_msc_decoder_impl::general_work(int noutput_items,
+                                            gr_vector_int &ninput_items,
+                                            gr_vector_const_void_star &input_items,
+                                            gr_vector_void_star &output_items) {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+
+      d_num_cifs = std::min(ninput_items[0] / (int) d_symbols_per_cif, MAX_CIFS);
+      if (d_num_cifs == 0)
+        return 0;
+
+      // split the CIFs into the sub-channels, walking each CIF in CU order
+      for (int c = 0; c < d_num_cifs; c++) {
+        for (unsigned int i = 0; i < d_by_address.size(); i++) {
+          subchannel &sub = d_subchannels[d_by_address[i]];
+          const unsigned int cif_bits = sub.decoder->size() * msc_subchannel_decoder::CU_SIZE;
+          msc_subchannel_decoder::extract_cus(in, d_symbol_length, sub.decoder->address(), sub.decoder->size(),
+                                              &sub.soft[c * cif_bits]);
+        }
+        in += d_symbols_per_cif * d_symbol_length;
+      }
+
+      d_pool.run(d_subchannels.size(), boost::bind(&ensemble_msc_decoder_impl::decode_subchannel, this, _1));
+
+      for (int c = 0; c < d_num_cifs; c++) {
+        for (unsigned int s = 0; s < d_subchannels.size(); s++) {
+          const subchannel &sub = d_subchannels[s];
+          const unsigned int bytes = sub.decoder->bytes();
+          message_port_pub(d_port, pmt::cons(sub.meta, pmt::init_u8vector(bytes, &sub.frames[c * bytes])));
+        }
+      }
+      // Tell runtime system how many input items we consumed on
+      // each input stream.
+      consume_each(d_num_cifs * d_symbols_per_cif);
+
+      // No stream outputs, the logical frames leave through the message port.
+      return 0;
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
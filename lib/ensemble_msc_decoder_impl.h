@@ -0,0 +1,88 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_ENSEMBLE_MSC_DECODER_IMPL_H
+#define INCLUDED_DAB_ENSEMBLE_MSC_DECODER_IMPL_H
+
+#include <dab/ensemble_msc_decoder.h>
+#include <boost/shared_ptr.hpp>
+#include "msc_subchannel_decoder.h"
+#include "thread_pool.h"
+
+namespace gr {
+  namespace dab {
+/*! \brief Decodes several MSC sub-channels in parallel.
+ *
+ * Each call to general_work handles up to MAX_CIFS CIFs. The soft bits of
+ * all sub-channels are copied out of the CIFs first, then every sub-channel
+ * decodes its CIFs in order on one thread of the pool (the time deinterleaver
+ * of a sub-channel carries state from one CIF to the next). Sub-channels are
+ * handed out from the largest to the smallest to balance the threads.
+ *
+ * @param symbol_length Number of carriers per OFDM symbol.
+ * @param addresses Start addresses of the sub-channels in CUs.
+ * @param sizes Sizes of the sub-channels in CUs.
+ * @param protections EEP-A protection levels of the sub-channels (0 for 1-A to 3 for 4-A).
+ * @param num_threads Number of decoding threads, 0 for one per CPU core.
+ */
+    class ensemble_msc_decoder_impl : public ensemble_msc_decoder {
+    private:
+      static const int MAX_CIFS = 8;
+
+      struct subchannel {
+        boost::shared_ptr<msc_subchannel_decoder> decoder;
+        std::vector<float> soft; // soft bits of up to MAX_CIFS CIFs
+        std::vector<unsigned char> frames; // logical frames of up to MAX_CIFS CIFs
+        pmt::pmt_t meta;
+      };
+
+      unsigned int d_symbol_length;
+      unsigned int d_symbols_per_cif;
+      std::vector<subchannel> d_subchannels;
+      std::vector<unsigned int> d_by_address; // extraction order
+      std::vector<unsigned int> d_by_size; // decoding order, largest first
+      thread_pool d_pool;
+      int d_num_cifs;
+      const pmt::pmt_t d_port;
+
+      void decode_subchannel(unsigned int task);
+
+    public:
+      ensemble_msc_decoder_impl(unsigned int symbol_length,
+                                const std::vector<unsigned int> &addresses,
+                                const std::vector<unsigned int> &sizes,
+                                const std::vector<int> &protections,
+                                unsigned int num_threads);
+
+      ~ensemble_msc_decoder_impl();
+
+      // Where all the action really happens
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_ENSEMBLE_MSC_DECODER_IMPL_H */
@@ -0,0 +1,95 @@
+/* Speed test of the DAB+ superframe Reed-Solomon decoder
+ *
+ * Decodes superframes of RS(120, 110) codewords (ETSI TS 102 563) with
+ * rs_superframe_decoder and with the former loop that calls the general
+ * decoder for each codeword, for clean input and for input with byte errors,
+ * and reports superframes per second. The results of both decoders are compared.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <vector>
+#include "rs_superframe_decoder.h"
+
+extern "C" {
+#include "fec.h"
+}
+
+using gr::dab::rs_superframe_decoder;
+
+static double cpu_time(){
+  struct rusage r;
+  getrusage(RUSAGE_SELF,&r);
+  return r.ru_utime.tv_sec + 1e-6*r.ru_utime.tv_usec;
+}
+
+/* the per codeword decoding of the former reed_solomon_decode_bb */
+static void decode_reference(void *rs,const unsigned char *in,unsigned char *out,int n){
+  unsigned char packet[120];
+  int corr_pos[10];
+  memcpy(out,in,110*n);
+  for(int i=0;i<n;i++){
+    for(int pos=0;pos<120;pos++)
+      packet[pos] = in[pos*n+i];
+    int count = decode_rs_char(rs,packet,corr_pos,0);
+    for(int j=0;j<count;j++){
+      int pos = corr_pos[j] - 135;
+      if(pos >= 0 && pos < 110)
+        out[pos*n+i] = packet[pos];
+    }
+  }
+}
+
+int main(int argc,char *argv[]){
+  int trials = argc > 1 ? atoi(argv[1]) : 2000;
+  const int rates[] = {4,12,24,48};
+  int failures = 0;
+  void *rs = init_rs_char(8,0x11D,0,1,10,135);
+
+  srandom(1);
+  for(int r=0;r<4;r++){
+    int n = rates[r];
+    std::vector<unsigned char> clean(120*n),noisy(120*n),out(110*n),ref(110*n);
+    unsigned char codeword[120];
+    /* random data, encoded and interleaved */
+    for(int i=0;i<n;i++){
+      for(int pos=0;pos<110;pos++)
+        codeword[pos] = random() & 0xff;
+      encode_rs_char(rs,codeword,&codeword[110]);
+      for(int pos=0;pos<120;pos++)
+        clean[pos*n+i] = codeword[pos];
+    }
+    /* 1 to 4 byte errors in every second codeword */
+    noisy = clean;
+    for(int i=0;i<n;i+=2){
+      int errors = 1 + random() % 4;
+      for(int e=0;e<errors;e++)
+        noisy[(random() % 120)*n+i] ^= 1 + random() % 255;
+    }
+
+    rs_superframe_decoder decoder(n);
+    const unsigned char *inputs[2] = {&clean[0],&noisy[0]};
+    const char *names[2] = {"clean","noisy"};
+    for(int k=0;k<2;k++){
+      double start = cpu_time();
+      for(int t=0;t<trials;t++)
+        decoder.decode(inputs[k],&out[0]);
+      double superframe_time = cpu_time() - start;
+      start = cpu_time();
+      for(int t=0;t<trials;t++)
+        decode_reference(rs,inputs[k],&ref[0],n);
+      double reference_time = cpu_time() - start;
+
+      if(out != ref || memcmp(&out[0],&clean[0],110*n)){
+        printf("bit_rate_n %d, %s input: decoded superframe differs\n",n,names[k]);
+        failures++;
+      }
+      printf("bit_rate_n %2d, %s input: %10.0f superframes/s (per codeword decoding: %10.0f superframes/s)\n",
+             n,names[k],trials/superframe_time,trials/reference_time);
+    }
+  }
+  free_rs_char(rs);
+  exit(failures ? 1 : 0);
+}
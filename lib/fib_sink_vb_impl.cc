@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <sstream>
 #include <string>
+#include <string.h>
 #include <boost/format.hpp>
 #include "crc16.h"
 #include "FIC.h"
@@ -48,18 +49,16 @@ namespace gr {
     fib_sink_vb_impl::fib_sink_vb_impl()
             : gr::sync_block("fib_sink_vb",
                              gr::io_signature::make(1, 1, sizeof(char) * 32),
-                             gr::io_signature::make(0, 0, 0)) {
-      d_service_info_written_trigger = -1;
-      d_service_labels_written_trigger = -1;
-      d_subch_info_written_trigger = -1;
-      d_programme_type_written_trigger = -1;
-      d_crc_passed = false;
+                             gr::io_signature::make(0, 0, 0)),
+              d_crc_passed(false),
+              d_port(pmt::mp("ensemble")) {
+      message_port_register_out(d_port);
     }
 
     int
     fib_sink_vb_impl::process_fib(const char *fib) {
       uint8_t type, length, pos;
-      if (crc16(fib, FIB_LENGTH, FIB_CRC_POLY, FIB_CRC_INITSTATE) != 0) {
+      if (!d_crc16.check((const uint8_t *) fib, FIB_LENGTH - FIB_CRC_LENGTH)) {
         GR_LOG_DEBUG(d_logger, "FIB CRC error");
         d_crc_passed = false;
         return 1;
@@ -72,14 +71,10 @@ namespace gr {
              (uint8_t) fib[pos] != 0) { //TODO correct?
         type = fib[pos] >> 5;
         length = fib[pos] & 0x1f;
-        // if ((pos + length) > (FIB_LENGTH - FIB_CRC_LENGTH)){
-        //   GR_LOG_INFO(d_logger, "pos + length: " + std::to_string((pos + length)));
-        //   return 1;
-        // }
-        // if (length != 0){
-        //   GR_LOG_INFO(d_logger, "length must be greater than zero!");
-        //   return 1;
-        // }
+        if (pos + length >= FIB_LENGTH - FIB_CRC_LENGTH) {
+          GR_LOG_DEBUG(d_logger, "FIG exceeds the FIB");
+          return 1;
+        }
         process_fig(type, &fib[pos], length);
         pos += length + 1;
       }
@@ -91,160 +86,119 @@ namespace gr {
       uint8_t cn, oe, pd, extension;
       switch (type) {
         case FIB_FIG_TYPE_MCI:
-          GR_LOG_DEBUG(d_logger, "FIG type 0");
           extension = (uint8_t)(data[1] & 0x1f);
           cn = (uint8_t)(data[1] & 0x80);
-          if (cn == 1)
-            GR_LOG_DEBUG(d_logger, "[WARNING, INFO FOR FUTURE CONFIGURATION]: ");
           oe = (uint8_t)(data[1] & 0x40);
-          if (cn == 1)
-            GR_LOG_DEBUG(d_logger, "[WARNING, INFO FOR OTHER ENSEMBLE]");
           pd = (uint8_t)(data[1] & 0x20);
-          if (pd == 1) GR_LOG_DEBUG(d_logger, "[WARNING, LONG IDENTIFIER");
+          // only the current configuration of this ensemble goes into the database
+          if (cn != 0 || oe != 0) {
+            GR_LOG_DEBUG(d_logger, "FIG 0 for the next configuration or another ensemble");
+            break;
+          }
 
           switch (extension) {
             case FIB_MCI_EXTENSION_ENSEMBLE_INFO: {
               uint8_t country_ID = (uint8_t)((data[2] & 0xf0) >> 4);
               uint16_t ensemble_reference = (uint16_t)(data[2] & 0x0f) << 8 | (uint8_t) data[3];
-              uint8_t change_flag = (uint8_t)((data[4] & 0xc0) >> 6);
-              uint8_t occurrence_change = data[6];
-              if (change_flag != 0)
+              if (d_db.set_ensemble(ensemble_reference, country_ID)) {
                 GR_LOG_DEBUG(d_logger,
-                             format(", [CHANGE OF SUBCHANNEL OR SERVICE ORGA (%d)](at CIF %d) ") %
-                             (int) change_flag %
-                             (int) occurrence_change);
-              uint8_t alarm_flag = (uint8_t)((data[4] & 0x20) >> 5);
-              if (alarm_flag == 1) {
-                GR_LOG_DEBUG(d_logger, ", [ALARM MESSAGE ACCESSIBLE] ");
+                             format("ensemble info: reference %d, country ID %d") %
+                             ensemble_reference %
+                             (int) country_ID);
+                pmt::pmt_t change = pmt::make_dict();
+                change = pmt::dict_add(change, pmt::mp("reference"), pmt::from_long(ensemble_reference));
+                change = pmt::dict_add(change, pmt::mp("country_ID"), pmt::from_long(country_ID));
+                publish("ensemble", change);
               }
-              uint16_t CIF_counter = (uint16_t)( (data[4] & 0x1f) * 250 + (data[5]));
-              GR_LOG_DEBUG(d_logger,
-                           format("ensemble info: reference %d, country ID %d, CIF counter = %d") %
-                           ensemble_reference %
-                           (int) country_ID %
-                           CIF_counter);
               break;
             }
             case FIB_MCI_EXTENSION_SUBCHANNEL_ORGA: {
-              uint8_t subch_counter = 0;
-              GR_LOG_DEBUG(d_logger, "subchannel orga: ");
-              do {
-                uint8_t subchID = (uint8_t)((data[2 + subch_counter] & 0xfc) >> 2);
-                uint16_t start_address = (uint16_t)((data[2 + subch_counter] & 0x03) << 8) | (uint8_t)(data[3 + subch_counter]);
-                uint8_t sl_form = (uint8_t)(data[4] & 0x80);
-                if (sl_form == 0) {
-                  uint8_t table_switch = (uint8_t)(data[4 + subch_counter] & 0x40);
-                  if (table_switch != 0) {
-                    GR_LOG_DEBUG(d_logger, " [WARNING: OTHER TABLE USED] ");
+              int pos = 2;
+              while (pos + 2 <= length) {
+                uint8_t subchID = (uint8_t)((data[pos] & 0xfc) >> 2);
+                uint16_t start_address = (uint16_t)((data[pos] & 0x03) << 8) | (uint8_t) data[pos + 1];
+                if ((data[pos + 2] & 0x80) == 0) {
+                  // short form, UEP
+                  uint8_t table_index = (uint8_t)(data[pos + 2] & 0x3f);
+                  if (d_db.set_subchannel_uep(subchID, start_address, table_index)) {
+                    GR_LOG_DEBUG(d_logger,
+                                 format("subchID = %d , start address = %d, index %d") %
+                                 (int) subchID %
+                                 (int) start_address %
+                                 (int) table_index);
+                    pmt::pmt_t change = pmt::make_dict();
+                    change = pmt::dict_add(change, pmt::mp("ID"), pmt::from_long(subchID));
+                    change = pmt::dict_add(change, pmt::mp("address"), pmt::from_long(start_address));
+                    change = pmt::dict_add(change, pmt::mp("table_index"), pmt::from_long(table_index));
+                    publish("subchannel", change);
                   }
-                  uint8_t table_index = (uint8_t)(data[4 + subch_counter] & 0x3f);
-                  GR_LOG_DEBUG(d_logger,
-                               format("subchID = %d , start address = %d, index %d") %
-                               (int) subchID %
-                               (int) start_address %
-                               (int) table_index);
-                  subch_counter += 3;
+                  pos += 3;
                 } else {
-                  uint8_t option = (uint8_t)(data[4 + subch_counter] & 0x70);
-                  uint8_t protect_level = (uint8_t)((data[4 + subch_counter] & 0x0c) >> 2);
-                  uint16_t subch_size = (uint16_t)((data[4 + subch_counter] & 0x03) << 8) | (uint8_t)(data[5 + subch_counter]);
-                  GR_LOG_DEBUG(d_logger,
-                               format("subchID = %d , start address = %d, option %d, protect level %d, subch size %d") %
-                               (int) subchID %
-                               (int) start_address %
-                               (int) option %
-                               (int) protect_level %
-                               (int) subch_size);
-                  subch_counter += 4;
-
-                  // write sub-channel info to json
-                  if (d_subch_info_written_trigger < 0) {
-                    d_subch_info_written_trigger = (int) subchID;
-                  } else {
-                    std::stringstream ss;
-                    ss << d_subch_info_current << ",{" << "\"ID\":"
-                       << (int) subchID << ",\"address\":"
-                       << (int) start_address << ",\"protection\":"
-                       << (int) protect_level << ",\"size\":"
-                       << (int) subch_size << "}\0";
-                    d_subch_info_current = ss.str();
-                    if ((int) subchID == d_subch_info_written_trigger) {
-                      std::stringstream ss_json;
-                      ss_json << d_subch_info_current << "]" << "\0";
-                      d_subch_info_current = "\0";
-                      d_json_subch_info = ss_json.str();
-                      d_json_subch_info[0] = '[';
-                      d_subch_info_written_trigger = -1;
-                    }
+                  // long form, EEP
+                  if (pos + 3 > length)
+                    break;
+                  uint8_t option = (uint8_t)((data[pos + 2] & 0x70) >> 4);
+                  uint8_t protect_level = (uint8_t)((data[pos + 2] & 0x0c) >> 2);
+                  uint16_t subch_size = (uint16_t)((data[pos + 2] & 0x03) << 8) | (uint8_t) data[pos + 3];
+                  if (d_db.set_subchannel_eep(subchID, start_address, option, protect_level, subch_size)) {
+                    GR_LOG_DEBUG(d_logger,
+                                 format("subchID = %d , start address = %d, option %d, protect level %d, subch size %d") %
+                                 (int) subchID %
+                                 (int) start_address %
+                                 (int) option %
+                                 (int) protect_level %
+                                 (int) subch_size);
+                    pmt::pmt_t change = pmt::make_dict();
+                    change = pmt::dict_add(change, pmt::mp("ID"), pmt::from_long(subchID));
+                    change = pmt::dict_add(change, pmt::mp("address"), pmt::from_long(start_address));
+                    change = pmt::dict_add(change, pmt::mp("option"), pmt::from_long(option));
+                    change = pmt::dict_add(change, pmt::mp("protection"), pmt::from_long(protect_level));
+                    change = pmt::dict_add(change, pmt::mp("size"), pmt::from_long(subch_size));
+                    publish("subchannel", change);
                   }
+                  pos += 4;
                 }
-              } while (1 + subch_counter < length);
+              }
               break;
             }
             case FIB_MCI_EXTENSION_SERVICE_ORGA: {
-              uint8_t service_counter = 1;
-              do { //iterate over services
-                uint16_t service_reference = (uint16_t)(data[service_counter + 1] & 0x0f) << 8 | (uint8_t) data[service_counter + 2];
-                GR_LOG_DEBUG(d_logger, format("service orga: reference %d ") % service_reference);
-                uint8_t local_flag = (uint8_t)((data[service_counter + 3] & 0x80) >> 7);
-                if (local_flag == 1) {
-                  GR_LOG_DEBUG(d_logger, "[LOCAL FLAG SET] ");
-                }
-                uint8_t ca = (uint8_t)((data[service_counter + 3] & 0x70) >> 4);
-                if (ca != 0) {
-                  GR_LOG_DEBUG(d_logger, "[CONDITIONAL ACCESS USED] ");
-                }
-                uint8_t num_service_comps = (uint8_t)(data[service_counter + 3] & 0x0f);
-                GR_LOG_DEBUG(d_logger, format("(%d components):") % (int) num_service_comps);
+              // programme services have 16 bit, data services 32 bit service identifiers
+              const int sid_length = pd ? 4 : 2;
+              int pos = 2;
+              while (pos + sid_length <= length) { //iterate over services
+                uint16_t service_reference =
+                        (uint16_t)(data[pos + sid_length - 2] & 0x0f) << 8 | (uint8_t) data[pos + sid_length - 1];
+                uint8_t num_service_comps = (uint8_t)(data[pos + sid_length] & 0x0f);
+                const char *comp = &data[pos + sid_length + 1];
+                if (pos + sid_length + 2 * num_service_comps > length)
+                  break;
                 for (int i = 0; i < num_service_comps; i++) { //iterate over service components
-                  uint8_t TMID = (uint8_t)( (data[service_counter + 4 + i * 2] & 0xc0) >> 6);
-                  uint8_t comp_type = (uint8_t)( data[service_counter + 4 + i * 2] & 0x3f);
-                  uint8_t subchID = (uint8_t)((data[service_counter + 5 + i * 2] & 0xfc) >> 2);
-                  uint8_t ps = (uint8_t)((data[service_counter + 5 + i * 2 + 1] & 0x02) >> 1);
-                  if (TMID == 0) {
-                    GR_LOG_DEBUG(d_logger,
-                                 format("(audio stream, type %d, subchID %d, primary %d)") %
-                                 (int) comp_type %
-                                 (int) subchID % (int) ps);
-                    // write service info from specififc subchannel to json
-                    if (d_service_info_written_trigger < 0) {
-                      d_service_info_written_trigger = (int) subchID;
-                    } else {
-                      std::stringstream ss;
-                      ss << d_service_info_current << ",{" << "\"reference\":"
-                         << (int) service_reference << ",\"ID\":"
-                         << (int) subchID << ",\"primary\":"
-                         << ((ps == 1) ? "true" : "false") << ",\"DAB+\":"
-                         << (((int) comp_type == 63) ? "true" : "false")
-                         << "}\0";
-                      d_service_info_current = ss.str();
-                      if ((int) subchID == d_service_info_written_trigger) {
-                        std::stringstream ss_json;
-                        ss_json << d_service_info_current << "]" << "\0";
-                        d_service_info_current = "\0";
-                        d_json_service_info = ss_json.str();
-                        d_json_service_info[0] = '[';
-                        d_service_info_written_trigger = -1;
-                      }
-                    }
-                  } else if (TMID == 1) {
-                    GR_LOG_DEBUG(d_logger,
-                                 format("(data stream, type %d, subchID %d, primary %d)") %
-                                 (int) comp_type %
-                                 (int) subchID %
-                                 (int) ps);
-                  } else if (TMID == 2) {
+                  uint8_t TMID = (uint8_t)((comp[2 * i] & 0xc0) >> 6);
+                  uint8_t comp_type = (uint8_t)(comp[2 * i] & 0x3f);
+                  uint8_t subchID = (uint8_t)((comp[2 * i + 1] & 0xfc) >> 2);
+                  bool primary = (comp[2 * i + 1] & 0x02) != 0;
+                  // stream mode components of programme services, one per sub-channel
+                  if (pd != 0 || TMID > 1)
+                    continue;
+                  if (d_db.set_component(subchID, service_reference, TMID, comp_type, primary)) {
                     GR_LOG_DEBUG(d_logger,
-                                 format("(FIDC, type %d, subchID %d, primary %d)") %
+                                 format("service orga: reference %d (%s stream, type %d, subchID %d, primary %d)") %
+                                 service_reference %
+                                 (TMID == 0 ? "audio" : "data") %
                                  (int) comp_type %
                                  (int) subchID %
-                                 (int) ps);
-                  } else {
-                    GR_LOG_DEBUG(d_logger, "[packed data]");
+                                 (int) primary);
+                    pmt::pmt_t change = pmt::make_dict();
+                    change = pmt::dict_add(change, pmt::mp("ID"), pmt::from_long(subchID));
+                    change = pmt::dict_add(change, pmt::mp("reference"), pmt::from_long(service_reference));
+                    change = pmt::dict_add(change, pmt::mp("TMID"), pmt::from_long(TMID));
+                    change = pmt::dict_add(change, pmt::mp("component_type"), pmt::from_long(comp_type));
+                    change = pmt::dict_add(change, pmt::mp("primary"), pmt::from_bool(primary));
+                    publish("component", change);
                   }
                 }
-                service_counter += 3 + 2 * num_service_comps;
-              } while (service_counter < length);
+                pos += sid_length + 1 + 2 * num_service_comps;
+              }
               break;
             }
             case FIB_MCI_EXTENSION_SERVICE_ORGA_PACKET_MODE:
@@ -256,33 +210,9 @@ namespace gr {
             case FIB_SI_EXTENSION_SERVICE_COMP_LANGUAGE:
               GR_LOG_DEBUG(d_logger, "service comp language");
               break;
-            case FIB_MCI_EXTENSION_SERVICE_COMP_GLOBAL_DEFINITION: {
-              uint8_t service_comp_counter = 0;
-              do {
-                uint16_t service_reference =
-                        (uint16_t)(data[service_comp_counter + 2] & 0x0f) << 8 | (uint8_t) data[service_comp_counter + 3];
-                uint8_t SCIdS = (uint8_t)(data[service_comp_counter + 4] & 0x0f);
-                if ((data[service_comp_counter + 5] & 0x80) == 0) {
-                  uint8_t subchID = (uint8_t)(data[service_comp_counter + 5] & 0x3f);
-                  GR_LOG_DEBUG(d_logger,
-                               format("service component global definition: reference %d, SCIdS %d, subchID %d") %
-                               service_reference %
-                               (int) SCIdS %
-                               (int) subchID);
-                  service_comp_counter += 5;
-                } else {
-                  uint16_t subchID =
-                          (uint16_t)(data[service_comp_counter + 5] & 0x0f)<< 8 | (uint8_t) data[service_comp_counter + 6];
-                  GR_LOG_DEBUG(d_logger,
-                               format("service component global definition: reference %d, SCIdS %d, subchID %d") %
-                               service_reference %
-                               (int) SCIdS %
-                               (int) subchID);
-                  service_comp_counter += 6;
-                }
-              } while (1 + service_comp_counter < length);
+            case FIB_MCI_EXTENSION_SERVICE_COMP_GLOBAL_DEFINITION:
+              GR_LOG_DEBUG(d_logger, "service component global definition");
               break;
-            }
             case FIB_SI_EXTENSION_COUNTRY_LTO:
               GR_LOG_DEBUG(d_logger, "country LTO");
               break;
@@ -296,32 +226,18 @@ namespace gr {
               GR_LOG_DEBUG(d_logger, "programme number");
               break;
             case FIB_SI_EXTENSION_PROGRAMME_TYPE: {
-              GR_LOG_DEBUG(d_logger, format("programme type, %d components") % ((length - 1) / 4));
               for (int i = 0; i < (length - 1) / 4; i++) {
                 uint8_t programme_type = (uint8_t)(data[2 + i * 4 + 3] & 0x1f);
                 uint16_t service_reference = (uint16_t)(data[2 + i * 4] & 0x0f) << 8 | (uint8_t) data[2 + i * 4 + 1];
-                GR_LOG_DEBUG(d_logger,
-                             format("reference %d, type: %d") %
-                             service_reference %
-                             (int) programme_type);
-
-                // write programme type to json
-                if (d_programme_type_written_trigger < 0) {
-                  d_programme_type_written_trigger = (int) service_reference;
-                } else {
-                  std::stringstream ss;
-                  ss << d_programme_type_current << ",{" << "\"reference\":"
-                     << (int) service_reference << ",\"programme_type\":"
-                     << (int) programme_type << "}\0";
-                  d_programme_type_current = ss.str();
-                  if ((int) service_reference == d_programme_type_written_trigger) {
-                    std::stringstream ss_json;
-                    ss_json << d_programme_type_current << "]" << "\0";
-                    d_programme_type_current = "\0";
-                    d_json_programme_type = ss_json.str();
-                    d_json_programme_type[0] = '[';
-                    d_programme_type_written_trigger = -1;
-                  }
+                if (d_db.set_programme_type(service_reference, programme_type)) {
+                  GR_LOG_DEBUG(d_logger,
+                               format("programme type: reference %d, type: %d") %
+                               service_reference %
+                               (int) programme_type);
+                  pmt::pmt_t change = pmt::make_dict();
+                  change = pmt::dict_add(change, pmt::mp("reference"), pmt::from_long(service_reference));
+                  change = pmt::dict_add(change, pmt::mp("programme_type"), pmt::from_long(programme_type));
+                  publish("programme_type", change);
                 }
               }
               break;
@@ -333,69 +249,65 @@ namespace gr {
               GR_LOG_DEBUG(d_logger, "announcement switching");
               break;
             default:
-              GR_LOG_DEBUG(d_logger, format("unsupported extension (%d)") % (int) extension);
+              GR_LOG_DEBUG(d_logger, "unsupported extension");
               break;
           }
           break;
-        case FIB_FIG_TYPE_LABEL1:
-        case FIB_FIG_TYPE_LABEL2: {
-          GR_LOG_DEBUG(d_logger, "FIG type 2");
-          char label[17];
-          label[16] = '\0';
+        case FIB_FIG_TYPE_LABEL1: {
           extension = (uint8_t)(data[1] & 0x07);
+          oe = (uint8_t)(data[1] & 0x08);
+          // identifier (2 bytes), 16 characters and the character flag field
+          if (oe != 0 || length < 19) {
+            GR_LOG_DEBUG(d_logger, "label of another ensemble");
+            break;
+          }
           switch (extension) {
             case FIB_SI_EXTENSION_ENSEMBLE_LABEL: {
               uint8_t country_ID = (uint8_t)((data[2] & 0xf0) >> 4);
-              memcpy(label, &data[4], 16);
-              GR_LOG_DEBUG(d_logger, format("[ensemble label](%d): %s") % (int) country_ID % label);
-              // write json for ensemble label and country ID
-              std::stringstream ss;
-              ss << "{" << "\"" << label << "\":{" << "\"country_ID\":" << (int) country_ID << "}}";
-              d_json_ensemble_info = ss.str();
+              if (d_db.set_ensemble_label(country_ID, &data[4])) {
+                GR_LOG_DEBUG(d_logger,
+                             format("[ensemble label](%d): %s") %
+                             (int) country_ID %
+                             d_db.ensemble_label());
+                pmt::pmt_t change = pmt::make_dict();
+                change = pmt::dict_add(change, pmt::mp("label"), pmt::mp(d_db.ensemble_label()));
+                change = pmt::dict_add(change, pmt::mp("country_ID"), pmt::from_long(country_ID));
+                publish("ensemble_label", change);
+              }
               break;
             }
             case FIB_SI_EXTENSION_PROGRAMME_SERVICE_LABEL: {
               uint16_t service_reference = (uint16_t)(data[2] & 0x0f) << 8 | (uint8_t) data[3];
-              memcpy(label, &data[4], 16);
-              GR_LOG_DEBUG(d_logger,
-                           format("[programme service label] (reference %d): %s") %
-                           service_reference % label);
-              // write service labels from services to json
-              if (d_service_labels_written_trigger < 0) {
-                d_service_labels_written_trigger = (int) service_reference;
-              } else {
-                std::stringstream ss;
-                ss << d_service_labels_current << ",{" << "\"label\":\""
-                   << label << "\",\"reference\":"
-                   << (int) service_reference << "}\0";
-                d_service_labels_current = ss.str();
-                if ((int) service_reference == d_service_labels_written_trigger) {
-                  std::stringstream ss_json;
-                  ss_json << d_service_labels_current << "]" << "\0";
-                  d_service_labels_current = "\0";
-                  d_json_service_labels = ss_json.str();
-                  d_json_service_labels[0] = '[';
-                  d_service_labels_written_trigger = -1;
-                }
+              if (d_db.set_service_label(service_reference, &data[4])) {
+                char label[17];
+                memcpy(label, &data[4], 16);
+                label[16] = '\0';
+                GR_LOG_DEBUG(d_logger,
+                             format("[programme service label] (reference %d): %s") %
+                             service_reference % label);
+                pmt::pmt_t change = pmt::make_dict();
+                change = pmt::dict_add(change, pmt::mp("reference"), pmt::from_long(service_reference));
+                change = pmt::dict_add(change, pmt::mp("label"), pmt::mp(label));
+                publish("service_label", change);
               }
               break;
             }
             case FIB_SI_EXTENSION_SERVICE_COMP_LABEL:
-              memcpy(label, &data[5], 16);
-              GR_LOG_DEBUG(d_logger, format("[service component label] %s") % label);
+              GR_LOG_DEBUG(d_logger, "service component label");
               break;
             case FIB_SI_EXTENSION_DATA_SERVICE_LABEL:
-              memcpy(label, &data[5], 16);
-              GR_LOG_DEBUG(d_logger, format("[data service label]: %s") % label);
+              GR_LOG_DEBUG(d_logger, "data service label");
               break;
             default:
-              GR_LOG_DEBUG(d_logger, format("[unknown extension (%d)") % (int) extension);
+              GR_LOG_DEBUG(d_logger, "unknown label extension");
               break;
           }
           break;
         }
+        case FIB_FIG_TYPE_LABEL2:
+          GR_LOG_DEBUG(d_logger, "FIG type 2 labels not supported yet");
+          break;
         case FIB_FIG_TYPE_FIDC:
-          GR_LOG_DEBUG(d_logger, "FIG type 5");
           extension = (uint8_t)(data[1] & 0x07);
           switch (extension) {
             case FIB_FIDC_EXTENSION_PAGING:
@@ -408,7 +320,7 @@ namespace gr {
               GR_LOG_DEBUG(d_logger, "EWS (emergency warning service) - not supported yet");
               break;
             default:
-              GR_LOG_DEBUG(d_logger, format("unsupported extension (%d)") % (int) extension);
+              GR_LOG_DEBUG(d_logger, "unsupported extension");
           }
           break;
         case FIB_FIG_TYPE_CA:
@@ -420,18 +332,62 @@ namespace gr {
       }
     }
 
+    void
+    fib_sink_vb_impl::publish(const char *what, pmt::pmt_t change) {
+      change = pmt::dict_add(change, pmt::mp("type"), pmt::mp(what));
+      change = pmt::dict_add(change, pmt::mp("version"), pmt::from_long(d_db.version()));
+      change = pmt::dict_add(change, pmt::mp("complete"), pmt::from_bool(d_db.complete()));
+      message_port_pub(d_port, change);
+    }
+
+    std::string
+    fib_sink_vb_impl::get_ensemble_info() {
+      gr::thread::scoped_lock guard(d_setlock);
+      return d_db.ensemble_json();
+    }
+
+    std::string
+    fib_sink_vb_impl::get_service_info() {
+      gr::thread::scoped_lock guard(d_setlock);
+      return d_db.service_json();
+    }
+
+    std::string
+    fib_sink_vb_impl::get_service_labels() {
+      gr::thread::scoped_lock guard(d_setlock);
+      return d_db.service_labels_json();
+    }
+
+    std::string
+    fib_sink_vb_impl::get_subch_info() {
+      gr::thread::scoped_lock guard(d_setlock);
+      return d_db.subchannel_json();
+    }
+
+    std::string
+    fib_sink_vb_impl::get_programme_type() {
+      gr::thread::scoped_lock guard(d_setlock);
+      return d_db.programme_type_json();
+    }
+
+    unsigned int
+    fib_sink_vb_impl::get_version() {
+      gr::thread::scoped_lock guard(d_setlock);
+      return d_db.version();
+    }
+
     int
     fib_sink_vb_impl::work(int noutput_items,
                            gr_vector_const_void_star &input_items,
                            gr_vector_void_star &output_items) {
       const char *in = (const char *) input_items[0];
 
+      gr::thread::scoped_lock guard(d_setlock);
       for (int i = 0; i < noutput_items; i++) {
         process_fib(in);
         in += 32;
       }
 
-
       return noutput_items;
     }
   }
@@ -22,13 +22,17 @@
 #define INCLUDED_DAB_FIB_SINK_VB_IMPL_H
 
 #include <dab/fib_sink_vb.h>
+#include "crc16.h"
+#include "ensemble_database.h"
 
 namespace gr {
   namespace dab {
 /*! \brief sink for DAB/DAB+ FIBs, interprets MSC and SI
  * CRC16 check of incoming fibs.
  * Reads correct fibs.
- * Generates json objects with service and multiplex information.
+ * Keeps the multiplex configuration and service information in an ensemble_database,
+ * publishes each change on the message port "ensemble" and
+ * generates json objects with service and multiplex information on request.
  */
     class fib_sink_vb_impl : public fib_sink_vb {
 
@@ -42,46 +46,37 @@ namespace gr {
        */
       int process_fib(const char *fib);
       /*! \brief Processes a FIG.
-       * Switch between FIG types, extract information and write it to logger.
-       * Write and collect information in JSON objects for transport to GUI.
+       * Switch between FIG types, extract information and update the ensemble database.
        * @param type Type of the FIG. See ETSI EN 300 401 chapter 5.2.2.
        * @param data Pointer to the FIG data buffer.
        * @param length Length of the FIG data buffer in bytes.
        */
       void process_fig(uint8_t type, const char *data, uint8_t length);
+      /*! \brief Publishes a change of the ensemble database.
+       * @param what Name of the changed entry, e.g. "subchannel".
+       * @param change Dictionary with the new values of the entry.
+       */
+      void publish(const char *what, pmt::pmt_t change);
 
       bool d_crc_passed;
-
-      std::string d_json_ensemble_info;
-      // service info
-      std::string d_json_service_info;
-      std::string d_service_info_current;
-      int d_service_info_written_trigger;
-      // service labels
-      std::string d_json_service_labels;
-      std::string d_service_labels_current;
-      int d_service_labels_written_trigger;
-      // service subch
-      std::string d_json_subch_info;
-      std::string d_subch_info_current;
-      int d_subch_info_written_trigger;
-      // programme type
-      std::string d_json_programme_type;
-      std::string d_programme_type_current;
-      int d_programme_type_written_trigger;
+      crc16 d_crc16;
+      ensemble_database d_db;
+      const pmt::pmt_t d_port;
 
     public:
       fib_sink_vb_impl();
 
-      virtual std::string get_ensemble_info() { return d_json_ensemble_info; }
+      virtual std::string get_ensemble_info();
+
+      virtual std::string get_service_info();
 
-      virtual std::string get_service_info() { return d_json_service_info; }
+      virtual std::string get_service_labels();
 
-      virtual std::string get_service_labels() { return d_json_service_labels; }
+      virtual std::string get_subch_info();
 
-      virtual std::string get_subch_info() { return d_json_subch_info; }
+      virtual std::string get_programme_type();
 
-      virtual std::string get_programme_type() { return d_json_programme_type; }
+      virtual unsigned int get_version();
 
       virtual bool get_crc_passed() { return d_crc_passed; }
 
@@ -0,0 +1,238 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+#include "fic_decode_vb_impl.h"
+#include "channel_coding.h"
+#include "crc16.h"
+#include "FIC.h"
+
+namespace gr {
+  namespace dab {
+
+    fic_decode_vb::sptr
+    fic_decode_vb::make(int transmission_mode, int duty_cycle) {
+      return gnuradio::get_initial_sptr
+              (new fic_decode_vb_impl(transmission_mode, duty_cycle));
+    }
+
+    namespace {
+      // carriers, FIC symbols per frame and CIFs per frame of the transmission modes I to IV
+      const unsigned int SYMBOL_LENGTH[4] = {1536, 384, 192, 768};
+      const unsigned int NUM_FIC_SYMS[4] = {3, 3, 8, 3};
+      const unsigned int NUM_CIFS[4] = {4, 1, 1, 2};
+      // CIFs (24 ms each) without change until the low power mode starts, about 10 s
+      const unsigned int STABLE_CIFS = 417;
+      // consecutive FIBs with CRC errors that end the low power mode
+      const unsigned int CRC_ERROR_STREAK = 3;
+      // the CIF counter of FIG 0/0 counts modulo 20 * 250
+      const int CIF_COUNT_MODULO = 5000;
+
+      int
+      mode_index(int transmission_mode) {
+        if (transmission_mode < 1 || transmission_mode > 4)
+          throw std::invalid_argument((boost::format("Transmission mode %d doesn't exist")
+                                       % transmission_mode).str());
+        return transmission_mode - 1;
+      }
+    }
+
+    /*
+     * The private constructor
+     */
+    fic_decode_vb_impl::fic_decode_vb_impl(int transmission_mode, int duty_cycle)
+            : gr::block("fic_decode_vb",
+                        gr::io_signature::make(1, 1, sizeof(gr_complex) *
+                                                     SYMBOL_LENGTH[mode_index(transmission_mode)]),
+                        gr::io_signature::make(1, 1, sizeof(unsigned char) * FIB_LENGTH)),
+              d_symbol_length(SYMBOL_LENGTH[transmission_mode - 1]),
+              d_num_fic_syms(NUM_FIC_SYMS[transmission_mode - 1]),
+              d_num_codewords(NUM_CIFS[transmission_mode - 1]),
+              d_crc_passed(false),
+              d_viterbi((fic_puncturing_vector(transmission_mode).size() - 24) / 4,
+                        fic_puncturing_vector(transmission_mode)),
+              d_port(pmt::mp("fib")),
+              d_duty_cycle(duty_cycle),
+              d_duty_cycling(false),
+              d_stable_cifs(0),
+              d_ensemble_complete(false),
+              d_crc_errors(0),
+              d_frame_index(0),
+              d_has_cif_count(false),
+              d_cif_count(0),
+              d_cif_count_frame(0) {
+      if (duty_cycle < 1)
+        throw std::invalid_argument((boost::format("Duty cycle %d must be at least 1") % duty_cycle).str());
+      d_fibs_per_codeword = d_viterbi.length() / (8 * FIB_LENGTH);
+      d_num_fibs = d_num_codewords * d_fibs_per_codeword;
+      d_soft.resize(2 * d_symbol_length * d_num_fic_syms);
+      d_bits.resize(d_viterbi.length());
+      d_fibs.resize(d_num_fibs * FIB_LENGTH);
+      d_prbs = energy_dispersal_prbs(d_viterbi.length());
+
+      message_port_register_out(d_port);
+      message_port_register_in(pmt::mp("ensemble"));
+      set_msg_handler(pmt::mp("ensemble"), boost::bind(&fic_decode_vb_impl::handle_ensemble_change, this, _1));
+      set_output_multiple(d_num_fibs);
+      set_relative_rate((double) d_num_fibs / d_num_fic_syms);
+      set_tag_propagation_policy(TPP_DONT);
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    fic_decode_vb_impl::~fic_decode_vb_impl() {
+    }
+
+    void
+    fic_decode_vb_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required) {
+      ninput_items_required[0] = (noutput_items / d_num_fibs) * d_num_fic_syms;
+    }
+
+    void
+    fic_decode_vb_impl::decode_frame(const gr_complex *in) {
+      // soft bits of a symbol: real parts of all carriers, then imaginary parts
+      float *soft = &d_soft[0];
+      for (unsigned int s = 0; s < d_num_fic_syms; s++) {
+        for (unsigned int j = 0; j < d_symbol_length; j++) {
+          soft[j] = in[j].real();
+          soft[j + d_symbol_length] = in[j].imag();
+        }
+        in += d_symbol_length;
+        soft += 2 * d_symbol_length;
+      }
+      // one punctured codeword per CIF, packed and descrambled to FIBs
+      const unsigned int codeword_bytes = d_fibs_per_codeword * FIB_LENGTH;
+      for (unsigned int c = 0; c < d_num_codewords; c++) {
+        d_viterbi.decode(&d_soft[c * d_viterbi.input_length()], &d_bits[0]);
+        unsigned char *out = &d_fibs[c * codeword_bytes];
+        for (unsigned int i = 0; i < codeword_bytes; i++) {
+          const unsigned char *b = &d_bits[8 * i];
+          out[i] = (unsigned char) (((b[0] << 7) | (b[1] << 6) | (b[2] << 5) | (b[3] << 4) |
+                                     (b[4] << 3) | (b[5] << 2) | (b[6] << 1) | b[7]) ^ d_prbs[i]);
+        }
+      }
+    }
+
+    void
+    fic_decode_vb_impl::restart_full_rate(const char *reason) {
+      if (d_duty_cycling)
+        GR_LOG_DEBUG(d_logger, boost::format("full rate FIC decoding: %s") % reason);
+      d_duty_cycling = false;
+      d_stable_cifs = 0;
+    }
+
+    void
+    fic_decode_vb_impl::check_ensemble_info(const unsigned char *fib) {
+      unsigned int pos = 0;
+      while (pos < FIB_LENGTH - FIB_CRC_LENGTH && fib[pos] != FIB_ENDMARKER && fib[pos] != 0) {
+        const unsigned int type = fib[pos] >> 5;
+        const unsigned int length = fib[pos] & 0x1f;
+        if (pos + length >= FIB_LENGTH - FIB_CRC_LENGTH)
+          return;
+        if (type == FIB_FIG_TYPE_MCI && length >= 5 &&
+            (fib[pos + 1] & 0x1f) == FIB_MCI_EXTENSION_ENSEMBLE_INFO) {
+          const unsigned char *data = &fib[pos];
+          if ((data[4] & 0xc0) != 0)
+            restart_full_rate("reconfiguration signalled");
+          const int cif_count = (data[4] & 0x1f) * 250 + data[5];
+          if (d_has_cif_count) {
+            // the FIG may be in any CIF of the frame
+            const int expected = (int) ((d_cif_count + (d_frame_index - d_cif_count_frame) * d_num_codewords)
+                                        % CIF_COUNT_MODULO);
+            int diff = (cif_count - expected + CIF_COUNT_MODULO) % CIF_COUNT_MODULO;
+            if (diff > CIF_COUNT_MODULO / 2)
+              diff -= CIF_COUNT_MODULO;
+            if (diff >= (int) d_num_codewords || -diff >= (int) d_num_codewords)
+              restart_full_rate("CIF counter discontinuity");
+          }
+          d_has_cif_count = true;
+          d_cif_count = cif_count;
+          d_cif_count_frame = d_frame_index;
+        }
+        pos += length + 1;
+      }
+    }
+
+    void
+    fic_decode_vb_impl::handle_ensemble_change(pmt::pmt_t msg) {
+      // fib_sink_vb reports with every change whether the database is complete
+      d_ensemble_complete = pmt::is_dict(msg) &&
+                            pmt::to_bool(pmt::dict_ref(msg, pmt::mp("complete"), pmt::PMT_F));
+      restart_full_rate("ensemble database changed");
+    }
+
+    int
+    fic_decode_vb_impl::general_work(int noutput_items,
+                                     gr_vector_int &ninput_items,
+                                     gr_vector_const_void_star &input_items,
+                                     gr_vector_void_star &output_items) {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      unsigned char *out = (unsigned char *) output_items[0];
+      int nwritten = 0;
+
+      int num_frames = std::min(noutput_items / (int) d_num_fibs, ninput_items[0] / (int) d_num_fic_syms);
+      for (int f = 0; f < num_frames; f++, d_frame_index++, in += d_num_fic_syms * d_symbol_length) {
+        // low power mode: skip the frame without decoding it
+        if (d_duty_cycling && d_frame_index % d_duty_cycle != 0)
+          continue;
+        decode_frame(in);
+        for (unsigned int i = 0; i < d_num_fibs; i++) {
+          const unsigned char *fib = &d_fibs[i * FIB_LENGTH];
+          d_crc_passed = d_crc16.check(fib, FIB_LENGTH - FIB_CRC_LENGTH);
+          if (!d_crc_passed) {
+            GR_LOG_DEBUG(d_logger, "FIB CRC error");
+            if (++d_crc_errors >= CRC_ERROR_STREAK)
+              restart_full_rate("CRC errors");
+            continue;
+          }
+          d_crc_errors = 0;
+          if (d_duty_cycle > 1)
+            check_ensemble_info(fib);
+          memcpy(&out[nwritten++ * FIB_LENGTH], fib, FIB_LENGTH);
+          message_port_pub(d_port, pmt::cons(pmt::PMT_NIL, pmt::init_u8vector(FIB_LENGTH, fib)));
+        }
+        if (d_duty_cycle > 1 && !d_duty_cycling) {
+          if (d_stable_cifs < STABLE_CIFS)
+            d_stable_cifs += d_num_codewords;
+          if (d_stable_cifs >= STABLE_CIFS && d_ensemble_complete) {
+            GR_LOG_DEBUG(d_logger, boost::format("stable configuration, decoding every %d. FIC") % d_duty_cycle);
+            d_duty_cycling = true;
+          }
+        }
+      }
+      // Tell runtime system how many input items we consumed on
+      // each input stream.
+      consume_each(num_frames * d_num_fic_syms);
+
+      // Tell runtime system how many output items we produced.
+      return nwritten;
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
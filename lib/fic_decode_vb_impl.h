@@ -0,0 +1,98 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_FIC_DECODE_VB_IMPL_H
+#define INCLUDED_DAB_FIC_DECODE_VB_IMPL_H
+
+#include <dab/fic_decode_vb.h>
+#include "viterbi_decoder.h"
+#include "crc16.h"
+
+namespace gr {
+  namespace dab {
+/*! \brief Decodes the FIC of one transmission frame per call.
+ *
+ * The FIC symbols of a frame are split into the soft bits of the
+ * punctured codewords (one per CIF), each codeword is decoded to 3
+ * (mode III: 4) FIBs and every FIB is CRC checked. In the low power mode
+ * only every duty_cycle-th frame is decoded.
+ *
+ * @param transmission_mode DAB transmission mode (1 to 4).
+ * @param duty_cycle Frame decimation in the low power mode.
+ */
+    class fic_decode_vb_impl : public fic_decode_vb {
+    private:
+      unsigned int d_symbol_length;
+      unsigned int d_num_fic_syms;
+      unsigned int d_num_codewords;
+      unsigned int d_fibs_per_codeword;
+      unsigned int d_num_fibs;
+      bool d_crc_passed;
+      crc16 d_crc16;
+      viterbi_decoder d_viterbi;
+      std::vector<float> d_soft;
+      std::vector<unsigned char> d_bits;
+      std::vector<unsigned char> d_fibs;
+      std::vector<unsigned char> d_prbs;
+      pmt::pmt_t d_port;
+
+      // low power mode
+      unsigned int d_duty_cycle;
+      bool d_duty_cycling;
+      unsigned int d_stable_cifs;
+      bool d_ensemble_complete;
+      unsigned int d_crc_errors;
+      uint64_t d_frame_index;
+      bool d_has_cif_count;
+      int d_cif_count;
+      uint64_t d_cif_count_frame;
+
+      void decode_frame(const gr_complex *in);
+
+      /*! Returns to full rate decoding and restarts the wait for a stable configuration. */
+      void restart_full_rate(const char *reason);
+
+      /*! Checks the change flags and the CIF counter of the FIG 0/0 in a FIB, if present. */
+      void check_ensemble_info(const unsigned char *fib);
+
+      void handle_ensemble_change(pmt::pmt_t msg);
+
+    public:
+      fic_decode_vb_impl(int transmission_mode, int duty_cycle);
+
+      ~fic_decode_vb_impl();
+
+      virtual bool get_crc_passed() { return d_crc_passed; }
+
+      virtual bool get_duty_cycling() { return d_duty_cycling; }
+
+      // Where all the action really happens
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_FIC_DECODE_VB_IMPL_H */
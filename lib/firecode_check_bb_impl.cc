@@ -39,19 +39,31 @@ namespace gr {
   namespace dab {
 
     firecode_check_bb::sptr
-    firecode_check_bb::make(int bit_rate_n) {
-      return gnuradio::get_initial_sptr(new firecode_check_bb_impl(bit_rate_n));
+    firecode_check_bb::make(int bit_rate_n, int max_misses) {
+      return gnuradio::get_initial_sptr(new firecode_check_bb_impl(bit_rate_n, max_misses));
     }
 
     /*
      * The private constructor
      */
-    firecode_check_bb_impl::firecode_check_bb_impl(int bit_rate_n)
+    firecode_check_bb_impl::firecode_check_bb_impl(int bit_rate_n, int max_misses)
             : gr::block("firecode_check_bb",
                         gr::io_signature::make(1, 1, sizeof(unsigned char)),
-                        gr::io_signature::make(1, 1, sizeof(unsigned char))) {
-      d_frame_size = 24 * bit_rate_n;
-      set_output_multiple(d_frame_size * 5); //logical frame
+                        gr::io_signature::make(1, 1, sizeof(unsigned char))),
+              d_frame_size(24 * bit_rate_n),
+              d_max_misses(max_misses),
+              d_state(ACQUISITION),
+              d_misses(0),
+              d_firecode_passed(false),
+              d_superframe_start_key(pmt::intern("superframe_start")),
+              d_bit_rate_n_key(pmt::intern("bit_rate_n")),
+              d_reconfigured_at(~(uint64_t) 0) {
+      if (bit_rate_n <= 0 || max_misses < 0) {
+        throw std::invalid_argument((boost::format("invalid bit_rate_n %d or max_misses %d")
+                                     % bit_rate_n % max_misses).str());
+      }
+      set_output_multiple(d_frame_size * 5); //superframe
+      set_tag_propagation_policy(TPP_DONT);
     }
 
     /*
@@ -65,6 +77,23 @@ namespace gr {
       ninput_items_required[0] = noutput_items;
     }
 
+    void
+    firecode_check_bb_impl::reconfigure(const gr::tag_t &tag) {
+      const int bit_rate_n = pmt::to_long(tag.value);
+      d_reconfigured_at = tag.offset;
+      if (bit_rate_n <= 0) {
+        GR_LOG_ERROR(d_logger, format("ignoring invalid bit_rate_n %d") % bit_rate_n);
+        return;
+      }
+      GR_LOG_DEBUG(d_logger, format("new sub-channel with bit_rate_n %d") % bit_rate_n);
+      d_frame_size = 24 * bit_rate_n;
+      d_state = ACQUISITION;
+      d_misses = 0;
+      d_firecode_passed = false;
+      set_output_multiple(d_frame_size * 5);
+      add_item_tag(0, nitems_written(0), d_bit_rate_n_key, tag.value);
+    }
+
     int
     firecode_check_bb_impl::general_work(int noutput_items,
                                          gr_vector_int &ninput_items,
@@ -72,28 +101,69 @@ namespace gr {
                                          gr_vector_void_star &output_items) {
       const unsigned char *in = (const unsigned char *) input_items[0];
       unsigned char *out = (unsigned char *) output_items[0];
-      d_nproduced = 0;
-      d_nconsumed = 0;
+      const uint64_t nread = nitems_read(0);
+      int ninput = ninput_items[0];
 
-      while (d_nconsumed < noutput_items / d_frame_size - 4) {
-        if (fc.check(&in[d_nconsumed * d_frame_size])) {
-          // fire code OK, copy superframe to output
-          memcpy(out + d_nproduced * d_frame_size, in + d_nconsumed * d_frame_size, d_frame_size * 5);
-          d_nproduced += 5;
-          d_nconsumed += 5;
-          d_firecode_passed = true;
+      // a retuned sub-channel starts at a "bit_rate_n" tag, only the frames before it are of the old one
+      std::vector<gr::tag_t> tags;
+      bool retune = false;
+      get_tags_in_window(tags, 0, 0, ninput_items[0], d_bit_rate_n_key);
+      for (unsigned int i = 0; i < tags.size(); i++) {
+        if (tags[i].offset == d_reconfigured_at)
+          continue;
+        if (tags[i].offset == nread) {
+          reconfigure(tags[i]);
         } else {
-          GR_LOG_DEBUG(d_logger, format("fire code failed at frame %d") % (nitems_read(0) / d_frame_size));
-          // shift of one logical frame
-          d_nconsumed++;
-          d_firecode_passed = false;
+          ninput = tags[i].offset - nread;
+          retune = true;
+          break;
+        }
+      }
+
+      const int frames_in = ninput / d_frame_size;
+      const int frames_out = noutput_items / d_frame_size;
+      int nconsumed = 0;
+      int nproduced = 0;
+
+      while (nconsumed + 5 <= frames_in && nproduced + 5 <= frames_out) {
+        bool passed = fc.check(&in[nconsumed * d_frame_size]);
+        d_firecode_passed = passed;
+        if (d_state == ACQUISITION) {
+          if (!passed) {
+            // shift of one logical frame
+            nconsumed++;
+            continue;
+          }
+          GR_LOG_DEBUG(d_logger, format("superframe sync acquired at frame %d")
+                                 % (nitems_read(0) / d_frame_size + nconsumed));
+          d_state = TRACKING;
+          d_misses = 0;
+        } else if (passed) {
+          d_misses = 0;
+        } else if (++d_misses > d_max_misses) {
+          GR_LOG_DEBUG(d_logger, format("superframe sync lost at frame %d")
+                                 % (nitems_read(0) / d_frame_size + nconsumed));
+          d_state = ACQUISITION;
+          nconsumed++;
+          continue;
         }
+        // copy superframe to output
+        add_item_tag(0, nitems_written(0) + nproduced * d_frame_size, d_superframe_start_key,
+                     pmt::from_bool(passed));
+        memcpy(out + nproduced * d_frame_size, in + nconsumed * d_frame_size, d_frame_size * 5);
+        nproduced += 5;
+        nconsumed += 5;
+      }
+      if (retune && nconsumed + 5 > frames_in) {
+        // no complete superframe of the old sub-channel left, drop the rest
+        consume_each(ninput);
+        return nproduced * d_frame_size;
       }
       // Tell runtime system how many input items we consumed on
       // each input stream.
-      consume_each(d_nconsumed * d_frame_size);
+      consume_each(nconsumed * d_frame_size);
       // Tell runtime system how many output items we produced.
-      return d_nproduced * d_frame_size;
+      return nproduced * d_frame_size;
     }
 
   } /* namespace dab */
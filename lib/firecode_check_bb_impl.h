@@ -27,26 +27,41 @@
 
 namespace gr {
   namespace dab {
-/*! \brief checks firecode of logical frames
- * Checks firecode of each logical frame as a qa test for the msc_decoder.
+/*! \brief superframe synchronization with the fire code
  * According to ETSI TS 102 563 every fifth logical frame starts with a 16 bit firecode word.
+ * At a "bit_rate_n" tag (a retuned msc_decode_vcb) the frames of the old sub-channel that do
+ * not fill a superframe are dropped and the acquisition starts over with the new frame size.
  * @param bit_rate_n data rate in multiples of 8kbit/s
+ * @param max_misses number of consecutive failed fire codes that are tolerated in tracking
  */
     class firecode_check_bb_impl : public firecode_check_bb {
     private:
-      int d_bit_rate_n; /*!< Byte rate. */
-      int d_frame_size; /*!< Size in bytes of one transmission frame (depending on bit_rate_n).*/
-      int d_nproduced, d_nconsumed; /*!< Control variable for buffer read/write operations. */
+      enum sync_state {
+        ACQUISITION, /*!< search the fire code at each logical frame */
+        TRACKING /*!< check the fire code only at the expected superframe start */
+      };
+
+      int d_frame_size; /*!< Size in bytes of one logical frame (depending on bit_rate_n).*/
+      int d_max_misses;
+      sync_state d_state;
+      int d_misses; /*!< Number of consecutive failed fire codes in tracking. */
       bool d_firecode_passed; /*!< Boolean variable for displaying firecode fails. */
       firecode_checker fc; /*!< Instance of the class firecode_checker. */
+      pmt::pmt_t d_superframe_start_key;
+      pmt::pmt_t d_bit_rate_n_key;
+      uint64_t d_reconfigured_at; /*!< Offset of the last "bit_rate_n" tag that was applied. */
+
+      void reconfigure(const gr::tag_t &tag);
 
     public:
-      firecode_check_bb_impl(int bit_rate_n);
+      firecode_check_bb_impl(int bit_rate_n, int max_misses);
 
       ~firecode_check_bb_impl();
 
       virtual bool get_firecode_passed() { return d_firecode_passed; }
 
+      virtual bool get_synced() { return d_state == TRACKING; }
+
       // Where all the action really happens
       void forecast(int noutput_items, gr_vector_int &ninput_items_required);
 
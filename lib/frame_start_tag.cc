@@ -0,0 +1,40 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "frame_start_tag.h"
+
+namespace gr {
+  namespace dab {
+
+    pmt::pmt_t
+    frame_start_tag_value(float phase, const std::vector<unsigned char> &symbol_mask) {
+      return pmt::cons(pmt::from_float(phase), pmt::init_u8vector(symbol_mask.size(), symbol_mask));
+    }
+
+    bool
+    frame_start_tag_mask(const pmt::pmt_t &value, std::vector<unsigned char> &symbol_mask) {
+      if (!pmt::is_pair(value) || !pmt::is_u8vector(pmt::cdr(value)))
+        return false;
+      symbol_mask = pmt::u8vector_elements(pmt::cdr(value));
+      return true;
+    }
+
+  }
+}
@@ -0,0 +1,51 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_FRAME_START_TAG_H
+#define INCLUDED_DAB_FRAME_START_TAG_H
+
+#include <pmt/pmt.h>
+#include <vector>
+
+/*
+ * Value of the "Start" tag that ofdm_synchronization_cvf puts on the phase reference
+ * symbol of each frame: a pair of the phase of the fixed lag correlation (float)
+ * and the symbol mask the frame was written with (u8vector, empty for all symbols).
+ * The demux blocks apply exactly this mask to the frame, so a new mask can not
+ * reach frames which are already buffered between the synchronization and the demux.
+ */
+
+namespace gr {
+  namespace dab {
+
+    /*! \brief Value of the "Start" tag of a frame which was written with symbol_mask. */
+    pmt::pmt_t frame_start_tag_value(float phase, const std::vector<unsigned char> &symbol_mask);
+
+    /*! \brief Reads the symbol mask out of the value of a "Start" tag.
+     *
+     * @return False if the tag carries no symbol mask (e.g. a tag with only the phase),
+     * symbol_mask is unchanged then.
+     */
+    bool frame_start_tag_mask(const pmt::pmt_t &value, std::vector<unsigned char> &symbol_mask);
+
+  }
+}
+
+#endif /* INCLUDED_DAB_FRAME_START_TAG_H */
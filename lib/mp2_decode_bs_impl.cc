@@ -36,8 +36,10 @@
 #include "config.h"
 #endif
 
+#include <algorithm>
 #include <stdexcept>
 #include <stdio.h>
+#include <string.h>
 #include <sstream>
 #include <boost/format.hpp>
 #include <gnuradio/io_signature.h>
@@ -224,20 +226,25 @@ namespace gr {
 
 
     mp2_decode_bs::sptr
-    mp2_decode_bs::make(int bit_rate_n) {
+    mp2_decode_bs::make(int bit_rate_n, bool fixed_point, bool packed) {
       return gnuradio::get_initial_sptr
-              (new mp2_decode_bs_impl(bit_rate_n));
+              (new mp2_decode_bs_impl(bit_rate_n, fixed_point, packed));
     }
 
     /*
      * The private constructor
      */
-    mp2_decode_bs_impl::mp2_decode_bs_impl(int bit_rate_n)
+    mp2_decode_bs_impl::mp2_decode_bs_impl(int bit_rate_n, bool fixed_point, bool packed)
             : gr::block("mp2_decode_bs",
                         gr::io_signature::make(1, 1, sizeof(unsigned char)),
-                        gr::io_signature::make(2, 2,
-                                               sizeof(int16_t))), /* output is always stereo*/
-              d_bit_rate_n(bit_rate_n) {
+                        gr::io_signature::make4(2, 4, sizeof(int16_t), sizeof(int16_t),
+                                                sizeof(float), sizeof(float))), /* output is always stereo*/
+              d_bit_rate_n(bit_rate_n),
+              d_fixed_point(fixed_point),
+              d_synthesis(2, mp2_synthesis_filterbank(D)),
+              d_packed(packed),
+              d_bit_offset(0),
+              d_bit_rate_n_key(pmt::intern("bit_rate_n")) {
       d_bit_rate = d_bit_rate_n * 8;
 
       int16_t i, j;
@@ -258,7 +265,9 @@ namespace gr {
       d_V_offs = 0;
       d_baud_rate = 48000;  // default for DAB
       d_mp2_framesize = 24 * d_bit_rate;  // framesize in unpacked bits!!!
-      d_mp2_frame = new uint8_t[2 * d_mp2_framesize];
+      d_mp2_frame = new uint8_t[std::max(2 * (int) d_mp2_framesize, KJMP2_MAX_FRAME_SIZE)];
+      if (d_packed)
+        d_mp2_framesize /= 8;  // packed input: framesize in bytes
       d_mp2_header_OK = 0;
       d_mp2_header_count = 0;
       d_mp2_bit_count = 0;
@@ -288,7 +297,7 @@ namespace gr {
       d_baud_rate = rate;
     }
 
-    int32_t mp2_decode_bs_impl::mp2_samplerate(uint8_t *frame) {
+    int32_t mp2_decode_bs_impl::mp2_samplerate(const uint8_t *frame) {
       if (!frame)
         return 0;
       if ((frame[0] != 0xFF)   // no valid syncword?
@@ -301,6 +310,79 @@ namespace gr {
       return d_sample_rate;
     }
 
+    int32_t mp2_decode_bs_impl::mp2_frame_size(const uint8_t *frame) {
+      if ((frame[0] != 0xFF)   // no valid syncword?
+          || ((frame[1] & 0xF6) != 0xF4)   // no MPEG-1/2 Audio Layer II?
+          || ((uint8_t) (frame[2] - 0x10) >= 0xE0))  // invalid or free format bitrate?
+        return 0;
+      int32_t bit_rate_index_minus1 = (frame[2] >> 4) - 1;
+      int32_t sampling_frequency = (frame[2] >> 2) & 3;
+      if (sampling_frequency == 3)
+        return 0;
+      if ((frame[1] & 0x08) == 0) {  // MPEG-2
+        sampling_frequency += 4;
+        bit_rate_index_minus1 += 14;
+      }
+      return 144000 * bitrates[bit_rate_index_minus1] / sample_rates[sampling_frequency]
+             + ((frame[2] >> 1) & 1);
+    }
+
+    int32_t mp2_decode_bs_impl::find_sync(const uint8_t *in, int32_t length) {
+      const uint64_t ones = 0x0101010101010101ULL;
+      const uint64_t highs = 0x8080808080808080ULL;
+      int32_t i = 0;
+      // a header starts with the byte 0xFF, skip all 8 byte words which do not contain one
+      for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, in + i, sizeof(word));
+        word = ~word;
+        if ((word - ones) & ~word & highs) {
+          for (int32_t k = i; k < i + 8 && k + 3 <= length; k++)
+            if (mp2_frame_size(in + k))
+              return k;
+        }
+      }
+      for (; i + 3 <= length; i++)
+        if (mp2_frame_size(in + i))
+          return i;
+      return -1;
+    }
+
+    int32_t mp2_decode_bs_impl::find_sync_bitwise(const uint8_t *in, int32_t length, int32_t first_bit) {
+      uint8_t header[3];
+      for (int32_t bit = first_bit; bit / 8 + 4 <= length; bit++) {
+        const int32_t i = bit / 8, b = bit & 7;
+        if (b == 0)
+          continue;
+        for (int k = 0; k < 3; k++)
+          header[k] = (uint8_t) ((in[i + k] << b) | (in[i + k + 1] >> (8 - b)));
+        int32_t frame_size = mp2_frame_size(header);
+        if (frame_size > 0 && frame_size <= KJMP2_MAX_FRAME_SIZE)
+          return bit;
+      }
+      return -1;
+    }
+
+    bool mp2_decode_bs_impl::sync_bitwise(const uint8_t *in, int32_t &pos, int32_t ninput_items, int32_t first_bit) {
+      int32_t bit = find_sync_bitwise(&in[pos], ninput_items - pos, first_bit);
+      if (bit < 0) {
+        d_bit_offset = 0;
+        pos = ninput_items - 3;  // a header may start in the last 3 bytes
+        return false;
+      }
+      GR_LOG_DEBUG(d_logger, format("mp2 resync at bit offset %d, skipped %d bytes") % (bit & 7) % (bit / 8));
+      pos += bit / 8;
+      d_bit_offset = bit & 7;
+      return true;
+    }
+
+    void mp2_decode_bs_impl::assemble_frame(const uint8_t *in, int bit_offset, int32_t nbytes) {
+      for (int16_t n = 0; n < 8 * nbytes; n++) {
+        int32_t bit = bit_offset + n;
+        add_bit_to_mp2(d_mp2_frame, (in[bit / 8] >> (7 - (bit & 7))) & 1, n);
+      }
+    }
+
     struct quantizer_spec *
     mp2_decode_bs_impl::read_allocation(int sb, int b2_table) {
       int table_idx = quant_lut_step3[b2_table][sb];
@@ -362,7 +444,10 @@ namespace gr {
       bit_window = (bit_window << bit_count) & 0xFFFFFF;
       bits_in_window -= bit_count;
       while (bits_in_window < 16) {
-        bit_window |= (*d_frame_pos++) << (16 - bits_in_window);
+        // read zeros behind the end of the frame (the frame may be read in place from the input buffer)
+        if (d_frame_pos < d_frame_end)
+          bit_window |= (*d_frame_pos) << (16 - bits_in_window);
+        d_frame_pos++;
         bits_in_window += 8;
       }
       return result;
@@ -372,7 +457,7 @@ namespace gr {
 // FRAME DECODE FUNCTION                                                      //
 ////////////////////////////////////////////////////////////////////////////////
 
-    int32_t mp2_decode_bs_impl::mp2_decode_frame(uint8_t *frame, int16_t *pcm) {
+    int32_t mp2_decode_bs_impl::mp2_decode_frame(const uint8_t *frame, int16_t *pcm, float *pcm_float) {
       uint32_t bit_rate_index_minus1;
       uint32_t sampling_frequency;
       uint32_t padding_bit;
@@ -398,6 +483,7 @@ namespace gr {
       }
 
       // set up the bitstream reader
+      d_frame_end = frame + mp2_frame_size(frame);
       bit_window = frame[2] << 16;
       bits_in_window = 8;
       d_frame_pos = &frame[3];
@@ -537,50 +623,73 @@ namespace gr {
               for (idx = 0; idx < 3; ++idx)
                 d_sample[ch][sb][idx] = 0;
 
-          // synthesis loop
-          for (idx = 0; idx < 3; ++idx) {
-            // shifting step
-            d_V_offs = table_idx = (d_V_offs - 64) & 1023;
-
-            for (ch = 0; ch < 2; ++ch) {
-              // matrixing
-              for (i = 0; i < 64; ++i) {
-                sum = 0;
-                for (j = 0; j < 32; ++j) // 8b*15b=23b
-                  sum += d_N[i][j] * d_sample[ch][j][idx];
-                // intermediate value is 28 bit (23 + 5), clamp to 14b
-                d_V[ch][table_idx + i] = (sum + 8192) >> 14;
-              }
+          if (d_fixed_point) {
+            // fixed-point synthesis loop
+            for (idx = 0; idx < 3; ++idx) {
+              // shifting step
+              d_V_offs = table_idx = (d_V_offs - 64) & 1023;
+
+              for (ch = 0; ch < 2; ++ch) {
+                // matrixing
+                for (i = 0; i < 64; ++i) {
+                  sum = 0;
+                  for (j = 0; j < 32; ++j) // 8b*15b=23b
+                    sum += d_N[i][j] * d_sample[ch][j][idx];
+                  // intermediate value is 28 bit (23 + 5), clamp to 14b
+                  d_V[ch][table_idx + i] = (sum + 8192) >> 14;
+                }
+
+                // construction of U
+                for (i = 0; i < 8; ++i)
+                  for (j = 0; j < 32; ++j) {
+                    d_U[(i << 6) + j]
+                            = d_V[ch][(table_idx + (i << 7) + j) & 1023];
+                    d_U[(i << 6) + j + 32] =
+                            d_V[ch][(table_idx + (i << 7) + j + 96) & 1023];
+                  }
+
+                // apply window
+                for (i = 0; i < 512; ++i)
+                  d_U[i] = (d_U[i] * D[i] + 32) >> 6;
 
-              // construction of U
-              for (i = 0; i < 8; ++i)
+                // output samples
                 for (j = 0; j < 32; ++j) {
-                  d_U[(i << 6) + j]
-                          = d_V[ch][(table_idx + (i << 7) + j) & 1023];
-                  d_U[(i << 6) + j + 32] =
-                          d_V[ch][(table_idx + (i << 7) + j + 96) & 1023];
+                  sum = 0;
+                  for (i = 0; i < 16; ++i)
+                    sum -= d_U[(i << 5) + j];
+                  sum = (sum + 8) >> 4;
+                  if (sum < -32768)
+                    sum = -32768;
+                  if (sum > 32767)
+                    sum = 32767;
+                  pcm[(idx << 6) | (j << 1) | ch] = (uint16_t) sum;
+                }
+              } // end of synthesis channel loop
+            } // end of synthesis sub-block loop
+          } else {
+            // float synthesis loop, read_samples() returns the samples with inverted sign
+            float subband[32];
+            float out[32];
+            for (idx = 0; idx < 3; ++idx) {
+              for (ch = 0; ch < 2; ++ch) {
+                for (sb = 0; sb < 32; ++sb)
+                  subband[sb] = d_sample[ch][sb][idx] * (-1.0f / 32768.0f);
+                d_synthesis[ch].synthesize(subband, out);
+                for (j = 0; j < 32; ++j) {
+                  sum = (int32_t) lrintf(out[j] * 32768.0f);
+                  if (sum < -32768)
+                    sum = -32768;
+                  if (sum > 32767)
+                    sum = 32767;
+                  pcm[(idx << 6) | (j << 1) | ch] = (int16_t) sum;
+                  pcm_float[(idx << 6) | (j << 1) | ch] = out[j];
                 }
-
-              // apply window
-              for (i = 0; i < 512; ++i)
-                d_U[i] = (d_U[i] * D[i] + 32) >> 6;
-
-              // output samples
-              for (j = 0; j < 32; ++j) {
-                sum = 0;
-                for (i = 0; i < 16; ++i)
-                  sum -= d_U[(i << 5) + j];
-                sum = (sum + 8) >> 4;
-                if (sum < -32768)
-                  sum = -32768;
-                if (sum > 32767)
-                  sum = 32767;
-                pcm[(idx << 6) | (j << 1) | ch] = (uint16_t) sum;
               }
-            } // end of synthesis channel loop
-          } // end of synthesis sub-block loop
+            }
+          }
           // adjust PCM output pointer: decoded 3 * 32 = 96 stereo samples
           pcm += 192;
+          pcm_float += 192;
         } // decoding of the granule finished
       }
       return frame_size;
@@ -598,11 +707,101 @@ namespace gr {
       v[nm / 8] = byte;
     }
 
+    void mp2_decode_bs_impl::write_frame(const int16_t *pcm, gr_vector_void_star &output_items) {
+      int16_t *out_left = (int16_t *) output_items[0];
+      int16_t *out_right = (int16_t *) output_items[1];
+      for (int n = 0; n < KJMP2_SAMPLES_PER_FRAME; n++) {
+        out_left[d_nproduced + n] = pcm[n * 2];
+        out_right[d_nproduced + n] = pcm[n * 2 + 1];
+      }
+      if (d_fixed_point) {
+        for (int n = 0; n < KJMP2_SAMPLES_PER_FRAME * 2; n++)
+          d_pcm_float[n] = pcm[n] * (1.0f / 32768.0f);
+      }
+      if (output_items.size() > 2) {
+        float *out_float_left = (float *) output_items[2];
+        for (int n = 0; n < KJMP2_SAMPLES_PER_FRAME; n++)
+          out_float_left[d_nproduced + n] = d_pcm_float[n * 2];
+      }
+      if (output_items.size() > 3) {
+        float *out_float_right = (float *) output_items[3];
+        for (int n = 0; n < KJMP2_SAMPLES_PER_FRAME; n++)
+          out_float_right[d_nproduced + n] = d_pcm_float[n * 2 + 1];
+      }
+      d_nproduced += KJMP2_SAMPLES_PER_FRAME;
+    }
+
+    int mp2_decode_bs_impl::decode_packed(int noutput_items, int ninput_items, bool last_frames, const uint8_t *in,
+                                          gr_vector_void_star &output_items) {
+      int16_t sample_buf[KJMP2_SAMPLES_PER_FRAME * 2];
+      int32_t pos = 0;
+
+      while (d_nproduced + KJMP2_SAMPLES_PER_FRAME <= noutput_items) {
+        if (pos + (d_bit_offset ? 4 : 3) > ninput_items)
+          break;  // wait for the rest of the header
+        const uint8_t *frame = &in[pos];
+        if (d_bit_offset) {
+          assemble_frame(&in[pos], d_bit_offset, 3);
+          frame = d_mp2_frame;
+        }
+        int32_t frame_size = mp2_frame_size(frame);
+        if (frame_size == 0 || frame_size > KJMP2_MAX_FRAME_SIZE) {
+          // no header where the next frame is expected, resync
+          d_bit_offset = 0;
+          int32_t offset = find_sync(&in[pos], ninput_items - pos);
+          if (offset >= 0) {
+            GR_LOG_DEBUG(d_logger, format("mp2 resync, skipped %d bytes") % offset);
+            pos += offset;
+            continue;
+          }
+          // no byte aligned header, fall back to the bitwise search of the unpacked input
+          if (!sync_bitwise(in, pos, ninput_items, 1))
+            break;
+          continue;
+        }
+        if (d_bit_offset) {
+          // the header of the next frame confirms the bit offset, the frame is assembled bit by bit
+          if (pos + frame_size + 4 > ninput_items)
+            break;  // wait for the rest of the frame and the next header
+          assemble_frame(&in[pos + frame_size], d_bit_offset, 3);
+          if (mp2_frame_size(d_mp2_frame) == 0) {
+            // no frame, continue the bitwise search behind this header
+            if (!sync_bitwise(in, pos, ninput_items, d_bit_offset + 1))
+              break;
+            continue;
+          }
+          assemble_frame(&in[pos], d_bit_offset, frame_size);
+        } else if (pos + frame_size > ninput_items) {
+          break;  // wait for the rest of the frame
+        }
+        set_samplerate(mp2_samplerate(frame));
+        // byte aligned frames are decoded in place
+        if (mp2_decode_frame(frame, sample_buf, d_pcm_float)) {
+          write_frame(sample_buf, output_items);
+          pos += frame_size;
+        } else {
+          GR_LOG_DEBUG(d_logger, "mp2 decoding failed");
+          pos++;
+        }
+      }
+      if (last_frames && d_nproduced + KJMP2_SAMPLES_PER_FRAME <= noutput_items)
+        pos = ninput_items;  // the rest can't be completed any more
+
+      consume_each(pos);
+      return d_nproduced;
+    }
+
     void
     mp2_decode_bs_impl::forecast(int noutput_items,
                                  gr_vector_int &ninput_items_required) {
-      ninput_items_required[0] =
-              noutput_items / d_output_size * d_mp2_framesize;
+      if (d_packed) {
+        // one frame per logical frame at 48 kHz, one per two logical frames at 24 kHz
+        ninput_items_required[0] = noutput_items / d_output_size * d_mp2_framesize
+                                   * (d_baud_rate == 48000 ? 1 : 2);
+      } else {
+        ninput_items_required[0] =
+                noutput_items / d_output_size * d_mp2_framesize;
+      }
     }
 
     int
@@ -611,17 +810,35 @@ namespace gr {
                                      gr_vector_const_void_star &input_items,
                                      gr_vector_void_star &output_items) {
       const unsigned char *in = (const unsigned char *) input_items[0]; // input are unpacked bytes
-      int16_t *out_left = (int16_t *) output_items[0];
-      int16_t *out_right = (int16_t *) output_items[1];
       d_nproduced = 0;
 
-      for (int logical_frame_count; logical_frame_count < noutput_items /
+      if (d_packed) {
+        // a retuned sub-channel (msc_decode_vcb) starts at a "bit_rate_n" tag
+        const uint64_t nread = nitems_read(0);
+        int ninput = ninput_items[0];
+        bool last_frames = false;
+        std::vector<gr::tag_t> tags;
+        get_tags_in_window(tags, 0, 0, ninput_items[0], d_bit_rate_n_key);
+        for (unsigned int i = 0; i < tags.size(); i++) {
+          if (tags[i].offset == nread) {
+            d_bit_rate_n = pmt::to_long(tags[i].value);
+            d_bit_rate = d_bit_rate_n * 8;
+            d_mp2_framesize = 3 * d_bit_rate;  // 24 ms in bytes
+            d_bit_offset = 0;
+          } else {
+            ninput = tags[i].offset - nread;
+            last_frames = true;
+            break;
+          }
+        }
+        return decode_packed(noutput_items, ninput, last_frames, in, output_items);
+      }
+
+      for (int logical_frame_count = 0; logical_frame_count < noutput_items /
                                                           d_output_size; logical_frame_count++) {
         int16_t i, j;
         int16_t lf =
                 d_baud_rate == 48000 ? d_mp2_framesize : 2 * d_mp2_framesize;
-        uint8_t help[24 * d_bit_rate_n];
-        int16_t vlength = 24 * d_bit_rate / 8;
 
         /* pad reading is not supported yet */
 
@@ -635,13 +852,9 @@ namespace gr {
               // prepare buffer for PCM stereo samples
               int16_t sample_buf[KJMP2_SAMPLES_PER_FRAME * 2];
               // decode mp2 frame and write it into buffer
-              if (mp2_decode_frame(d_mp2_frame, sample_buf)) {
+              if (mp2_decode_frame(d_mp2_frame, sample_buf, d_pcm_float)) {
                 // write successfully decoded data to output buffer
-                for (int n = 0; n < KJMP2_SAMPLES_PER_FRAME; n++) {
-                  out_left[d_nproduced + n] = sample_buf[n * 2];
-                  out_right[d_nproduced + n] = sample_buf[n * 2 + 1];
-                }
-                d_nproduced += KJMP2_SAMPLES_PER_FRAME;
+                write_frame(sample_buf, output_items);
                 GR_LOG_DEBUG(d_logger, "mp2 decoding succeeded");
               } else {
                 GR_LOG_DEBUG(d_logger, "mp2 decoding failed");
@@ -39,6 +39,8 @@
 #include  <stdio.h>
 #include  <stdint.h>
 #include  <math.h>
+#include  <vector>
+#include "mp2_synthesis_filterbank.h"
 //#include	"pad-handler.h"
 
 namespace gr {
@@ -49,6 +51,19 @@ namespace gr {
  * The block always produces a stereo output. The sampling rate is 48kHz.
  *
  * @param bit_rate_n data rate in multiples of 8kbit/s
+ * @param fixed_point use the fixed-point synthesis instead of mp2_synthesis_filterbank
+ * @param packed input are packed bytes instead of unpacked bits
+ *
+ * With unpacked input, the frames are assembled bit by bit after a bitwise search for
+ * the syncword. With packed input, the deframer uses that DAB audio frames are byte
+ * aligned: the syncword is searched a word at a time, and once a header is found the
+ * following frames are expected directly behind it. Complete frames are decoded in place
+ * out of the input buffer, only a missing header at the expected position starts a new search.
+ * If that search finds no byte aligned header, the bitwise search and frame assembly of the
+ * unpacked input serve as fallback: frames at a bit offset are accepted once the header of the
+ * next frame confirms the offset, and are copied bit by bit before decoding.
+ * A "bit_rate_n" tag on packed input (retuned msc_decode_vcb) sets the new frame size, the
+ * incomplete frame of the old sub-channel before it is dropped.
  */
 #define KJMP2_MAX_FRAME_SIZE    1440  // the maximum size of a frame
 #define KJMP2_SAMPLES_PER_FRAME 1152  // the number of samples per frame
@@ -79,7 +94,8 @@ namespace gr {
       int16_t d_error_frames;
       int32_t bit_window;
       int32_t bits_in_window;
-      uint8_t *d_frame_pos;
+      const uint8_t *d_frame_pos;
+      const uint8_t *d_frame_end;
       uint8_t *d_mp2_frame;
       int16_t d_V[2][1024];
       int16_t d_N[64][32];
@@ -87,10 +103,31 @@ namespace gr {
       int32_t d_scalefactor[2][32][3];
       int32_t d_sample[2][32][3];
       int32_t d_U[512];
+      bool d_fixed_point;
+      std::vector<mp2_synthesis_filterbank> d_synthesis;
+      float d_pcm_float[KJMP2_SAMPLES_PER_FRAME * 2];
+      bool d_packed;
+      int d_bit_offset; /*!< bit offset of the frames in packed input, 0 if byte aligned */
+      pmt::pmt_t d_bit_rate_n_key;
 
       void set_samplerate(int32_t);
 
-      int32_t mp2_samplerate(uint8_t *);
+      int32_t mp2_samplerate(const uint8_t *);
+
+      /*! Size of the frame in bytes as given by its header, 0 if there is no valid header. */
+      static int32_t mp2_frame_size(const uint8_t *);
+
+      /*! Position of the first valid header in length bytes, -1 if there is none. */
+      static int32_t find_sync(const uint8_t *, int32_t);
+
+      /*! Bit position (from first_bit on) of the first valid header at a bit offset of 1 to 7, -1 if there is none. */
+      static int32_t find_sync_bitwise(const uint8_t *, int32_t length, int32_t first_bit);
+
+      /*! Moves pos to the next header found by find_sync_bitwise() and sets d_bit_offset, false if there is none. */
+      bool sync_bitwise(const uint8_t *in, int32_t &pos, int32_t ninput_items, int32_t first_bit);
+
+      /*! Copies nbytes bytes starting at bit_offset of the input bit by bit to d_mp2_frame. */
+      void assemble_frame(const uint8_t *, int bit_offset, int32_t nbytes);
 
       struct quantizer_spec *read_allocation(int, int);
 
@@ -100,12 +137,18 @@ namespace gr {
 
       int32_t get_bits(int32_t);
 
-      int32_t mp2_decode_frame(uint8_t *, int16_t *);
+      int32_t mp2_decode_frame(const uint8_t *, int16_t *, float *);
+
+      void write_frame(const int16_t *, gr_vector_void_star &);
+
+      /*! Decodes the frames in ninput_items bytes, drops an incomplete frame at the end if last_frames is set. */
+      int decode_packed(int noutput_items, int ninput_items, bool last_frames, const uint8_t *in,
+                        gr_vector_void_star &output_items);
 
       void add_bit_to_mp2(uint8_t *, uint8_t, int16_t);
 
     public:
-      mp2_decode_bs_impl(int bit_rate_n);
+      mp2_decode_bs_impl(int bit_rate_n, bool fixed_point, bool packed);
 
       ~mp2_decode_bs_impl();
 
@@ -0,0 +1,172 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "mp2_synthesis_filterbank.h"
+#include <algorithm>
+#include <math.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define DAB_MP2_X86
+#include <immintrin.h>
+#endif
+
+namespace gr {
+  namespace dab {
+
+    namespace {
+      const int DCT_LENGTH = 32;
+      const int V_LENGTH = 1024;
+      const int WINDOW_ROWS = 16;
+
+      /*! Butterfly coefficients 1/(2*cos((2k+1)*pi/(2n))) of all stages of the DCT, for n = 32, 16, ..., 2. */
+      struct dct_tables {
+        float coef[DCT_LENGTH - 1];
+
+        dct_tables() {
+          float *c = coef;
+          for (int n = DCT_LENGTH; n > 1; n /= 2)
+            for (int k = 0; k < n / 2; k++)
+              *c++ = (float) (0.5 / cos(M_PI * (2 * k + 1) / (2 * n)));
+        }
+      };
+
+      const dct_tables DCT;
+
+      /*! In place DCT-II of length n, tmp is scratch space of n values. */
+      void
+      dct_lee(float *x, float *tmp, int n, const float *coef) {
+        if (n == 1)
+          return;
+        const int half = n / 2;
+        for (int k = 0; k < half; k++) {
+          const float a = x[k];
+          const float b = x[n - 1 - k];
+          tmp[k] = a + b;
+          tmp[half + k] = (a - b) * coef[k];
+        }
+        dct_lee(tmp, x, half, coef + half);
+        dct_lee(tmp + half, x + half, half, coef + half);
+        for (int m = 0; m < half - 1; m++) {
+          x[2 * m] = tmp[m];
+          x[2 * m + 1] = tmp[half + m] + tmp[half + m + 1];
+        }
+        x[n - 2] = tmp[half - 1];
+        x[n - 1] = tmp[n - 1];
+      }
+
+      /*! Offset of the 32 values of row i of the window in the ring of V. */
+      inline int
+      row_offset(int V_offs, int i) {
+        return (V_offs + (i >> 1) * 128 + (i & 1) * 96) & (V_LENGTH - 1);
+      }
+
+#ifdef DAB_MP2_X86
+      void
+      window_sse2(const float *window, const float *V, int V_offs, float *pcm) {
+        for (int j = 0; j < 32; j += 4) {
+          __m128 acc = _mm_setzero_ps();
+          for (int i = 0; i < WINDOW_ROWS; i++)
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(window + 32 * i + j),
+                                             _mm_loadu_ps(V + row_offset(V_offs, i) + j)));
+          _mm_storeu_ps(pcm + j, acc);
+        }
+      }
+
+      __attribute__((target("avx"))) void
+      window_avx(const float *window, const float *V, int V_offs, float *pcm) {
+        for (int j = 0; j < 32; j += 8) {
+          __m256 acc = _mm256_setzero_ps();
+          for (int i = 0; i < WINDOW_ROWS; i++)
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(window + 32 * i + j),
+                                                   _mm256_loadu_ps(V + row_offset(V_offs, i) + j)));
+          _mm256_storeu_ps(pcm + j, acc);
+        }
+      }
+#else
+      void
+      window_generic(const float *window, const float *V, int V_offs, float *pcm) {
+        for (int j = 0; j < 32; j++)
+          pcm[j] = 0;
+        for (int i = 0; i < WINDOW_ROWS; i++) {
+          const float *w = window + 32 * i;
+          const float *v = V + row_offset(V_offs, i);
+          for (int j = 0; j < 32; j++)
+            pcm[j] = pcm[j] + w[j] * v[j];
+        }
+      }
+#endif
+    }
+
+    mp2_synthesis_filterbank::mp2_synthesis_filterbank(const int *window)
+            : d_window(512),
+              d_V(V_LENGTH, 0),
+              d_V_offs(0),
+              d_avx(false) {
+      for (int i = 0; i < 512; i++)
+        d_window[i] = window[i] / 65536.0f;
+#ifdef DAB_MP2_X86
+      d_avx = __builtin_cpu_supports("avx");
+#endif
+    }
+
+    mp2_synthesis_filterbank::~mp2_synthesis_filterbank() {
+    }
+
+    void
+    mp2_synthesis_filterbank::reset() {
+      std::fill(d_V.begin(), d_V.end(), 0.0f);
+      d_V_offs = 0;
+    }
+
+    void
+    mp2_synthesis_filterbank::dct32(const float *in, float *out) {
+      float tmp[DCT_LENGTH];
+      std::copy(in, in + DCT_LENGTH, out);
+      dct_lee(out, tmp, DCT_LENGTH, DCT.coef);
+    }
+
+    void
+    mp2_synthesis_filterbank::synthesize(const float *samples, float *pcm) {
+      float X[DCT_LENGTH];
+      dct32(samples, X);
+
+      // matrixing: V[i] = sum_k cos((16+i)(2k+1)pi/64) * samples[k] in terms of the DCT-II
+      d_V_offs = (d_V_offs - 64) & (V_LENGTH - 1);
+      float *V = &d_V[d_V_offs];
+      for (int i = 0; i < 16; i++)
+        V[i] = X[16 + i];
+      V[16] = 0;
+      for (int i = 17; i <= 48; i++)
+        V[i] = -X[48 - i];
+      for (int i = 49; i < 64; i++)
+        V[i] = -X[i - 48];
+
+#ifdef DAB_MP2_X86
+      if (d_avx)
+        window_avx(&d_window[0], &d_V[0], d_V_offs, pcm);
+      else
+        window_sse2(&d_window[0], &d_V[0], d_V_offs, pcm);
+#else
+      window_generic(&d_window[0], &d_V[0], d_V_offs, pcm);
+#endif
+    }
+
+  }
+}
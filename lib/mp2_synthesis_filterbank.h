@@ -0,0 +1,68 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_MP2_SYNTHESIS_FILTERBANK_H
+#define INCLUDED_DAB_MP2_SYNTHESIS_FILTERBANK_H
+
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief Polyphase synthesis filterbank of MPEG-1/2 audio layer II for one channel, in float.
+ *
+ * Implements the synthesis of ISO/IEC 11172-3 chapter 2.4.3.2 (figure A.2). The matrixing
+ * of the 32 subband samples into the 64 values of V is done with a fast 32 point DCT-II
+ * (Lee's algorithm) and the symmetries of the matrixing coefficients instead of the 64x32
+ * matrix multiply. V is kept in a ring of 1024 values; U is not built, the 16 rows of the
+ * window are applied directly to the 32 sample segments of the ring, with AVX or SSE2
+ * if available. All paths give identical results.
+ *
+ * @param window The 512 coefficients D[i] of the synthesis window, scaled by 2^16.
+ */
+    class mp2_synthesis_filterbank {
+    public:
+      mp2_synthesis_filterbank(const int *window);
+
+      ~mp2_synthesis_filterbank();
+
+      /*! Sets the history of the filterbank to zero. */
+      void reset();
+
+      /*! \brief Synthesizes 32 PCM samples out of one sample of each subband.
+       *
+       * @param samples 32 subband samples, 1.0 is full scale.
+       * @param pcm 32 PCM samples, not clipped.
+       */
+      void synthesize(const float *samples, float *pcm);
+
+      /*! \brief 32 point DCT-II, out[m] = sum_k in[k] * cos((2k+1) * m * pi / 64). */
+      static void dct32(const float *in, float *out);
+
+    private:
+      std::vector<float> d_window;
+      std::vector<float> d_V;
+      int d_V_offs;
+      bool d_avx;
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_MP2_SYNTHESIS_FILTERBANK_H */
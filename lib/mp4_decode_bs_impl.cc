@@ -62,6 +62,10 @@ namespace gr {
       baudRate = 48000;
       set_output_multiple(960 *
                           4); //TODO: right? baudRate*0.12 for output of one superframe
+      set_tag_propagation_policy(TPP_DONT);
+      d_superframe_start_key = pmt::intern("superframe_start");
+      d_bit_rate_n_key = pmt::intern("bit_rate_n");
+      d_reconfigured_at = ~(uint64_t) 0;
       aacHandle = NeAACDecOpen();
       //memset(d_aac_frame, 0, 960);
       d_sample_rate = -1;
@@ -75,7 +79,8 @@ namespace gr {
 
     void
     mp4_decode_bs_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required) {
-      ninput_items_required[0] = noutput_items; //TODO: how to calculate actual rate?
+      // one superframe per 960 * 4 output samples
+      ninput_items_required[0] = noutput_items / (960 * 4) * d_superframe_size;
     }
 
     // returns aac channel configuration
@@ -235,33 +240,6 @@ namespace gr {
       return samples / 2;
     }
 
-/*! \brief CRC16 check
- * CRC16 check according to ETSI EN 300 401
- * @param msg data to check
- * @param len length of dataword without the 2 bytes crc at the end
- * @return true if CRC passed
- */
-    bool mp4_decode_bs_impl::crc16(const uint8_t *msg, int16_t len) {
-      int i, j;
-      uint16_t accumulator = 0xFFFF;
-      uint16_t crc;
-      uint16_t genpoly = 0x1021;
-
-      for (i = 0; i < len; i++) {
-        int16_t data = msg[i] << 8;
-        for (j = 8; j > 0; j--) {
-          if ((data ^ accumulator) & 0x8000)
-            accumulator = ((accumulator << 1) ^ genpoly) & 0xFFFF;
-          else
-            accumulator = (accumulator << 1) & 0xFFFF;
-          data = (data << 1) & 0xFFFF;
-        }
-      }
-      // compare calculated CRC with CRC in the AU
-      crc = ~((msg[len] << 8) | msg[len + 1]) & 0xFFFF;
-      return (crc ^ accumulator) == 0;
-    }
-
     uint16_t mp4_decode_bs_impl::BinToDec(const uint8_t *data, size_t offset, size_t length) {
       uint32_t output = (*(data + offset / 8) << 16) | ((*(data + offset / 8 + 1)) << 8) | (*(data + offset / 8 + 2));
       output >>= 24 - length - offset % 8;
@@ -274,20 +252,61 @@ namespace gr {
                                      gr_vector_int &ninput_items,
                                      gr_vector_const_void_star &input_items,
                                      gr_vector_void_star &output_items) {
-      const unsigned char *in = (const unsigned char *) input_items[0] + d_superframe_size;
+      const unsigned char *in = (const unsigned char *) input_items[0];
       int16_t *out1 = (int16_t *) output_items[0];
       int16_t *out2 = (int16_t *) output_items[1];
       d_nsamples_produced = 0;
+      const uint64_t nread = nitems_read(0);
+      int nconsumed = 0;
+
+      // superframe starts found by the superframe synchronization (firecode_check_bb)
+      std::vector<gr::tag_t> tags;
+      unsigned int tag_count = 0;
+      get_tags_in_window(tags, 0, 0, ninput_items[0], d_superframe_start_key);
+      // new data rates of a retuned sub-channel
+      std::vector<gr::tag_t> rates;
+      unsigned int rate_count = 0;
+      get_tags_in_window(rates, 0, 0, ninput_items[0], d_bit_rate_n_key);
 
       for (int n = 0; n < noutput_items / (960 * 4); n++) {
+        while (rate_count < rates.size() && (rates[rate_count].offset < nread + nconsumed ||
+                                             rates[rate_count].offset == d_reconfigured_at)) {
+          rate_count++;
+        }
+        while (rate_count < rates.size() && rates[rate_count].offset < nread + nconsumed + d_superframe_size) {
+          // drop the incomplete superframe of the old sub-channel and start over with the new one
+          nconsumed = rates[rate_count].offset - nread;
+          d_reconfigured_at = rates[rate_count].offset;
+          d_bit_rate_n = pmt::to_long(rates[rate_count].value);
+          d_superframe_size = d_bit_rate_n * 110;
+          NeAACDecClose(aacHandle);
+          aacHandle = NeAACDecOpen();
+          d_aacInitialized = false;
+          GR_LOG_DEBUG(d_logger, format("new sub-channel with bit_rate_n %d") % d_bit_rate_n);
+          rate_count++;
+        }
+        if (nconsumed + d_superframe_size > ninput_items[0])
+          break;
+        while (tag_count < tags.size() && tags[tag_count].offset < nread + nconsumed) {
+          tag_count++;
+        }
+        if (tag_count < tags.size() && tags[tag_count].offset > nread + nconsumed &&
+            tags[tag_count].offset < nread + nconsumed + d_superframe_size) {
+          // the superframe sync moved, drop the bytes before the next superframe start
+          nconsumed = tags[tag_count].offset - nread;
+          if (nconsumed + d_superframe_size > ninput_items[0])
+            break;
+        }
+        const unsigned char *sf = in + nconsumed;
+        nconsumed += d_superframe_size;
         // process superframe header
         // bits 0 .. 15 is firecode
         // bit 16 is unused
-        d_dac_rate = (in[n * d_superframe_size + 2] >> 6) & 01; // bit 17
-        d_sbr_flag = (in[n * d_superframe_size + 2] >> 5) & 01; // bit 18
-        d_aac_channel_mode = (in[n * d_superframe_size + 2] >> 4) & 01; // bit 19
-        d_ps_flag = (in[n * d_superframe_size + 2] >> 3) & 01; // bit 20
-        d_mpeg_surround = (in[n * d_superframe_size + 2] & 07); // bits 21 .. 23
+        d_dac_rate = (sf[2] >> 6) & 01; // bit 17
+        d_sbr_flag = (sf[2] >> 5) & 01; // bit 18
+        d_aac_channel_mode = (sf[2] >> 4) & 01; // bit 19
+        d_ps_flag = (sf[2] >> 3) & 01; // bit 20
+        d_mpeg_surround = (sf[2] & 07); // bits 21 .. 23
         // log header information
         GR_LOG_DEBUG(d_logger,
                      format("superframe header: dac_rate %d, sbr_flag %d, aac_mode %d, ps_flag %d, surround %d") %
@@ -302,35 +321,35 @@ namespace gr {
           case 0:
             d_num_aus = 4;
             d_au_start[0] = 8;
-            d_au_start[1] = in[n * d_superframe_size + 3] * 16 + (in[n * d_superframe_size + 4] >> 4);
-            d_au_start[2] = (in[n * d_superframe_size + 4] & 0xf) * 256 + in[n * d_superframe_size + 5];
-            d_au_start[3] = in[n * d_superframe_size + 6] * 16 + (in[n * d_superframe_size + 7] >> 4);
+            d_au_start[1] = sf[3] * 16 + (sf[4] >> 4);
+            d_au_start[2] = (sf[4] & 0xf) * 256 + sf[5];
+            d_au_start[3] = sf[6] * 16 + (sf[7] >> 4);
             d_au_start[4] = d_superframe_size;
             break;
 
           case 1:
             d_num_aus = 2;
-            d_au_start[n * d_superframe_size + 0] = 5;
-            d_au_start[1] = in[n * d_superframe_size + 3] * 16 + (in[n * d_superframe_size + 4] >> 4);
+            d_au_start[0] = 5;
+            d_au_start[1] = sf[3] * 16 + (sf[4] >> 4);
             d_au_start[2] = d_superframe_size;
             break;
 
           case 2:
             d_num_aus = 6;
             d_au_start[0] = 11;
-            d_au_start[1] = in[n * d_superframe_size + 3] * 16 + (in[n * d_superframe_size + 4] >> 4);
-            d_au_start[2] = (in[n * d_superframe_size + 4] & 0xf) * 256 + in[n * d_superframe_size + 5];
-            d_au_start[3] = in[n * d_superframe_size + 6] * 16 + (in[n * d_superframe_size + 7] >> 4);
-            d_au_start[4] = (in[n * d_superframe_size + 7] & 0xf) * 256 + in[8];
-            d_au_start[5] = in[n * d_superframe_size + 9] * 16 + (in[n * d_superframe_size + 10] >> 4);
+            d_au_start[1] = sf[3] * 16 + (sf[4] >> 4);
+            d_au_start[2] = (sf[4] & 0xf) * 256 + sf[5];
+            d_au_start[3] = sf[6] * 16 + (sf[7] >> 4);
+            d_au_start[4] = (sf[7] & 0xf) * 256 + sf[8];
+            d_au_start[5] = sf[9] * 16 + (sf[10] >> 4);
             d_au_start[6] = d_superframe_size;
             break;
 
           case 3:
             d_num_aus = 3;
             d_au_start[0] = 6;
-            d_au_start[1] = in[n * d_superframe_size + 3] * 16 + (in[n * d_superframe_size + 4] >> 4);
-            d_au_start[2] = (in[n * d_superframe_size + 4] & 0xf) * 256 + in[n * d_superframe_size + 5];
+            d_au_start[1] = sf[3] * 16 + (sf[4] >> 4);
+            d_au_start[2] = (sf[4] & 0xf) * 256 + sf[5];
             d_au_start[3] = d_superframe_size;
             break;
         }
@@ -361,10 +380,10 @@ namespace gr {
           }
 
           // CRC check of each AU (the 2 byte (16 bit) CRC word is excluded in aac_frame_length)
-          if (crc16(&in[n * d_superframe_size + d_au_start[i]], aac_frame_length)) {
+          if (d_crc16.check(&sf[d_au_start[i]], aac_frame_length)) {
             //GR_LOG_DEBUG(d_logger, format("CRC check of AU %d successful") % i);
             // handle proper AU
-            handle_aac_frame(&in[n * d_superframe_size + d_au_start[i]],
+            handle_aac_frame(&sf[d_au_start[i]],
                              aac_frame_length,
                              d_dac_rate,
                              d_sbr_flag,
@@ -381,7 +400,7 @@ namespace gr {
 
       // Tell runtime system how many input items we consumed on
       // each input stream.
-      consume_each(noutput_items * d_superframe_size / (960 * 4));
+      consume_each(nconsumed);
 
       // Tell runtime system how many output items we produced.
       return d_nsamples_produced;
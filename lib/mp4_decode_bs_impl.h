@@ -32,11 +32,16 @@
 
 #include <dab/mp4_decode_bs.h>
 #include "neaacdec.h"
+#include "crc16.h"
 
 namespace gr {
   namespace dab {
 /*! \brief DAB+ Audio frame decoder
  * according to ETSI TS 102 563
+ *
+ * Aligns to the "superframe_start" tags of the input if there are any.
+ * A "bit_rate_n" tag (retuned sub-channel) sets the new superframe size and
+ * restarts the AAC decoder, the rest of the old sub-channel is dropped.
  */
     class mp4_decode_bs_impl : public mp4_decode_bs {
     private:
@@ -48,11 +53,13 @@ namespace gr {
       int32_t baudRate;
       uint8_t d_dac_rate, d_sbr_flag, d_aac_channel_mode, d_ps_flag, d_mpeg_surround, d_num_aus;
       int16_t d_au_start[10];
+      pmt::pmt_t d_superframe_start_key;
+      pmt::pmt_t d_bit_rate_n_key;
+      uint64_t d_reconfigured_at; /*!< offset of the last "bit_rate_n" tag that was applied */
+      crc16 d_crc16;
 
       NeAACDecHandle aacHandle;
 
-      bool crc16(const uint8_t *msg, int16_t len);
-
       uint16_t BinToDec(const uint8_t *data, size_t offset, size_t length);
 
       int get_aac_channel_configuration(int16_t m_mpeg_surround_config,
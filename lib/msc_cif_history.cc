@@ -0,0 +1,77 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "msc_cif_history.h"
+#include "msc_subchannel_decoder.h"
+#include <math.h>
+
+namespace gr {
+  namespace dab {
+
+    msc_cif_history::msc_cif_history(unsigned int symbol_length)
+            : d_symbol_length(symbol_length),
+              d_cif_bits(msc_subchannel_decoder::NUM_CUS * msc_subchannel_decoder::CU_SIZE),
+              d_ring(DEPTH * d_cif_bits),
+              d_scale(DEPTH, 1.0f),
+              d_next(0),
+              d_num_cifs(0) {
+    }
+
+    msc_cif_history::~msc_cif_history() {
+    }
+
+    void
+    msc_cif_history::push(const gr_complex *cif_symbols) {
+      // the soft bits of a symbol are the real parts of all carriers followed by the imaginary parts
+      const float *in = (const float *) cif_symbols;
+      const unsigned int num_symbols = d_cif_bits / (2 * d_symbol_length);
+      float sum = 0;
+      for (unsigned int i = 0; i < d_cif_bits; i++)
+        sum += fabsf(in[i]);
+      const float scale = sum > 0 ? MEAN_MAGNITUDE * d_cif_bits / sum : 1.0f;
+
+      int8_t *out = &d_ring[d_next * d_cif_bits];
+      for (unsigned int s = 0; s < num_symbols; s++) {
+        for (unsigned int part = 0; part < 2; part++) {
+          for (unsigned int k = 0; k < d_symbol_length; k++) {
+            float v = rintf(in[2 * k + part] * scale);
+            out[k] = (int8_t) (v > 127 ? 127 : (v < -127 ? -127 : v));
+          }
+          out += d_symbol_length;
+        }
+        in += 2 * d_symbol_length;
+      }
+      d_scale[d_next] = scale;
+      d_next = (d_next + 1) % DEPTH;
+      if (d_num_cifs < DEPTH)
+        d_num_cifs++;
+    }
+
+    void
+    msc_cif_history::extract(unsigned int age, unsigned int address, unsigned int size, float *out) const {
+      const unsigned int slot = (d_next + DEPTH - 1 - age) % DEPTH;
+      const int8_t *in = &d_ring[slot * d_cif_bits + address * msc_subchannel_decoder::CU_SIZE];
+      const float factor = 1.0f / d_scale[slot];
+      for (unsigned int i = 0; i < size * msc_subchannel_decoder::CU_SIZE; i++)
+        out[i] = in[i] * factor;
+    }
+
+  }
+}
@@ -0,0 +1,80 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_MSC_CIF_HISTORY_H
+#define INCLUDED_DAB_MSC_CIF_HISTORY_H
+
+#include <gnuradio/types.h>
+#include <stdint.h>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief Soft bits of the whole MSC of the last CIFs, stored as 8 bit.
+ *
+ * Keeps the soft bits of all 864 CUs of the last DEPTH CIFs (Common Interleaved Frames)
+ * in a ring, so that the time deinterleaver of a newly selected sub-channel can be
+ * filled at once instead of waiting 15 CIFs (ETSI EN 300 401 chapter 12).
+ * Each CIF is scaled so that the mean magnitude of its soft bits is MEAN_MAGNITUDE,
+ * rounded and saturated to [-127, 127]; 15 CIFs need 810 kB.
+ *
+ * @param symbol_length Number of carriers per OFDM symbol.
+ */
+    class msc_cif_history {
+    public:
+      msc_cif_history(unsigned int symbol_length);
+
+      ~msc_cif_history();
+
+      /*! Mean magnitude of the stored soft bits. */
+      static const int MEAN_MAGNITUDE = 32;
+
+      /*! Number of kept CIFs, the time deinterleaver delays by up to 15 CIFs. */
+      static const unsigned int DEPTH = 15;
+
+      /*! \brief Stores a CIF, the oldest one is overwritten.
+       *
+       * @param cif_symbols The demodulated MSC symbols of the CIF.
+       */
+      void push(const gr_complex *cif_symbols);
+
+      /*! Number of stored CIFs, at most DEPTH. */
+      unsigned int num_cifs() const { return d_num_cifs; }
+
+      /*! \brief Soft bits of CUs [address, address+size) of an older CIF.
+       *
+       * @param age 0 for the last stored CIF, up to num_cifs()-1.
+       * @param out size*64 soft bits, rescaled to the range of the input.
+       */
+      void extract(unsigned int age, unsigned int address, unsigned int size, float *out) const;
+
+    private:
+      unsigned int d_symbol_length;
+      unsigned int d_cif_bits;
+      std::vector<int8_t> d_ring;
+      std::vector<float> d_scale; /*!< factor each CIF was multiplied with */
+      unsigned int d_next; /*!< slot of the next CIF */
+      unsigned int d_num_cifs;
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_MSC_CIF_HISTORY_H */
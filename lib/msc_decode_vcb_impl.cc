@@ -0,0 +1,161 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <boost/bind.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include "msc_decode_vcb_impl.h"
+
+namespace gr {
+  namespace dab {
+
+    msc_decode_vcb::sptr
+    msc_decode_vcb::make(unsigned int symbol_length, unsigned int address, unsigned int size, int protection,
+                         bool warm_history) {
+      return gnuradio::get_initial_sptr
+              (new msc_decode_vcb_impl(symbol_length, address, size, protection, warm_history));
+    }
+
+    /*
+     * The private constructor
+     */
+    msc_decode_vcb_impl::msc_decode_vcb_impl(unsigned int symbol_length, unsigned int address,
+                                             unsigned int size, int protection, bool warm_history)
+            : gr::block("msc_decode_vcb",
+                        gr::io_signature::make(1, 1, sizeof(gr_complex) * symbol_length),
+                        gr::io_signature::make(1, 1, sizeof(unsigned char))),
+              d_symbol_length(symbol_length),
+              d_decoder(new msc_subchannel_decoder(address, size, protection)),
+              d_pending_cif(0),
+              d_subch(size * msc_subchannel_decoder::CU_SIZE),
+              d_bit_rate_n_key(pmt::intern("bit_rate_n")) {
+      const unsigned int cif_bits = msc_subchannel_decoder::NUM_CUS * msc_subchannel_decoder::CU_SIZE;
+      if (symbol_length == 0 || cif_bits % (2 * symbol_length) != 0)
+        throw std::invalid_argument((boost::format("symbol length %d does not divide a CIF") % symbol_length).str());
+      d_symbols_per_cif = cif_bits / (2 * symbol_length);
+      if (warm_history)
+        d_history.reset(new msc_cif_history(symbol_length));
+      set_output_multiple(d_decoder->bytes());
+      set_relative_rate((double) d_decoder->bytes() / d_symbols_per_cif);
+      set_tag_propagation_policy(TPP_DONT);
+
+      message_port_register_in(pmt::mp("config"));
+      set_msg_handler(pmt::mp("config"), boost::bind(&msc_decode_vcb_impl::handle_config, this, _1));
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    msc_decode_vcb_impl::~msc_decode_vcb_impl() {
+    }
+
+    void
+    msc_decode_vcb_impl::handle_config(pmt::pmt_t msg) {
+      if (!pmt::is_dict(msg)) {
+        GR_LOG_ERROR(d_logger, "config message is not a dict");
+        return;
+      }
+      pmt::pmt_t address = pmt::dict_ref(msg, pmt::mp("address"), pmt::PMT_NIL);
+      pmt::pmt_t size = pmt::dict_ref(msg, pmt::mp("size"), pmt::PMT_NIL);
+      pmt::pmt_t protection = pmt::dict_ref(msg, pmt::mp("protection"), pmt::PMT_NIL);
+      pmt::pmt_t bit_rate_n = pmt::dict_ref(msg, pmt::mp("bit_rate_n"), pmt::PMT_NIL);
+      pmt::pmt_t cif = pmt::dict_ref(msg, pmt::mp("cif"), pmt::from_long(0));
+      if (!pmt::is_integer(address) || !pmt::is_integer(size) || !pmt::is_integer(protection) ||
+          pmt::to_long(address) < 0 || pmt::to_long(size) <= 0) {
+        GR_LOG_ERROR(d_logger, "config message needs address, size and protection");
+        return;
+      }
+      if (!pmt::is_integer(cif) || pmt::to_long(cif) < 0) {
+        GR_LOG_ERROR(d_logger, "cif of the config message is not a CIF index");
+        return;
+      }
+      try {
+        boost::shared_ptr<msc_subchannel_decoder> decoder(
+                new msc_subchannel_decoder(pmt::to_long(address), pmt::to_long(size), pmt::to_long(protection)));
+        if (pmt::is_integer(bit_rate_n) && pmt::to_long(bit_rate_n) * 24 != (long) decoder->bytes()) {
+          GR_LOG_ERROR(d_logger, boost::format("sub-channel (size %d, protection %d) does not carry %d kbit/s")
+                                 % decoder->size() % pmt::to_long(protection) % (8 * pmt::to_long(bit_rate_n)));
+          return;
+        }
+        d_pending = decoder;
+        d_pending_cif = pmt::to_long(cif);
+        GR_LOG_DEBUG(d_logger, boost::format("retuning to address %d, size %d, %d kbit/s")
+                               % decoder->address() % decoder->size() % (decoder->bytes() / 3));
+      } catch (std::invalid_argument &e) {
+        GR_LOG_ERROR(d_logger, e.what());
+      }
+    }
+
+    void
+    msc_decode_vcb_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required) {
+      ninput_items_required[0] = (noutput_items / d_decoder->bytes()) * d_symbols_per_cif;
+    }
+
+    int
+    msc_decode_vcb_impl::general_work(int noutput_items,
+                                      gr_vector_int &ninput_items,
+                                      gr_vector_const_void_star &input_items,
+                                      gr_vector_void_star &output_items) {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      unsigned char *out = (unsigned char *) output_items[0];
+
+      const uint64_t cif = nitems_read(0) / d_symbols_per_cif;
+      if (d_pending && cif >= d_pending_cif) {
+        // the input starts at a CIF boundary, switch to the new sub-channel here
+        d_decoder.swap(d_pending);
+        d_pending.reset();
+        d_subch.resize(d_decoder->size() * msc_subchannel_decoder::CU_SIZE);
+        if (d_history)
+          d_decoder->prime(*d_history);
+        set_output_multiple(d_decoder->bytes());
+        set_relative_rate((double) d_decoder->bytes() / d_symbols_per_cif);
+        add_item_tag(0, nitems_written(0), d_bit_rate_n_key, pmt::from_long(d_decoder->bytes() / 24));
+      }
+
+      int num_cifs = std::min(noutput_items / (int) d_decoder->bytes(),
+                              ninput_items[0] / (int) d_symbols_per_cif);
+      if (d_pending)
+        // stop right before the CIF of the pending configuration
+        num_cifs = std::min<uint64_t>(num_cifs, d_pending_cif - cif);
+      for (int i = 0; i < num_cifs; i++) {
+        msc_subchannel_decoder::extract_cus(in, d_symbol_length, d_decoder->address(), d_decoder->size(),
+                                            &d_subch[0]);
+        d_decoder->decode(&d_subch[0], out);
+        if (d_history)
+          d_history->push(in);
+        in += d_symbols_per_cif * d_symbol_length;
+        out += d_decoder->bytes();
+      }
+      // Tell runtime system how many input items we consumed on
+      // each input stream.
+      consume_each(num_cifs * d_symbols_per_cif);
+
+      // Tell runtime system how many output items we produced.
+      return num_cifs * d_decoder->bytes();
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
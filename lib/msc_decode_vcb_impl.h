@@ -0,0 +1,81 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_MSC_DECODE_VCB_IMPL_H
+#define INCLUDED_DAB_MSC_DECODE_VCB_IMPL_H
+
+#include <dab/msc_decode_vcb.h>
+#include <boost/shared_ptr.hpp>
+#include "msc_subchannel_decoder.h"
+
+namespace gr {
+  namespace dab {
+/*! \brief Decodes one MSC sub-channel in a single block.
+ *
+ * Consumes the MSC symbols of one CIF (Common Interleaved Frame) at a time
+ * and produces the packed bytes of the logical frame of the sub-channel.
+ * The soft bits of the sub-channel are copied straight out of the complex
+ * symbols; the rest of the CIF is never touched.
+ *
+ * A sub-channel configuration received on the port "config" is built right away
+ * (so that an invalid one is rejected in the message handler) and swapped in at the
+ * start of the next call to general_work, which always begins at a CIF boundary. If the
+ * message names a later CIF, general_work stops right before it.
+ * With warm_history, every CIF is also stored in an msc_cif_history, from which the
+ * time deinterleaver of the new sub-channel is filled.
+ *
+ * @param symbol_length Number of carriers per OFDM symbol.
+ * @param address Start address of the sub-channel in CUs.
+ * @param size Size of the sub-channel in CUs.
+ * @param protection EEP-A protection level (0 for 1-A to 3 for 4-A).
+ * @param warm_history Keep the last CIFs of the whole MSC for instant retuning.
+ */
+    class msc_decode_vcb_impl : public msc_decode_vcb {
+    private:
+      unsigned int d_symbol_length;
+      unsigned int d_symbols_per_cif;
+      boost::shared_ptr<msc_subchannel_decoder> d_decoder;
+      boost::shared_ptr<msc_subchannel_decoder> d_pending; /*!< configuration for the next CIF */
+      uint64_t d_pending_cif; /*!< index of the first CIF of the pending configuration */
+      std::vector<float> d_subch;
+      boost::shared_ptr<msc_cif_history> d_history; /*!< empty without warm_history */
+      const pmt::pmt_t d_bit_rate_n_key;
+
+      void handle_config(pmt::pmt_t msg);
+
+    public:
+      msc_decode_vcb_impl(unsigned int symbol_length, unsigned int address, unsigned int size, int protection,
+                          bool warm_history);
+
+      ~msc_decode_vcb_impl();
+
+      // Where all the action really happens
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_MSC_DECODE_VCB_IMPL_H */
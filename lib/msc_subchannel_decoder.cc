@@ -0,0 +1,110 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "msc_subchannel_decoder.h"
+#include "channel_coding.h"
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+namespace gr {
+  namespace dab {
+
+    namespace {
+      const unsigned char SCRAMBLING_VECTOR[16] = {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15};
+    }
+
+    void
+    msc_subchannel_decoder::extract_cus(const gr_complex *cif_symbols, unsigned int symbol_length,
+                                        unsigned int address, unsigned int size, float *out) {
+      unsigned int f = address * CU_SIZE;
+      const unsigned int end = (address + size) * CU_SIZE;
+      while (f < end) {
+        // soft bit f is the real or imaginary part of carrier k of symbol f/(2*symbol_length)
+        const gr_complex *sym = cif_symbols + (f / (2 * symbol_length)) * symbol_length;
+        unsigned int k = f % (2 * symbol_length);
+        unsigned int part = k / symbol_length;
+        k %= symbol_length;
+        unsigned int num = std::min(symbol_length - k, end - f);
+        const float *src = (const float *) (sym + k) + part;
+        for (unsigned int i = 0; i < num; i++) {
+          out[i] = src[2 * i];
+        }
+        out += num;
+        f += num;
+      }
+    }
+
+    msc_subchannel_decoder::msc_subchannel_decoder(unsigned int address, unsigned int size, int protection)
+            : d_address(address),
+              d_size(size),
+              d_cif_bits(size * CU_SIZE),
+              d_viterbi((eep_puncturing_vector(size, protection).size() - 24) / 4, eep_puncturing_vector(size, protection)),
+              d_ring(INTERLEAVER_DEPTH * size * CU_SIZE, 0),
+              d_ring_pos(0),
+              d_deinterleaved(size * CU_SIZE),
+              d_bits(d_viterbi.length()) {
+      if (address + size > NUM_CUS)
+        throw std::invalid_argument((boost::format("sub-channel (address %d, size %d) exceeds the CIF")
+                                     % address % size).str());
+      d_prbs = energy_dispersal_prbs(d_viterbi.length());
+    }
+
+    msc_subchannel_decoder::~msc_subchannel_decoder() {
+    }
+
+    void
+    msc_subchannel_decoder::deinterleave(const float *in) {
+      memcpy(&d_ring[d_ring_pos * d_cif_bits], in, d_cif_bits * sizeof(float));
+      // bit j of the current output comes from the CIF 15 - SCRAMBLING_VECTOR[j % 16] CIFs ago
+      for (unsigned int r = 0; r < INTERLEAVER_DEPTH; r++) {
+        unsigned int slot = (d_ring_pos + 1 + SCRAMBLING_VECTOR[r]) % INTERLEAVER_DEPTH;
+        const float *src = &d_ring[slot * d_cif_bits];
+        for (unsigned int j = r; j < d_cif_bits; j += INTERLEAVER_DEPTH) {
+          d_deinterleaved[j] = src[j];
+        }
+      }
+      d_ring_pos = (d_ring_pos + 1) % INTERLEAVER_DEPTH;
+    }
+
+    void
+    msc_subchannel_decoder::prime(const msc_cif_history &history) {
+      // slot d_ring_pos takes the next CIF, the CIF k CIFs before it is in slot d_ring_pos - k
+      std::fill(d_ring.begin(), d_ring.end(), 0.0f);
+      for (unsigned int k = 1; k < INTERLEAVER_DEPTH && k <= history.num_cifs(); k++) {
+        unsigned int slot = (d_ring_pos + INTERLEAVER_DEPTH - k) % INTERLEAVER_DEPTH;
+        history.extract(k - 1, d_address, d_size, &d_ring[slot * d_cif_bits]);
+      }
+    }
+
+    void
+    msc_subchannel_decoder::decode(const float *in, unsigned char *out) {
+      deinterleave(in);
+      d_viterbi.decode(&d_deinterleaved[0], &d_bits[0]);
+      for (unsigned int i = 0; i < bytes(); i++) {
+        const unsigned char *b = &d_bits[8 * i];
+        out[i] = (unsigned char) (((b[0] << 7) | (b[1] << 6) | (b[2] << 5) | (b[3] << 4) |
+                                   (b[4] << 3) | (b[5] << 2) | (b[6] << 1) | b[7]) ^ d_prbs[i]);
+      }
+    }
+
+  }
+}
@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_MSC_SUBCHANNEL_DECODER_H
+#define INCLUDED_DAB_MSC_SUBCHANNEL_DECODER_H
+
+#include <gnuradio/types.h>
+#include <vector>
+#include "viterbi_decoder.h"
+#include "msc_cif_history.h"
+
+namespace gr {
+  namespace dab {
+/*! \brief Channel decoder of one MSC sub-channel with equal error protection.
+ *
+ * Takes the soft bits of the sub-channel out of each CIF (Common Interleaved Frame)
+ * and produces the packed bytes of the logical frame:
+ * time deinterleaving (ETSI EN 300 401 chapter 12), depuncturing and
+ * Viterbi decoding (chapter 11) and removal of the energy dispersal (chapter 10).
+ *
+ * The time deinterleaver keeps the last 16 CIFs of the sub-channel in a ring.
+ * Like time_deinterleave_ff, the CIFs before the first one are assumed to be zero.
+ *
+ * @param address Start address of the sub-channel in CUs.
+ * @param size Size of the sub-channel in CUs.
+ * @param protection EEP-A protection level (0 for 1-A to 3 for 4-A).
+ */
+    class msc_subchannel_decoder {
+    public:
+      msc_subchannel_decoder(unsigned int address, unsigned int size, int protection);
+
+      ~msc_subchannel_decoder();
+
+      /*! Number of CUs in one CIF. */
+      static const unsigned int NUM_CUS = 864;
+      /*! Number of bits in one CU. */
+      static const unsigned int CU_SIZE = 64;
+      /*! Number of CIFs spanned by the time interleaver. */
+      static const unsigned int INTERLEAVER_DEPTH = 16;
+
+      /*! \brief Copies the soft bits of CUs [address, address+size) out of the demodulated MSC symbols of a CIF.
+       *
+       * The soft bits of a symbol are the real parts of all carriers followed by the imaginary parts,
+       * as produced by complex_to_interleaved_float_vcf.
+       */
+      static void extract_cus(const gr_complex *cif_symbols, unsigned int symbol_length,
+                              unsigned int address, unsigned int size, float *out);
+
+      /*! \brief Decodes one CIF.
+       *
+       * @param in size*64 soft bits of this sub-channel out of the current CIF.
+       * @param out bytes() packed bytes of the logical frame.
+       */
+      void decode(const float *in, unsigned char *out);
+
+      /*! \brief Fills the time deinterleaver with the CIFs before the next one.
+       *
+       * Up to 15 CIFs of this sub-channel are taken out of history (the last stored CIF
+       * is the one right before the next call to decode()), the missing ones are zero.
+       */
+      void prime(const msc_cif_history &history);
+
+      unsigned int address() const { return d_address; }
+
+      unsigned int size() const { return d_size; }
+
+      /*! Number of output bytes per CIF. */
+      unsigned int bytes() const { return d_viterbi.length() / 8; }
+
+    private:
+      void deinterleave(const float *in);
+
+      unsigned int d_address;
+      unsigned int d_size;
+      unsigned int d_cif_bits;
+      viterbi_decoder d_viterbi;
+      std::vector<float> d_ring;
+      unsigned int d_ring_pos;
+      std::vector<float> d_deinterleaved;
+      std::vector<unsigned char> d_bits;
+      std::vector<unsigned char> d_prbs;
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_MSC_SUBCHANNEL_DECODER_H */
@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "ofdm_demod_core_vcvc_impl.h"
+
+namespace gr {
+  namespace dab {
+
+    ofdm_demod_core_vcvc::sptr
+    ofdm_demod_core_vcvc::make(int fft_length, int num_carriers,
+                               const std::vector<short> &deinterleaving_sequence) {
+      return gnuradio::get_initial_sptr
+              (new ofdm_demod_core_vcvc_impl(fft_length, num_carriers, deinterleaving_sequence));
+    }
+
+    /*
+     * The private constructor
+     */
+    ofdm_demod_core_vcvc_impl::ofdm_demod_core_vcvc_impl(int fft_length, int num_carriers,
+                                                         const std::vector<short> &deinterleaving_sequence)
+            : gr::sync_block("ofdm_demod_core_vcvc",
+                             gr::io_signature::make(1, 1, fft_length * sizeof(gr_complex)),
+                             gr::io_signature::make(1, 1, num_carriers * sizeof(gr_complex))),
+              d_fft_length(fft_length),
+              d_num_carriers(num_carriers),
+              d_demod(fft_length, num_carriers, deinterleaving_sequence),
+              d_start_key(pmt::intern("Start")) {
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ofdm_demod_core_vcvc_impl::~ofdm_demod_core_vcvc_impl() {
+    }
+
+    int
+    ofdm_demod_core_vcvc_impl::work(int noutput_items,
+                                    gr_vector_const_void_star &input_items,
+                                    gr_vector_void_star &output_items) {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      gr_complex *out = (gr_complex *) output_items[0];
+      std::vector<gr::tag_t> tags;
+      unsigned int tag_count = 0;
+      // get tags for the beginning of a frame
+      get_tags_in_window(tags, 0, 0, noutput_items, d_start_key);
+
+      for (int i = 0; i < noutput_items; ++i) {
+        bool phase_reference = tag_count < tags.size() && tags[tag_count].offset - nitems_read(0) == (uint64_t) i;
+        if (phase_reference) {
+          tag_count++;
+        }
+        d_demod.demodulate(&in[i * d_fft_length], phase_reference, &out[i * d_num_carriers]);
+      }
+
+      // Tell runtime system how many output items we produced.
+      return noutput_items;
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_OFDM_DEMOD_CORE_VCVC_IMPL_H
+#define INCLUDED_DAB_OFDM_DEMOD_CORE_VCVC_IMPL_H
+
+#include <dab/ofdm_demod_core_vcvc.h>
+#include "ofdm_symbol_demodulator.h"
+
+namespace gr {
+  namespace dab {
+/*! \brief FFT, coarse frequency correction, differential demodulation and
+ * frequency deinterleaving of OFDM symbols, see ofdm_symbol_demodulator.
+ *
+ * @param fft_length Length of the FFT.
+ * @param num_carriers Number of occupied sub-carriers.
+ * @param deinterleaving_sequence Frequency deinterleaving sequence.
+ */
+    class ofdm_demod_core_vcvc_impl : public ofdm_demod_core_vcvc {
+    private:
+      int d_fft_length;
+      int d_num_carriers;
+      ofdm_symbol_demodulator d_demod;
+      pmt::pmt_t d_start_key;
+
+    public:
+      ofdm_demod_core_vcvc_impl(int fft_length, int num_carriers,
+                                const std::vector<short> &deinterleaving_sequence);
+
+      ~ofdm_demod_core_vcvc_impl();
+
+      float get_snr() { return d_demod.snr(); }
+
+      // Where all the action really happens
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_OFDM_DEMOD_CORE_VCVC_IMPL_H */
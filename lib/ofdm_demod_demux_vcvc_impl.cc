@@ -0,0 +1,170 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "ofdm_demod_demux_vcvc_impl.h"
+#include "frame_start_tag.h"
+#include <boost/format.hpp>
+#include <stdexcept>
+#include <algorithm>
+
+namespace gr {
+  namespace dab {
+
+    ofdm_demod_demux_vcvc::sptr
+    ofdm_demod_demux_vcvc::make(int fft_length, int num_carriers,
+                                const std::vector<short> &deinterleaving_sequence,
+                                unsigned int symbols_fic, unsigned int symbols_msc,
+                                const std::vector<unsigned char> &symbol_mask) {
+      return gnuradio::get_initial_sptr
+              (new ofdm_demod_demux_vcvc_impl(fft_length, num_carriers, deinterleaving_sequence,
+                                              symbols_fic, symbols_msc, symbol_mask));
+    }
+
+    /*
+     * The private constructor
+     */
+    ofdm_demod_demux_vcvc_impl::ofdm_demod_demux_vcvc_impl(int fft_length, int num_carriers,
+                                                           const std::vector<short> &deinterleaving_sequence,
+                                                           unsigned int symbols_fic, unsigned int symbols_msc,
+                                                           const std::vector<unsigned char> &symbol_mask)
+            : gr::block("ofdm_demod_demux_vcvc",
+                        gr::io_signature::make(1, 1, fft_length * sizeof(gr_complex)),
+                        gr::io_signature::make(2, 2, num_carriers * sizeof(gr_complex))),
+              d_fft_length(fft_length),
+              d_num_carriers(num_carriers),
+              d_symbols_fic(symbols_fic),
+              d_symbols_msc(symbols_msc),
+              d_demod(fft_length, num_carriers, deinterleaving_sequence),
+              d_fic_counter(0),
+              d_msc_counter(0),
+              d_start_key(pmt::intern("Start")) {
+      if (symbols_fic == 0 || symbols_msc == 0) {
+        throw std::invalid_argument("a frame needs at least one FIC and one MSC symbol");
+      }
+      set_tag_propagation_policy(TPP_DONT);
+      set_symbol_mask(symbol_mask);
+      d_symbol_mask = d_next_symbol_mask;
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ofdm_demod_demux_vcvc_impl::~ofdm_demod_demux_vcvc_impl() {
+    }
+
+    void
+    ofdm_demod_demux_vcvc_impl::set_symbol_mask(const std::vector<unsigned char> &symbol_mask) {
+      if (!symbol_mask.empty() && symbol_mask.size() != 1 + d_symbols_fic + d_symbols_msc) {
+        throw std::invalid_argument((boost::format("symbol mask has %d entries, expected %d")
+                                     % symbol_mask.size() % (1 + d_symbols_fic + d_symbols_msc)).str());
+      }
+      gr::thread::scoped_lock guard(d_setlock);
+      d_next_symbol_mask = symbol_mask;
+    }
+
+    void
+    ofdm_demod_demux_vcvc_impl::apply_symbol_mask(const pmt::pmt_t &start_tag_value) {
+      // the mask this frame was written with by the synchronization, the own mask for tags without one
+      std::vector<unsigned char> mask;
+      if (frame_start_tag_mask(start_tag_value, mask) &&
+          (mask.empty() || mask.size() == 1 + d_symbols_fic + d_symbols_msc)) {
+        d_symbol_mask.swap(mask);
+      } else {
+        gr::thread::scoped_lock guard(d_setlock);
+        d_symbol_mask = d_next_symbol_mask;
+      }
+    }
+
+    void
+    ofdm_demod_demux_vcvc_impl::forecast(int noutput_items,
+                                         gr_vector_int &ninput_items_required) {
+      ninput_items_required[0] = noutput_items;
+    }
+
+    int
+    ofdm_demod_demux_vcvc_impl::general_work(int noutput_items,
+                                             gr_vector_int &ninput_items,
+                                             gr_vector_const_void_star &input_items,
+                                             gr_vector_void_star &output_items) {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      gr_complex *fic_out = (gr_complex *) output_items[0];
+      gr_complex *msc_out = (gr_complex *) output_items[1];
+      unsigned int nconsumed = 0;
+      unsigned int fic_syms_written = 0;
+      unsigned int msc_syms_written = 0;
+
+      // get tags for the beginning of a frame
+      std::vector<gr::tag_t> tags;
+      unsigned int tag_count = 0;
+      get_tags_in_window(tags, 0, 0, noutput_items, d_start_key);
+
+      for (int i = 0; i < noutput_items; ++i) {
+        if (d_fic_counter == d_symbols_fic && d_msc_counter < d_symbols_msc && !d_symbol_mask.empty() &&
+            !d_symbol_mask[1 + d_symbols_fic + d_msc_counter]) {
+          // This msc symbol was left out by the synchronization, fill it in.
+          std::fill_n(&msc_out[msc_syms_written++ * d_num_carriers], d_num_carriers, gr_complex(0, 0));
+          d_msc_counter++;
+        } else if (tag_count < tags.size() &&
+                   tags[tag_count].offset - nitems_read(0) - nconsumed == 0) {
+          // This input symbol is tagged: a new frame begins here.
+          if (d_fic_counter % d_symbols_fic == 0 && d_msc_counter % d_symbols_msc == 0) {
+            // The phase reference symbol is demodulated for the next symbol, but not written out.
+            d_demod.demodulate(&in[nconsumed++ * d_fft_length], true, NULL);
+            tag_count++;
+            d_fic_counter = 0;
+            d_msc_counter = 0;
+            apply_symbol_mask(tags[tag_count - 1].value);
+          } else if (d_fic_counter % d_symbols_fic != 0) {
+            // We did not finish the last frame, fill the remaining symbols with zeros first.
+            std::fill_n(&fic_out[fic_syms_written++ * d_num_carriers], d_num_carriers, gr_complex(0, 0));
+            d_fic_counter++;
+          } else {
+            std::fill_n(&msc_out[msc_syms_written++ * d_num_carriers], d_num_carriers, gr_complex(0, 0));
+            d_msc_counter++;
+          }
+        } else if (d_fic_counter < d_symbols_fic) {
+          d_demod.demodulate(&in[nconsumed++ * d_fft_length], false,
+                             &fic_out[fic_syms_written++ * d_num_carriers]);
+          d_fic_counter++;
+        } else if (d_msc_counter < d_symbols_msc) {
+          d_demod.demodulate(&in[nconsumed++ * d_fft_length], false,
+                             &msc_out[msc_syms_written++ * d_num_carriers]);
+          d_msc_counter++;
+        } else {
+          /* The frame is complete, but the next frame does not start yet.
+           * The next symbol which is written out follows a phase reference symbol,
+           * so this one does not need to be demodulated. */
+          nconsumed++;
+        }
+      }
+      consume_each(nconsumed);
+
+      produce(0, fic_syms_written);
+      produce(1, msc_syms_written);
+      return WORK_CALLED_PRODUCE;
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
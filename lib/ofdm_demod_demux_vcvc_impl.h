@@ -0,0 +1,78 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_OFDM_DEMOD_DEMUX_VCVC_IMPL_H
+#define INCLUDED_DAB_OFDM_DEMOD_DEMUX_VCVC_IMPL_H
+
+#include <dab/ofdm_demod_demux_vcvc.h>
+#include "ofdm_symbol_demodulator.h"
+
+namespace gr {
+  namespace dab {
+/*! \brief OFDM demodulation with separation of FIC and MSC symbols.
+ *
+ * The symbol counters and the symbol mask work like in demux_cc_impl,
+ * the demodulated symbols are written straight to their output buffer.
+ */
+    class ofdm_demod_demux_vcvc_impl : public ofdm_demod_demux_vcvc {
+    private:
+      int d_fft_length;
+      int d_num_carriers;
+      unsigned int d_symbols_fic;
+      unsigned int d_symbols_msc;
+      ofdm_symbol_demodulator d_demod;
+      unsigned int d_fic_counter;
+      /*!< Number of FIC symbols written of the current frame. */
+      unsigned int d_msc_counter;
+      /*!< Number of MSC symbols written of the current frame. */
+      std::vector<unsigned char> d_symbol_mask;
+      /*!< Symbols of the current frame which are in the input stream (empty for all symbols). */
+      std::vector<unsigned char> d_next_symbol_mask;
+      /*!< Symbol mask which is applied to frames whose "Start" tag carries no mask. */
+      pmt::pmt_t d_start_key;
+
+      /*! \brief Sets d_symbol_mask for the frame which starts with a "Start" tag with this value. */
+      void apply_symbol_mask(const pmt::pmt_t &start_tag_value);
+
+    public:
+      ofdm_demod_demux_vcvc_impl(int fft_length, int num_carriers,
+                                 const std::vector<short> &deinterleaving_sequence,
+                                 unsigned int symbols_fic, unsigned int symbols_msc,
+                                 const std::vector<unsigned char> &symbol_mask);
+
+      ~ofdm_demod_demux_vcvc_impl();
+
+      void set_symbol_mask(const std::vector<unsigned char> &symbol_mask);
+
+      float get_snr() { return d_demod.snr(); }
+
+      // Where all the action really happens
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_OFDM_DEMOD_DEMUX_VCVC_IMPL_H */
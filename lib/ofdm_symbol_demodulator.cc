@@ -0,0 +1,184 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ofdm_symbol_demodulator.h"
+#include <boost/format.hpp>
+#include <volk/volk.h>
+#include <stdexcept>
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+
+namespace gr {
+  namespace dab {
+
+    ofdm_symbol_demodulator::ofdm_symbol_demodulator(int fft_length, int num_carriers,
+                                                     const std::vector<short> &deinterleaving_sequence)
+            : d_fft_length(fft_length),
+              d_num_carriers(num_carriers),
+              d_scale(1.0f / 2048),
+              d_gather(num_carriers, -1),
+              d_fft(fft_length, true),
+              d_freq_offset(0),
+              d_snr(0) {
+      if (num_carriers <= 0 || num_carriers % 2 || num_carriers >= fft_length) {
+        throw std::invalid_argument((boost::format("%d carriers do not fit into an FFT of length %d")
+                                     % num_carriers % fft_length).str());
+      }
+      if (deinterleaving_sequence.size() != (size_t) num_carriers) {
+        throw std::invalid_argument((boost::format("deinterleaving sequence has %d entries, expected %d")
+                                     % deinterleaving_sequence.size() % num_carriers).str());
+      }
+      for (int k = 0; k < num_carriers; k++) {
+        short position = deinterleaving_sequence[k];
+        if (position < 0 || position >= num_carriers || d_gather[position] >= 0) {
+          throw std::invalid_argument("deinterleaving sequence is not a permutation of the carriers");
+        }
+        d_gather[position] = k;
+      }
+      unsigned int alignment = volk_get_alignment();
+      d_previous = (gr_complex *) volk_malloc(sizeof(gr_complex) * num_carriers, alignment);
+      d_phasors = (gr_complex *) volk_malloc(sizeof(gr_complex) * num_carriers, alignment);
+      d_shifted = (gr_complex *) volk_malloc(sizeof(gr_complex) * fft_length, alignment);
+      d_mag_squared = (float *) volk_malloc(sizeof(float) * fft_length, alignment);
+      // like the history of diff_phasor_vcc, the symbol before the first one is zero
+      std::fill_n(d_previous, num_carriers, gr_complex(0, 0));
+      update_segments();
+    }
+
+    ofdm_symbol_demodulator::~ofdm_symbol_demodulator() {
+      volk_free(d_previous);
+      volk_free(d_phasors);
+      volk_free(d_shifted);
+      volk_free(d_mag_squared);
+    }
+
+    void
+    ofdm_symbol_demodulator::measure_energy() {
+      /* The energy over the num_carriers sub-carriers + the central carrier gets a maximum when
+       * the calculation window and the occupied carriers are congruent. It is calculated as
+       * moving sum over all possible carrier offsets.
+       */
+      const int half = d_num_carriers / 2;
+      float energy = 0;
+      for (int k = 0; k <= d_num_carriers; k++) {
+        energy += d_mag_squared[k];
+      }
+      // the central (DC) carrier is not occupied
+      energy -= d_mag_squared[half];
+      float max = energy;
+      int index = 0;
+      for (int i = 1; i < d_fft_length - d_num_carriers; i++) {
+        energy += d_mag_squared[i + d_num_carriers] - d_mag_squared[i - 1]
+                  + d_mag_squared[i + half - 1] - d_mag_squared[i + half];
+        if (energy > max) {
+          max = energy;
+          index = i;
+        }
+      }
+      d_freq_offset = index;
+    }
+
+    void
+    ofdm_symbol_demodulator::measure_snr() {
+      const int first = d_freq_offset;
+      const int last = d_freq_offset + d_num_carriers;
+      const int dc = d_freq_offset + d_num_carriers / 2;
+      float energy = 0, noise = 0;
+      for (int k = 0; k < d_fft_length; k++) {
+        if (k < first || k > last || k == dc) {
+          noise += d_mag_squared[k];
+        } else {
+          energy += d_mag_squared[k];
+        }
+      }
+      // normalize
+      energy /= d_num_carriers;
+      noise /= d_fft_length - d_num_carriers;
+      // check if ratio is in the definition range of the log
+      if (energy > noise) {
+        d_snr = 10 * log10((energy - noise) / noise);
+      }
+    }
+
+    void
+    ofdm_symbol_demodulator::update_segments() {
+      /* The carriers left and right of the central carrier in the shifted spectrum
+       * (as fft_vcc outputs it) are mapped to the bins of the FFT output. A range that
+       * wraps around the end of the FFT output is split into two segments. */
+      const int half = d_num_carriers / 2;
+      const int first_bin[2] = {d_freq_offset, d_freq_offset + half + 1};
+      d_segments.clear();
+      for (int side = 0; side < 2; side++) {
+        int carrier = side * half;
+        int bin = (first_bin[side] + d_fft_length / 2) % d_fft_length;
+        int remaining = half;
+        while (remaining > 0) {
+          carrier_segment segment;
+          segment.fft_bin = bin;
+          segment.carrier = carrier;
+          segment.length = std::min(remaining, d_fft_length - bin);
+          d_segments.push_back(segment);
+          carrier += segment.length;
+          remaining -= segment.length;
+          bin = 0;
+        }
+      }
+    }
+
+    void
+    ofdm_symbol_demodulator::demodulate(const gr_complex *in, bool phase_reference, gr_complex *out) {
+      memcpy(d_fft.get_inbuf(), in, d_fft_length * sizeof(gr_complex));
+      d_fft.execute();
+      const gr_complex *spectrum = d_fft.get_outbuf();
+
+      if (phase_reference) {
+        /* new coarse frequency offset for each frame, measured at the phase reference symbol
+         * and applied for all symbols of this frame */
+        const int half = d_fft_length / 2;
+        memcpy(d_shifted, &spectrum[half], (d_fft_length - half) * sizeof(gr_complex));
+        memcpy(&d_shifted[d_fft_length - half], spectrum, half * sizeof(gr_complex));
+        volk_32fc_magnitude_squared_32f(d_mag_squared, d_shifted, d_fft_length);
+        measure_energy();
+        measure_snr();
+        update_segments();
+      }
+
+      // differential phasors of the occupied carriers, read in place out of the FFT output
+      for (size_t s = 0; s < d_segments.size(); s++) {
+        const carrier_segment &segment = d_segments[s];
+        if (out) {
+          volk_32fc_x2_multiply_conjugate_32fc(&d_phasors[segment.carrier], &spectrum[segment.fft_bin],
+                                               &d_previous[segment.carrier], segment.length);
+        }
+        memcpy(&d_previous[segment.carrier], &spectrum[segment.fft_bin],
+               segment.length * sizeof(gr_complex));
+      }
+
+      if (out) {
+        // frequency deinterleaving
+        for (int k = 0; k < d_num_carriers; k++) {
+          out[k] = d_phasors[d_gather[k]] * d_scale;
+        }
+      }
+    }
+
+  }
+}
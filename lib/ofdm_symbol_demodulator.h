@@ -0,0 +1,110 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_OFDM_SYMBOL_DEMODULATOR_H
+#define INCLUDED_DAB_OFDM_SYMBOL_DEMODULATOR_H
+
+#include <gnuradio/types.h>
+#include <gnuradio/fft/fft.h>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief FFT, coarse frequency correction, differential demodulation and
+ * frequency deinterleaving of one OFDM symbol.
+ *
+ * The occupied carriers are read directly out of the (not shifted) FFT output.
+ * The carriers of the previous symbol are kept in a buffer of num_carriers
+ * samples for the differential demodulation, the deinterleaving is a gather
+ * through a precomputed table. Used by ofdm_demod_core_vcvc and ofdm_demod_demux_vcvc.
+ *
+ * @param fft_length Length of the FFT.
+ * @param num_carriers Number of occupied sub-carriers.
+ * @param deinterleaving_sequence Frequency deinterleaving sequence.
+ */
+    class ofdm_symbol_demodulator {
+    public:
+      ofdm_symbol_demodulator(int fft_length, int num_carriers,
+                              const std::vector<short> &deinterleaving_sequence);
+
+      ~ofdm_symbol_demodulator();
+
+      /*! \brief Demodulates one symbol.
+       *
+       * @param in fft_length samples of the symbol.
+       * @param phase_reference True for the phase reference symbol of a frame. The coarse
+       * frequency offset and the SNR are measured at it and used for the following symbols.
+       * @param out num_carriers deinterleaved differential phasors, or NULL if only the
+       * state for the next symbol is needed.
+       */
+      void demodulate(const gr_complex *in, bool phase_reference, gr_complex *out);
+
+      /*! SNR in dB, measured at the last phase reference symbol. */
+      float snr() const { return d_snr; }
+
+    private:
+      /*! Range of carriers which are in consecutive bins of the FFT output. */
+      struct carrier_segment {
+        int fft_bin;
+        int carrier;
+        int length;
+      };
+
+      // holds volk buffers, not copyable
+      ofdm_symbol_demodulator(const ofdm_symbol_demodulator &);
+
+      ofdm_symbol_demodulator &operator=(const ofdm_symbol_demodulator &);
+
+      /*! \brief Measures the coarse frequency offset by searching for the maximum
+       * of energy over the occupied carriers in the shifted spectrum d_shifted.
+       */
+      void measure_energy();
+
+      /*! \brief Measures the SNR by comparing the energy of the occupied and the empty sub-carriers. */
+      void measure_snr();
+
+      /*! \brief Calculates the positions of the occupied carriers in the FFT output. */
+      void update_segments();
+
+      int d_fft_length;
+      int d_num_carriers;
+      float d_scale;
+      /*!< Scaling of the differential phasors, the product of the scaling of both FFTs. */
+      std::vector<int> d_gather;
+      /*!< Output position k of the deinterleaver gets carrier d_gather[k]. */
+      gr::fft::fft_complex d_fft;
+      int d_freq_offset;
+      /*!< Coarse frequency offset, index of the first occupied carrier in the shifted spectrum. */
+      float d_snr;
+      std::vector<carrier_segment> d_segments;
+      /*!< Position of the occupied carriers in the FFT output for the current frequency offset. */
+      gr_complex *d_previous;
+      /*!< Occupied carriers of the previous symbol. */
+      gr_complex *d_phasors;
+      /*!< Differential phasors of the current symbol before deinterleaving. */
+      gr_complex *d_shifted;
+      /*!< Shifted spectrum of the phase reference symbol, used for the measurements. */
+      float *d_mag_squared;
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_OFDM_SYMBOL_DEMODULATOR_H */
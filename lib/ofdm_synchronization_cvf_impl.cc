@@ -25,6 +25,7 @@
 #endif
 
 #include "ofdm_synchronization_cvf_impl.h"
+#include "frame_start_tag.h"
 #include <gnuradio/io_signature.h>
 #include <boost/format.hpp>
 #include <volk/volk.h>
@@ -33,6 +34,13 @@
 #include <string>
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DAB_OFDM_SYNCHRONIZATION_X86
+#include <immintrin.h>
+#endif
 
 using namespace boost;
 
@@ -41,11 +49,13 @@ namespace gr {
 
     ofdm_synchronization_cvf::sptr
     ofdm_synchronization_cvf::make(int symbol_length, int cyclic_prefix_length,
-                                   int fft_length, int symbols_per_frame) {
+                                   int fft_length, int symbols_per_frame,
+                                   const std::vector<unsigned char> &symbol_mask) {
       return gnuradio::get_initial_sptr(new ofdm_synchronization_cvf_impl(symbol_length,
                                                                           cyclic_prefix_length,
                                                                           fft_length,
-                                                                          symbols_per_frame));
+                                                                          symbols_per_frame,
+                                                                          symbol_mask));
     }
 
     /*
@@ -53,7 +63,8 @@ namespace gr {
      */
     ofdm_synchronization_cvf_impl::ofdm_synchronization_cvf_impl(
             int symbol_length, int cyclic_prefix_length,
-            int fft_length, int symbols_per_frame)
+            int fft_length, int symbols_per_frame,
+            const std::vector<unsigned char> &symbol_mask)
             : gr::block("ofdm_synchronization_cvf",
                         gr::io_signature::make(1, 1, sizeof(gr_complex)),
                         gr::io_signature::make(1, 1, sizeof(gr_complex))),
@@ -66,18 +77,40 @@ namespace gr {
               d_energy_repetition(1),
               d_frequency_offset_per_sample(0),
               d_NULL_detected(false),
-              d_moving_average_counter(0),
               d_symbol_count(0),
               d_symbol_element_count(0),
               d_wait_for_NULL(true),
               d_on_triangle(false),
               d_phase(gr_complex(1,0)),
               d_peak_set(false),
-              d_correlation_maximum(0){
+              d_correlation_maximum(0),
+              d_predict_frame(false),
+              d_frame_start(0),
+              d_frame_length(0),
+              d_frame_complete(false),
+              d_search_window(cyclic_prefix_length / 4),
+              d_batch_size(4 * symbol_length),
+              d_batch_start(0),
+              d_batch_end(0){
       //allocation for repeating energy measurements
       unsigned int alignment = volk_get_alignment();
       d_mag_squared = (float *) volk_malloc(sizeof(float) * d_cyclic_prefix_length, alignment);
-      d_fixed_lag_corr = (gr_complex *) volk_malloc(sizeof(gr_complex) * d_cyclic_prefix_length, alignment);
+      //allocation for the batched correlation in acquisition mode
+      const int lag_length = d_batch_size + d_cyclic_prefix_length;
+      d_lag_products = (gr_complex *) volk_malloc(sizeof(gr_complex) * lag_length, alignment);
+      d_batch_mag_squared = (float *) volk_malloc(sizeof(float) * (lag_length + d_symbol_length), alignment);
+      d_batch_correlation = (gr_complex *) volk_malloc(sizeof(gr_complex) * d_batch_size, alignment);
+      d_batch_magnitude = (float *) volk_malloc(sizeof(float) * d_batch_size, alignment);
+      d_batch_energy_product = (float *) volk_malloc(sizeof(float) * d_batch_size, alignment);
+      d_batch_energy_ratio = (float *) volk_malloc(sizeof(float) * d_batch_size, alignment);
+      d_prefix_sums.resize(4 * (lag_length + 1));
+#ifdef DAB_OFDM_SYNCHRONIZATION_X86
+      d_avx = __builtin_cpu_supports("avx");
+#else
+      d_avx = false;
+#endif
+      set_symbol_mask(symbol_mask);
+      d_symbol_mask = d_next_symbol_mask;
       this->set_output_multiple(d_symbol_length);
     }
 
@@ -85,6 +118,23 @@ namespace gr {
      * Our virtual destructor.
      */
     ofdm_synchronization_cvf_impl::~ofdm_synchronization_cvf_impl() {
+      volk_free(d_mag_squared);
+      volk_free(d_lag_products);
+      volk_free(d_batch_mag_squared);
+      volk_free(d_batch_correlation);
+      volk_free(d_batch_magnitude);
+      volk_free(d_batch_energy_product);
+      volk_free(d_batch_energy_ratio);
+    }
+
+    void
+    ofdm_synchronization_cvf_impl::set_symbol_mask(const std::vector<unsigned char> &symbol_mask) {
+      if (!symbol_mask.empty() && symbol_mask.size() != (size_t) d_symbols_per_frame) {
+        throw std::invalid_argument((boost::format("symbol mask has %d entries, expected %d")
+                                     % symbol_mask.size() % d_symbols_per_frame).str());
+      }
+      gr::thread::scoped_lock guard(d_setlock);
+      d_next_symbol_mask = symbol_mask;
     }
 
     void
@@ -93,40 +143,17 @@ namespace gr {
     }
 
     void
-    ofdm_synchronization_cvf_impl::delayed_correlation(const gr_complex *sample, bool new_calculation) {
-      if (d_moving_average_counter > 100000 || d_moving_average_counter == 0 || new_calculation) {
-        if (d_moving_average_counter == 0 && (!new_calculation)) {
-          // first value is calculated completely, next values are calculated with moving average
-          d_moving_average_counter++;
-        } else {
-          // reset counter
-          d_moving_average_counter = 0;
-        }
-        // calculate delayed correlation for this sample completely
-        volk_32fc_x2_conjugate_dot_prod_32fc(d_fixed_lag_corr, sample,
-                                             &sample[d_symbol_length],
-                                             d_cyclic_prefix_length);
-        d_correlation = 0;
-        for (int i = 0; i < d_cyclic_prefix_length; ++i) {
-          d_correlation += d_fixed_lag_corr[i];
-        }
-        // calculate energy of cyclic prefix for this sample completely
-        volk_32fc_magnitude_squared_32f(d_mag_squared, sample, d_cyclic_prefix_length);
-        volk_32f_accumulator_s32f(&d_energy_prefix, d_mag_squared, d_cyclic_prefix_length);
-        // calculate energy of its repetition for this sample completely
-        volk_32fc_magnitude_squared_32f(d_mag_squared, &sample[d_symbol_length], d_cyclic_prefix_length);
-        volk_32f_accumulator_s32f(&d_energy_repetition, d_mag_squared, d_cyclic_prefix_length);
-      } else {
-        // calculate next step for moving average
-        d_correlation += sample[d_cyclic_prefix_length - 1] * conj(sample[d_symbol_length + d_cyclic_prefix_length - 1]);
-        d_energy_prefix += std::real(sample[d_cyclic_prefix_length - 1] * conj(sample[d_cyclic_prefix_length - 1]));
-        d_energy_repetition += std::real( sample[d_symbol_length + d_cyclic_prefix_length - 1] *
-                                          conj(sample[d_symbol_length + d_cyclic_prefix_length - 1]));
-        d_correlation -= sample[0] * conj(sample[d_symbol_length]);
-        d_energy_prefix -= std::real(sample[0] * conj(sample[0]));
-        d_energy_repetition -= std::real(sample[d_symbol_length] * conj(sample[d_symbol_length]));
-        d_moving_average_counter++;
-      }
+    ofdm_synchronization_cvf_impl::delayed_correlation(const gr_complex *sample) {
+      // calculate delayed correlation for this sample
+      volk_32fc_x2_conjugate_dot_prod_32fc(&d_correlation, sample,
+                                           &sample[d_symbol_length],
+                                           d_cyclic_prefix_length);
+      // calculate energy of cyclic prefix for this sample
+      volk_32fc_magnitude_squared_32f(d_mag_squared, sample, d_cyclic_prefix_length);
+      volk_32f_accumulator_s32f(&d_energy_prefix, d_mag_squared, d_cyclic_prefix_length);
+      // calculate energy of its repetition for this sample
+      volk_32fc_magnitude_squared_32f(d_mag_squared, &sample[d_symbol_length], d_cyclic_prefix_length);
+      volk_32f_accumulator_s32f(&d_energy_repetition, d_mag_squared, d_cyclic_prefix_length);
       // normalize
       d_correlation_normalized = d_correlation / std::sqrt(d_energy_prefix * d_energy_repetition);
       // calculate magnitude
@@ -134,6 +161,111 @@ namespace gr {
                                            d_correlation_normalized.imag() * d_correlation_normalized.imag();
     }
 
+    void
+    ofdm_synchronization_cvf_impl::batch_correlation(const gr_complex *sample, int num) {
+      const int lag_length = num + d_cyclic_prefix_length;
+      // lagged products and energies of all samples of the batch
+      volk_32fc_x2_multiply_conjugate_32fc(d_lag_products, sample, &sample[d_symbol_length], lag_length);
+      volk_32fc_magnitude_squared_32f(d_batch_mag_squared, sample, lag_length + d_symbol_length);
+
+      if (d_avx)
+        batch_sums_avx(num);
+      else
+        batch_sums(num);
+      // normalized magnitude |correlation|^2 / (energy_prefix * energy_repetition)
+      volk_32fc_magnitude_squared_32f(d_batch_magnitude, d_batch_correlation, num);
+      volk_32f_x2_divide_32f(d_batch_magnitude, d_batch_magnitude, d_batch_energy_product, num);
+    }
+
+    void
+    ofdm_synchronization_cvf_impl::batch_sums(int num) {
+      const int lag_length = num + d_cyclic_prefix_length;
+      /* Running sums as prefix sums in double precision. They start from zero for each batch,
+       * so there is no rounding error that builds up over time. */
+      double *prefix = &d_prefix_sums[0];
+      double corr_real = 0, corr_imag = 0, energy_prefix = 0, energy_repetition = 0;
+      for (int k = 0; k < lag_length; ++k) {
+        prefix[4 * k] = corr_real;
+        prefix[4 * k + 1] = corr_imag;
+        prefix[4 * k + 2] = energy_prefix;
+        prefix[4 * k + 3] = energy_repetition;
+        corr_real += d_lag_products[k].real();
+        corr_imag += d_lag_products[k].imag();
+        energy_prefix += d_batch_mag_squared[k];
+        energy_repetition += d_batch_mag_squared[k + d_symbol_length];
+      }
+      prefix[4 * lag_length] = corr_real;
+      prefix[4 * lag_length + 1] = corr_imag;
+      prefix[4 * lag_length + 2] = energy_prefix;
+      prefix[4 * lag_length + 3] = energy_repetition;
+
+      // windowed sums over cyclic_prefix_length samples
+      const int cp = 4 * d_cyclic_prefix_length;
+      for (int k = 0; k < num; ++k) {
+        const double *start = &prefix[4 * k];
+        d_batch_correlation[k] = gr_complex(static_cast<float>(start[cp] - start[0]),
+                                            static_cast<float>(start[cp + 1] - start[1]));
+        float energy_p = static_cast<float>(start[cp + 2] - start[2]);
+        float energy_r = static_cast<float>(start[cp + 3] - start[3]);
+        // |correlation|^2 <= energy_p * energy_r, the offset only keeps silent input away from 0/0
+        d_batch_energy_product[k] = energy_p * energy_r + 1e-30f;
+        d_batch_energy_ratio[k] = (energy_r > 0) ? energy_p / energy_r : 1.0f;
+      }
+    }
+
+#ifdef DAB_OFDM_SYNCHRONIZATION_X86
+    __attribute__((target("avx"))) void
+    ofdm_synchronization_cvf_impl::batch_sums_avx(int num) {
+      const int lag_length = num + d_cyclic_prefix_length;
+      // the running sum stays in one register, one addition per sample
+      double *prefix = &d_prefix_sums[0];
+      __m256d sum = _mm256_setzero_pd();
+      for (int k = 0; k < lag_length; ++k) {
+        _mm256_storeu_pd(&prefix[4 * k], sum);
+        __m128 lag = _mm_castpd_ps(_mm_load_sd((const double *) &d_lag_products[k]));
+        __m128 energy = _mm_unpacklo_ps(_mm_load_ss(&d_batch_mag_squared[k]),
+                                        _mm_load_ss(&d_batch_mag_squared[k + d_symbol_length]));
+        sum = _mm256_add_pd(sum, _mm256_cvtps_pd(_mm_movelh_ps(lag, energy)));
+      }
+      _mm256_storeu_pd(&prefix[4 * lag_length], sum);
+
+      // windowed sums of four samples, transposed to correlation and energies
+      const int cp = 4 * d_cyclic_prefix_length;
+      const __m128 zero = _mm_setzero_ps();
+      const __m128 one = _mm_set1_ps(1.0f);
+      const __m128 offset = _mm_set1_ps(1e-30f);
+      int k = 0;
+      for (; k + 4 <= num; k += 4) {
+        __m128 w[4];
+        for (int i = 0; i < 4; ++i) {
+          const double *start = &prefix[4 * (k + i)];
+          w[i] = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(start + cp), _mm256_loadu_pd(start)));
+        }
+        // interleaved real and imaginary parts are the complex correlation of two samples
+        _mm_storeu_ps((float *) &d_batch_correlation[k], _mm_movelh_ps(w[0], w[1]));
+        _mm_storeu_ps((float *) &d_batch_correlation[k + 2], _mm_movelh_ps(w[2], w[3]));
+        _MM_TRANSPOSE4_PS(w[0], w[1], w[2], w[3]);
+        _mm_storeu_ps(&d_batch_energy_product[k], _mm_add_ps(_mm_mul_ps(w[2], w[3]), offset));
+        _mm_storeu_ps(&d_batch_energy_ratio[k],
+                      _mm_blendv_ps(one, _mm_div_ps(w[2], w[3]), _mm_cmpgt_ps(w[3], zero)));
+      }
+      for (; k < num; ++k) {
+        const double *start = &prefix[4 * k];
+        __m128 w = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(start + cp), _mm256_loadu_pd(start)));
+        _mm_storel_pi((__m64 *) &d_batch_correlation[k], w);
+        float energy_p = _mm_cvtss_f32(_mm_movehl_ps(w, w));
+        float energy_r = _mm_cvtss_f32(_mm_shuffle_ps(w, w, 3));
+        d_batch_energy_product[k] = energy_p * energy_r + 1e-30f;
+        d_batch_energy_ratio[k] = (energy_r > 0) ? energy_p / energy_r : 1.0f;
+      }
+    }
+#else
+    void
+    ofdm_synchronization_cvf_impl::batch_sums_avx(int num) {
+      batch_sums(num);
+    }
+#endif
+
     /*! \brief returns true at a point with a little space before the peak of a correlation triangular
      *
      */
@@ -152,6 +284,7 @@ namespace gr {
           d_peak_set = false;
           d_on_triangle = false;
           d_correlation_maximum = 0;
+          return false;
         } else {
           // we are still on the triangle but have not reached the end
           return false;
@@ -169,6 +302,41 @@ namespace gr {
       }
     }
 
+    void
+    ofdm_synchronization_cvf_impl::frame_start_detected(uint64_t position) {
+      if (d_frame_complete) {
+        int frame_length = position - d_frame_start;
+        // a frame has symbols_per_frame symbols and a NULL symbol shorter than 2 symbols
+        if (frame_length > d_symbols_per_frame * (d_symbol_length + d_cyclic_prefix_length) &&
+            frame_length < (d_symbols_per_frame + 2) * (d_symbol_length + d_cyclic_prefix_length)) {
+          d_frame_length = frame_length;
+        } else {
+          d_frame_length = 0;
+        }
+      }
+      d_frame_start = position;
+      d_frame_complete = false;
+    }
+
+    int
+    ofdm_synchronization_cvf_impl::search_predicted_frame_start(const gr_complex *in) {
+      d_on_triangle = false;
+      d_peak_set = false;
+      d_correlation_maximum = 0;
+      batch_correlation(in, 2 * d_search_window + 1);
+      for (int k = 0; k <= 2 * d_search_window; ++k) {
+        d_correlation = d_batch_correlation[k];
+        d_correlation_normalized_magnitude = d_batch_magnitude[k];
+        if (detect_start_of_symbol()) {
+          return k;
+        }
+      }
+      d_on_triangle = false;
+      d_peak_set = false;
+      d_correlation_maximum = 0;
+      return -1;
+    }
+
     int
     ofdm_synchronization_cvf_impl::general_work(int noutput_items,
                                                 gr_vector_int &ninput_items,
@@ -178,12 +346,53 @@ namespace gr {
       const gr_complex *in = (const gr_complex *) input_items[0];
       gr_complex *out = (gr_complex *) output_items[0];
       d_nwritten = 0;
+      // batched correlation values of the last work call are not valid for this input buffer
+      d_batch_start = 0;
+      d_batch_end = 0;
 
       for (int i = 0; i < noutput_items; ++i) {
-        // just for measurement reasons
+        if (d_predict_frame) {
+          // frame tracking mode: skip the NULL symbol and check the predicted start of the next frame
+          uint64_t position = this->nitems_read(0) + i;
+          uint64_t window_start = d_frame_start + d_frame_length - d_search_window;
+          if (position < window_start) {
+            i += std::min<uint64_t>(window_start - position, noutput_items - i) - 1;
+            continue;
+          }
+          if (i + 2 * d_search_window >= noutput_items) {
+            // search window not completely in the input buffer
+            this->consume_each(i);
+            return d_nwritten;
+          }
+          d_predict_frame = false;
+          int offset = search_predicted_frame_start(&in[i]);
+          if (offset >= 0) {
+            // the first symbol of the next frame starts where we expected it
+            i += offset;
+            d_frequency_offset_per_sample = std::arg(d_correlation) / d_fft_length; // in rad/sample
+            d_symbol_element_count = 0;
+            d_symbol_count = 0;
+            d_NULL_detected = false;
+            frame_start_detected(this->nitems_read(0) + i);
+          } else {
+            // no peak at the predicted position -> search for next NULL symbol
+            GR_LOG_DEBUG(d_logger, "Lost frame track, switching to acquisition mode");
+            i += 2 * d_search_window;
+            d_frame_length = 0;
+            d_wait_for_NULL = true;
+          }
+          continue;
+        }
         if (d_wait_for_NULL) {
           // acquisition mode: search for next correlation peak after a NULL symbol
-          delayed_correlation(&in[i], false);
+          if (i < d_batch_start || i >= d_batch_end) {
+            // calculate the correlation for the next batch of samples at once
+            d_batch_start = i;
+            d_batch_end = std::min(i + d_batch_size, noutput_items);
+            batch_correlation(&in[i], d_batch_end - d_batch_start);
+          }
+          d_correlation = d_batch_correlation[i - d_batch_start];
+          d_correlation_normalized_magnitude = d_batch_magnitude[i - d_batch_start];
           if (detect_start_of_symbol()) {
             if (d_NULL_detected) {
               // calculate new frequency offset
@@ -196,6 +405,7 @@ namespace gr {
               d_symbol_count = 0;
               // reset NULL detector
               d_NULL_detected = false;
+              frame_start_detected(this->nitems_read(0) + i);
               // switch to tracking mode
               d_wait_for_NULL = false;
             } else {
@@ -203,7 +413,7 @@ namespace gr {
               d_NULL_detected = false;
             }
           } else {
-            if (((!d_NULL_detected) && (d_energy_prefix / d_energy_repetition < 0.4))) {
+            if (((!d_NULL_detected) && (d_batch_energy_ratio[i - d_batch_start] < 0.4))) {
               // NULL symbol detection, if energy is < 0.4 * energy a symbol time later
               d_NULL_detected = true;
             }
@@ -218,19 +428,25 @@ namespace gr {
             // check if we arrived at the next NULL symbol
             if (d_symbol_count >= d_symbols_per_frame) {
               d_symbol_count = 0;
-              //TODO: skip forward more to safe computing many computing steps
-              // switch to acquisition mode again to get the start of the next frame exactly
-              d_wait_for_NULL = true;
+              d_frame_complete = true;
+              if (d_frame_length > 0) {
+                // we know the frame length -> skip the NULL symbol
+                d_predict_frame = true;
+              } else {
+                // switch to acquisition mode again to get the start of the next frame exactly
+                d_wait_for_NULL = true;
+              }
             } else {
               // we expect the start of a new symbol here
               // correlation has to be calculated completely new, because of skipping samples before
-              delayed_correlation(&in[i], true);
+              delayed_correlation(&in[i]);
               // check if there is really a peak
               if (d_correlation_normalized_magnitude > 0.3) { //TODO: check if we are on right edge
                 d_frequency_offset_per_sample = std::arg(d_correlation) / d_fft_length; // in rad/sample
               } else {
                 // no peak found -> out of track; search for next NULL symbol
                 d_wait_for_NULL = true;
+                d_frame_length = 0;
                 GR_LOG_DEBUG(d_logger,
                              format("Lost track at %d, switching ot acquisition mode (%d)") %
                              d_symbol_count %
@@ -248,15 +464,27 @@ namespace gr {
                              static_cast<float>(d_cyclic_prefix_length *
                                                 d_frequency_offset_per_sample));
               if (d_symbol_count == 0) {
+                // a changed symbol mask is applied from the start of a frame on
+                {
+                  gr::thread::scoped_lock guard(d_setlock);
+                  d_symbol_mask = d_next_symbol_mask;
+                }
+                // the start tag carries the mask, so that the demux applies it to exactly this frame
                 this->add_item_tag(0, this->nitems_written(0) + d_nwritten + d_cyclic_prefix_length - d_symbol_element_count,
                                    pmt::mp("Start"),
-                                   pmt::from_float(std::arg(d_correlation)));
+                                   frame_start_tag_value(std::arg(d_correlation), d_symbol_mask));
+              }
+              if (d_symbol_count == 0 || d_symbol_mask.empty() || d_symbol_mask[d_symbol_count]) {
+                volk_32fc_s32fc_x2_rotator_32fc(
+                    &out[d_nwritten], &in[i],
+                    std::polar(float(1.0), d_frequency_offset_per_sample),
+                    &d_phase, d_symbol_length);
+                d_nwritten += d_symbol_length;
+              } else {
+                // symbol is not needed, only keep the phase of the frequency correction running
+                d_phase *= std::polar(float(1.0),
+                                      static_cast<float>(d_symbol_length * d_frequency_offset_per_sample));
               }
-              volk_32fc_s32fc_x2_rotator_32fc(
-                  &out[d_nwritten], &in[i],
-                  std::polar(float(1.0), d_frequency_offset_per_sample),
-                  &d_phase, d_symbol_length);
-              d_nwritten += d_symbol_length;
               d_symbol_element_count += d_symbol_length - 1;
               i += d_symbol_length - 1;
             }
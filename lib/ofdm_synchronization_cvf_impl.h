@@ -23,6 +23,7 @@
 #define INCLUDED_DAB_OFDM_SYNCHRONIZATION_CVF_IMPL_H
 
 #include <dab/ofdm_synchronization_cvf.h>
+#include <vector>
 
 namespace gr {
   namespace dab {
@@ -34,6 +35,7 @@ namespace gr {
  * \param cyclic_prefix_length Length of the cyclic prefix. (= length of the guard intervall)
  * \param fft_length Length of the FFT vector.
  * \param symbols_per_frame Number of OFDM symbols without the NULL symbol.
+ * \param symbol_mask Symbols of each frame which are written to the output, empty for all symbols.
  *
  */
     class ofdm_synchronization_cvf_impl : public ofdm_synchronization_cvf {
@@ -41,9 +43,6 @@ namespace gr {
       int d_symbol_length; /*!< Length of each OFDM symbol without guard intervall. */
       int d_cyclic_prefix_length; /*!< Length of the cyclic prefix. (= length of the guard intervall) */
       int d_fft_length; /*!< Length of the FFT vector.*/
-      int d_moving_average_counter;
-      /*!< Counts the number of steps the moving average did, to reset it
-       * from time to time to avoid value drifting caused by float rounding.*/
       gr_complex d_correlation;
       /*!< Fixed lag correlation (not normalized) with the lag length
        * equal to the cyclic prefix length.
@@ -58,11 +57,6 @@ namespace gr {
        * We write the calculated magnitued squared samples to this buffer to
        * accumulate them in the next step.
        */
-      gr_complex *d_fixed_lag_corr;
-      /*!< Allocated buffer for volk function.
-       * We write the calculated correlation samples to this buffer\
-       * accumulate them in the next step.
-       */
       float d_correlation_normalized_magnitude;
       /*!< Magnitude of the current fixed correlation value.*/
       float d_correlation_normalized_phase;
@@ -107,13 +101,71 @@ namespace gr {
        */
       int d_nwritten;
       /*!< Stores the number of items, we already wrote to the output buffer.*/
+      bool d_predict_frame;
+      /*!< Signalizes if we reached the end of a frame and skip forward to the
+       * predicted start of the next frame instead of searching the NULL symbol.
+       */
+      uint64_t d_frame_start;
+      /*!< Absolute position of the last detected start of a frame. */
+      int d_frame_length;
+      /*!< Measured distance in samples between the starts of two consecutive frames
+       * (including the NULL symbol). 0 if unknown.
+       */
+      bool d_frame_complete;
+      /*!< Signalizes if the last frame was tracked until its end, so that the
+       * next detected frame start measures the frame length.
+       */
+      int d_search_window;
+      /*!< Half width of the correlation window around the predicted frame start. */
+      int d_batch_size;
+      /*!< Maximum number of samples for which the correlation is calculated at once. */
+      int d_batch_start;
+      int d_batch_end;
+      /*!< Range of input items of the current work call covered by the batch buffers. */
+      gr_complex *d_lag_products;
+      /*!< Products of each sample with the conjugated sample symbol_length later. */
+      float *d_batch_mag_squared;
+      /*!< Energy of each sample of the batch and the following symbol_length samples. */
+      gr_complex *d_batch_correlation;
+      /*!< Fixed lag correlation of each sample of the batch (not normalized). */
+      float *d_batch_magnitude;
+      /*!< Normalized correlation magnitude of each sample of the batch. */
+      float *d_batch_energy_product;
+      /*!< Product of the energies of the cyclic prefix and its repetition, used for normalization. */
+      float *d_batch_energy_ratio;
+      /*!< Ratio of the energies of the cyclic prefix and its repetition, used for NULL symbol detection. */
+      std::vector<double> d_prefix_sums;
+      /*!< Prefix sums of the lagged products and energies, interleaved as four doubles per sample:
+       * real and imaginary part of the correlation, energy of the prefix and of its repetition.
+       */
+      bool d_avx; /*!< The prefix and window sums run with AVX on four doubles at a time. */
+      std::vector<unsigned char> d_symbol_mask;
+      /*!< Symbols of the current frame which are written to the output (empty for all symbols). */
+      std::vector<unsigned char> d_next_symbol_mask;
+      /*!< Symbol mask which is applied with the start of the next frame. */
 
       /*! \brief Calculates a fixed lag correlation over the given sample sequence.
        *
        * @param sample Pointer to the first sample of the sequence.
-       * @param new_calculation If true, calculated the correlation from scratch, else do a moving average.
        */
-      void delayed_correlation(const gr_complex *sample, bool new_calculation);
+      void delayed_correlation(const gr_complex *sample);
+
+      /*! \brief Calculates the fixed lag correlation for num consecutive samples at once.
+       * The lagged products and energies are calculated with VOLK, the sums over the
+       * cyclic prefix length come from prefix sums. The results are written to the batch buffers.
+       *
+       * @param sample Pointer to the first sample of the sequence.
+       * @param num Number of samples to calculate the correlation for (at most d_batch_size).
+       */
+      void batch_correlation(const gr_complex *sample, int num);
+
+      /*! \brief Prefix sums and windowed sums of batch_correlation() for num samples.
+       * The four sums of a sample are independent, the AVX version adds them with one
+       * instruction and gives bit exactly the same results as the scalar version.
+       */
+      void batch_sums(int num);
+
+      void batch_sums_avx(int num);
 
       /*! \brief Checks if we reached the maximum of a correlation triangle.
        * Peak detection with a very simple, a-causal method.
@@ -121,12 +173,26 @@ namespace gr {
        */
       bool detect_start_of_symbol();
 
+      /*! \brief Stores the position of a detected frame start and measures the frame length.
+       * @param position Absolute position of the start of the frame.
+       */
+      void frame_start_detected(uint64_t position);
+
+      /*! \brief Searches the correlation peak of the next frame around its predicted start.
+       * @param in Pointer to the first sample of the search window (2*d_search_window+1 samples).
+       * @return Offset of the detected start in the window or -1 if there was no peak.
+       */
+      int search_predicted_frame_start(const gr_complex *in);
+
     public:
       ofdm_synchronization_cvf_impl(int symbol_length, int cyclic_prefix_length,
-                                    int fft_length, int symbols_per_frame);
+                                    int fft_length, int symbols_per_frame,
+                                    const std::vector<unsigned char> &symbol_mask);
 
       ~ofdm_synchronization_cvf_impl();
 
+      void set_symbol_mask(const std::vector<unsigned char> &symbol_mask);
+
       void forecast(int noutput_items, gr_vector_int &ninput_items_required);
 
       // Where all the action really happens
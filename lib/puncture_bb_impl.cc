@@ -25,6 +25,12 @@
 
 #include <gnuradio/io_signature.h>
 #include "puncture_bb_impl.h"
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DAB_PUNCTURE_X86
+#include <immintrin.h>
+#endif
 
 namespace gr {
   namespace dab {
@@ -58,6 +64,27 @@ namespace gr {
       d_vlen_out = ones(puncturing_vector);
       set_output_multiple(d_vlen_out);
       set_relative_rate(static_cast<float>(d_vlen_out) / static_cast<float>(d_vlen_in));
+      for (unsigned int j = 0; j < d_vlen_in; j++) {
+        if (puncturing_vector[j] == 1)
+          d_gather.push_back(j);
+      }
+      for (unsigned int g = 0; g < d_vlen_in / 8; g++) {
+        uint64_t mask = 0;
+        unsigned char count = 0;
+        for (unsigned int k = 0; k < 8; k++) {
+          if (puncturing_vector[8 * g + k] == 1) {
+            mask |= (uint64_t) 0xff << (8 * k);
+            count++;
+          }
+        }
+        d_group_masks.push_back(mask);
+        d_group_counts.push_back(count);
+      }
+#ifdef DAB_PUNCTURE_X86
+      d_bmi2 = __builtin_cpu_supports("bmi2");
+#else
+      d_bmi2 = false;
+#endif
     }
 
     /*
@@ -66,6 +93,50 @@ namespace gr {
     puncture_bb_impl::~puncture_bb_impl() {
     }
 
+    void
+    puncture_bb_impl::compact_scalar(const unsigned char *in, unsigned char *out, int num_vectors) {
+      for (int i = 0; i < num_vectors; i++) {
+        for (unsigned int k = 0; k < d_vlen_out; k++) {
+          out[k] = in[d_gather[k]];
+        }
+        in += d_vlen_in;
+        out += d_vlen_out;
+      }
+    }
+
+#ifdef DAB_PUNCTURE_X86
+    __attribute__((target("bmi2"))) void
+    puncture_bb_impl::compact_bmi2(const unsigned char *in, unsigned char *out, int num_vectors) {
+      unsigned char *out_end = out + num_vectors * d_vlen_out;
+      const unsigned int num_groups = d_group_masks.size();
+      for (int i = 0; i < num_vectors; i++) {
+        const unsigned char *group = in;
+        const unsigned char *vector_out = out;
+        for (unsigned int g = 0; g < num_groups; g++, group += 8) {
+          uint64_t bytes;
+          memcpy(&bytes, group, 8);
+          bytes = _pext_u64(bytes, d_group_masks[g]);
+          // all 8 bytes are stored unless that would write behind the output
+          if (out + 8 <= out_end)
+            memcpy(out, &bytes, 8);
+          else
+            memcpy(out, &bytes, d_group_counts[g]);
+          out += d_group_counts[g];
+        }
+        // tail of the vector
+        for (unsigned int k = out - vector_out; k < d_vlen_out; k++) {
+          *out++ = in[d_gather[k]];
+        }
+        in += d_vlen_in;
+      }
+    }
+#else
+    void
+    puncture_bb_impl::compact_bmi2(const unsigned char *in, unsigned char *out, int num_vectors) {
+      compact_scalar(in, out, num_vectors);
+    }
+#endif
+
     void
     puncture_bb_impl::forecast(int noutput_items,
                                gr_vector_int &ninput_items_required) {
@@ -80,12 +151,10 @@ namespace gr {
       const unsigned char *in = (const unsigned char *) input_items[0];
       unsigned char *out = (unsigned char *) output_items[0];
 
-      for (int i = 0; i < noutput_items * d_vlen_in / d_vlen_out; i++) {
-        if (d_puncturing_vector[i % d_vlen_in] == 1)
-          *out++ = *in++;
-        else
-          in++;
-      }
+      if (d_bmi2)
+        compact_bmi2(in, out, noutput_items / d_vlen_out);
+      else
+        compact_scalar(in, out, noutput_items / d_vlen_out);
       // Tell runtime system how many input items we consumed on
       // each input stream.
       consume_each(noutput_items * d_vlen_in / d_vlen_out);
@@ -22,6 +22,7 @@
 #define INCLUDED_DAB_PUNCTURE_BB_IMPL_H
 
 #include <dab/puncture_bb.h>
+#include <stdint.h>
 
 namespace gr {
   namespace dab {
@@ -31,14 +32,24 @@ namespace gr {
  *
  * @param puncturing_vector vector with puncturing sequence, length of puncturing_vector is length of a input stream sequence
  *
+ * The kept elements are gathered through a precomputed index table. If the CPU supports BMI2,
+ * each group of 8 input bytes is compacted with one pext instruction.
  */
     class puncture_bb_impl : public puncture_bb {
     private:
       unsigned int ones(const std::vector<unsigned char> &puncturing_vector);
 
+      void compact_scalar(const unsigned char *in, unsigned char *out, int num_vectors);
+
+      void compact_bmi2(const unsigned char *in, unsigned char *out, int num_vectors);
+
       std::vector<unsigned char> d_puncturing_vector;
       unsigned int d_vlen_in;
       unsigned int d_vlen_out;
+      std::vector<unsigned int> d_gather; // input position of each output element
+      std::vector<uint64_t> d_group_masks; // byte masks of the kept elements of each group of 8 inputs
+      std::vector<unsigned char> d_group_counts; // number of kept elements of each group of 8 inputs
+      bool d_bmi2;
 
     public:
       puncture_bb_impl(const std::vector<unsigned char> &puncturing_vector);
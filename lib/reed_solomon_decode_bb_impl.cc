@@ -53,63 +53,29 @@ namespace gr {
             : gr::block("reed_solomon_decode_bb",
                         gr::io_signature::make(1, 1, sizeof(unsigned char)),
                         gr::io_signature::make(1, 1, sizeof(unsigned char))),
-              d_bit_rate_n(bit_rate_n) {
-      rs_handle = init_rs_char(8, 0x11D, 0, 1, 10, 135);
-      if (!rs_handle) {
-        GR_LOG_DEBUG(d_logger, "RS init failed");
-      } else {
-        GR_LOG_DEBUG(d_logger, "RS init succeeded");
-      }
+              d_superframe_start_key(pmt::intern("superframe_start")),
+              d_bit_rate_n_key(pmt::intern("bit_rate_n")),
+              d_reconfigured_at(~(uint64_t) 0) {
+      set_bit_rate_n(bit_rate_n);
+      set_tag_propagation_policy(TPP_DONT);
+      d_corrected_errors = 0;
+    }
+
+    void
+    reed_solomon_decode_bb_impl::set_bit_rate_n(int bit_rate_n) {
+      d_bit_rate_n = bit_rate_n;
+      d_decoder.reset(new rs_superframe_decoder(bit_rate_n));
       d_superframe_size = bit_rate_n * 120;
       d_superframe_size_rs = bit_rate_n * 110;
       set_output_multiple(d_superframe_size_rs);
-      d_corrected_errors = 0;
     }
 
     /*
      * Our virtual destructor.
      */
     reed_solomon_decode_bb_impl::~reed_solomon_decode_bb_impl() {
-      free_rs_char(rs_handle);
-    }
-
-    void
-    reed_solomon_decode_bb_impl::DecodeSuperframe(uint8_t *sf, size_t sf_len) {
-//	// insert errors for test
-//	sf[0] ^= 0xFF;
-//	sf[10] ^= 0xFF;
-//	sf[20] ^= 0xFF;
-
-      int subch_index = sf_len / 120;
-      int total_corr_count = 0;
-      bool uncorr_errors = false;
-
-      // process all RS packets
-      for (int i = 0; i < subch_index; i++) {
-        for (int pos = 0; pos < 120; pos++) {
-          rs_packet[pos] = sf[pos * subch_index + i];
-        }
-        // detect errors
-        int corr_count = decode_rs_char(rs_handle, rs_packet, corr_pos, 0);
-        if (corr_count == -1) {
-          uncorr_errors = true;
-          GR_LOG_DEBUG(d_logger, "uncorrectable error");
-        } else
-          total_corr_count += corr_count;
-
-        // correct errors
-        for (int j = 0; j < corr_count; j++) {
-
-          int pos = corr_pos[j] - 135;
-          if (pos < 0)
-            continue;
-          sf[pos * subch_index + i] = rs_packet[pos];
-        }
-      }
-      d_corrected_errors = total_corr_count;
     }
 
-
     void
     reed_solomon_decode_bb_impl::forecast(int noutput_items,
                                           gr_vector_int &ninput_items_required) {
@@ -124,18 +90,66 @@ namespace gr {
       const unsigned char *in = (const unsigned char *) input_items[0];
       unsigned char *out = (unsigned char *) output_items[0];
 
-      for (int n = 0; n < noutput_items / d_superframe_size_rs; n++) {
-        uint8_t superframe[d_superframe_size];
-        memcpy(superframe, &in[n * d_superframe_size], d_superframe_size);
-        DecodeSuperframe(superframe, d_superframe_size);
-        memcpy(&out[n * d_superframe_size_rs], superframe, d_superframe_size_rs);
+      const uint64_t nread = nitems_read(0);
+      int nconsumed = 0;
+      int nproduced = 0;
+
+      // superframe starts found by the superframe synchronization (firecode_check_bb)
+      std::vector<gr::tag_t> tags;
+      unsigned int tag_count = 0;
+      get_tags_in_window(tags, 0, 0, ninput_items[0], d_superframe_start_key);
+      // new data rates of a retuned sub-channel
+      std::vector<gr::tag_t> rates;
+      unsigned int rate_count = 0;
+      get_tags_in_window(rates, 0, 0, ninput_items[0], d_bit_rate_n_key);
+
+      while (true) {
+        while (rate_count < rates.size() && (rates[rate_count].offset < nread + nconsumed ||
+                                             rates[rate_count].offset == d_reconfigured_at)) {
+          rate_count++;
+        }
+        if (rate_count < rates.size()) {
+          const gr::tag_t &rate = rates[rate_count];
+          if (rate.offset == nread + nconsumed) {
+            GR_LOG_DEBUG(d_logger, format("new sub-channel with bit_rate_n %d") % pmt::to_long(rate.value));
+            d_reconfigured_at = rate.offset;
+            set_bit_rate_n(pmt::to_long(rate.value));
+            add_item_tag(0, nitems_written(0) + nproduced, d_bit_rate_n_key, rate.value);
+            continue;
+          }
+          if (rate.offset < nread + nconsumed + d_superframe_size) {
+            // drop the incomplete superframe of the old sub-channel
+            nconsumed = rate.offset - nread;
+            continue;
+          }
+        }
+        if (nproduced + d_superframe_size_rs > noutput_items || nconsumed + d_superframe_size > ninput_items[0])
+          break;
+        while (tag_count < tags.size() && tags[tag_count].offset < nread + nconsumed) {
+          tag_count++;
+        }
+        bool tagged = tag_count < tags.size() && tags[tag_count].offset == nread + nconsumed;
+        if (!tagged && tag_count < tags.size() && tags[tag_count].offset < nread + nconsumed + d_superframe_size) {
+          // the superframe sync moved, drop the bytes before the next superframe start
+          nconsumed = tags[tag_count].offset - nread;
+          continue;
+        }
+        if (tagged) {
+          add_item_tag(0, nitems_written(0) + nproduced, d_superframe_start_key, tags[tag_count].value);
+        }
+        d_corrected_errors = d_decoder->decode(&in[nconsumed], &out[nproduced]);
+        if (d_decoder->uncorrectable()) {
+          GR_LOG_DEBUG(d_logger, "uncorrectable error");
+        }
+        nconsumed += d_superframe_size;
+        nproduced += d_superframe_size_rs;
       }
       // Tell runtime system how many input items we consumed on
       // each input stream.
-      consume_each(noutput_items * 120 / 110);
+      consume_each(nconsumed);
 
       // Tell runtime system how many output items we produced.
-      return noutput_items;
+      return nproduced;
     }
 
   } /* namespace dab */
@@ -28,10 +28,8 @@
 #define INCLUDED_DAB_REED_SOLOMON_DECODE_BB_IMPL_H
 
 #include <dab/reed_solomon_decode_bb.h>
-
-extern "C" {
-#include "fec/fec.h"
-}
+#include <boost/shared_ptr.hpp>
+#include "rs_superframe_decoder.h"
 
 namespace gr {
   namespace dab {
@@ -39,6 +37,11 @@ namespace gr {
  *
  * Reed Solomon RS(120, 110, t=5) with virtual interleaving; derived from RS(255, 245, t=5). Details see ETSI TS 102 563 clause 6.0 and 6.1.
  *
+ * If the input carries "superframe_start" tags (see firecode_check_bb), the decoder
+ * aligns to them and drops the bytes of incomplete superframes, otherwise the superframes
+ * are counted from the first input byte. The tags are passed on to the output.
+ * A "bit_rate_n" tag (see firecode_check_bb) replaces the decoder by one for the new data rate.
+ *
  * @param bit_rate_n data rate in multiples of 8kbit/s
  *
  */
@@ -47,12 +50,13 @@ namespace gr {
       int d_bit_rate_n;
       int d_superframe_size; /*!< size of a superframe in byte with rs code words*/
       int d_superframe_size_rs; /*!< size of a superframe in byte without rs code words*/
-      void *rs_handle;
-      uint8_t rs_packet[120]; /*!< buffer for rs algorithm*/
-      int corr_pos[10]; /*!< positions of detected and correctable errors*/
+      boost::shared_ptr<rs_superframe_decoder> d_decoder;
       int d_corrected_errors; /*!< number of corrected errors in the current superframe*/
+      pmt::pmt_t d_superframe_start_key;
+      pmt::pmt_t d_bit_rate_n_key;
+      uint64_t d_reconfigured_at; /*!< offset of the last "bit_rate_n" tag that was applied*/
 
-      void DecodeSuperframe(uint8_t *sf, size_t sf_len);
+      void set_bit_rate_n(int bit_rate_n);
 
     public:
       reed_solomon_decode_bb_impl(int bit_rate_n);
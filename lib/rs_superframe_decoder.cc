@@ -0,0 +1,228 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "rs_superframe_decoder.h"
+#include <stdexcept>
+#include <string.h>
+
+extern "C" {
+#include "fec/fec.h"
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define DAB_RS_X86
+#include <immintrin.h>
+#endif
+
+namespace gr {
+  namespace dab {
+
+    namespace {
+      // the code of ETSI TS 102 563: field polynomial x^8+x^4+x^3+x^2+1, roots alpha^0 to alpha^9
+      const int FIELD_POLY = 0x11D;
+      const int FIRST_ROOT = 0;
+      const int ROOT_STEP = 1;
+      const int SHORTENING = 255 - rs_superframe_decoder::CODEWORD_LENGTH;
+      const int DATA_LENGTH = rs_superframe_decoder::CODEWORD_LENGTH - rs_superframe_decoder::PARITY_LENGTH;
+
+      /*! Products with the roots of the generator polynomial: full tables and tables per nibble. */
+      struct root_tables {
+        uint8_t mul[rs_superframe_decoder::PARITY_LENGTH][256];
+        uint8_t lo[rs_superframe_decoder::PARITY_LENGTH][16];
+        uint8_t hi[rs_superframe_decoder::PARITY_LENGTH][16];
+
+        static uint8_t gf_mul(int a, int b) {
+          int p = 0;
+          for (; b; b >>= 1) {
+            if (b & 1)
+              p ^= a;
+            a <<= 1;
+            if (a & 0x100)
+              a ^= FIELD_POLY;
+          }
+          return (uint8_t) p;
+        }
+
+        root_tables() {
+          int root = 1;
+          for (int k = 0; k < rs_superframe_decoder::PARITY_LENGTH; k++) {
+            for (int x = 0; x < 256; x++)
+              mul[k][x] = gf_mul(root, x);
+            for (int x = 0; x < 16; x++) {
+              lo[k][x] = mul[k][x];
+              hi[k][x] = mul[k][x << 4];
+            }
+            root = gf_mul(root, 2);
+          }
+        }
+      };
+
+      const root_tables ROOTS;
+
+      /*! Syndromes of the codewords [first, last) of the superframe, returns a nonzero value per erroneous codeword. */
+      void
+      syndromes_generic(const uint8_t *in, int stride, int first, int last, uint8_t *error) {
+        for (int i = first; i < last; i++) {
+          uint8_t s[rs_superframe_decoder::PARITY_LENGTH] = {0};
+          for (int pos = 0; pos < rs_superframe_decoder::CODEWORD_LENGTH; pos++) {
+            uint8_t d = in[pos * stride + i];
+            for (int k = 0; k < rs_superframe_decoder::PARITY_LENGTH; k++)
+              s[k] = ROOTS.mul[k][s[k]] ^ d;
+          }
+          uint8_t any = 0;
+          for (int k = 0; k < rs_superframe_decoder::PARITY_LENGTH; k++)
+            any |= s[k];
+          error[i] = any;
+        }
+      }
+
+#ifdef DAB_RS_X86
+      __attribute__((target("ssse3"))) int
+      syndromes_ssse3(const uint8_t *in, int stride, int first, int last, uint8_t *error) {
+        const __m128i nibble = _mm_set1_epi8(0x0f);
+        int i = first;
+        for (; i + 16 <= last; i += 16) {
+          __m128i s[rs_superframe_decoder::PARITY_LENGTH];
+          for (int k = 0; k < rs_superframe_decoder::PARITY_LENGTH; k++)
+            s[k] = _mm_setzero_si128();
+          for (int pos = 0; pos < rs_superframe_decoder::CODEWORD_LENGTH; pos++) {
+            __m128i d = _mm_loadu_si128((const __m128i *) (in + pos * stride + i));
+            // the first root is 1
+            s[0] = _mm_xor_si128(s[0], d);
+            for (int k = 1; k < rs_superframe_decoder::PARITY_LENGTH; k++) {
+              __m128i l = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) ROOTS.lo[k]),
+                                           _mm_and_si128(s[k], nibble));
+              __m128i h = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) ROOTS.hi[k]),
+                                           _mm_and_si128(_mm_srli_epi16(s[k], 4), nibble));
+              s[k] = _mm_xor_si128(_mm_xor_si128(l, h), d);
+            }
+          }
+          __m128i any = s[0];
+          for (int k = 1; k < rs_superframe_decoder::PARITY_LENGTH; k++)
+            any = _mm_or_si128(any, s[k]);
+          _mm_storeu_si128((__m128i *) (error + i), any);
+        }
+        return i;
+      }
+
+      __attribute__((target("avx2"))) int
+      syndromes_avx2(const uint8_t *in, int stride, int first, int last, uint8_t *error) {
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        __m256i lo[rs_superframe_decoder::PARITY_LENGTH], hi[rs_superframe_decoder::PARITY_LENGTH];
+        for (int k = 1; k < rs_superframe_decoder::PARITY_LENGTH; k++) {
+          lo[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) ROOTS.lo[k]));
+          hi[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) ROOTS.hi[k]));
+        }
+        int i = first;
+        for (; i + 32 <= last; i += 32) {
+          __m256i s[rs_superframe_decoder::PARITY_LENGTH];
+          for (int k = 0; k < rs_superframe_decoder::PARITY_LENGTH; k++)
+            s[k] = _mm256_setzero_si256();
+          for (int pos = 0; pos < rs_superframe_decoder::CODEWORD_LENGTH; pos++) {
+            __m256i d = _mm256_loadu_si256((const __m256i *) (in + pos * stride + i));
+            s[0] = _mm256_xor_si256(s[0], d);
+            for (int k = 1; k < rs_superframe_decoder::PARITY_LENGTH; k++) {
+              __m256i l = _mm256_shuffle_epi8(lo[k], _mm256_and_si256(s[k], nibble));
+              __m256i h = _mm256_shuffle_epi8(hi[k], _mm256_and_si256(_mm256_srli_epi16(s[k], 4), nibble));
+              s[k] = _mm256_xor_si256(_mm256_xor_si256(l, h), d);
+            }
+          }
+          __m256i any = s[0];
+          for (int k = 1; k < rs_superframe_decoder::PARITY_LENGTH; k++)
+            any = _mm256_or_si256(any, s[k]);
+          _mm256_storeu_si256((__m256i *) (error + i), any);
+        }
+        return i;
+      }
+#endif
+    }
+
+    rs_superframe_decoder::rs_superframe_decoder(int bit_rate_n)
+            : d_bit_rate_n(bit_rate_n),
+              d_uncorrectable(0),
+              d_syndrome_error(bit_rate_n > 0 ? bit_rate_n : 0),
+              d_tail(CODEWORD_LENGTH * TAIL_LANES, 0) {
+      if (bit_rate_n <= 0)
+        throw std::invalid_argument("rs_superframe_decoder: bit_rate_n must be positive");
+      d_rs_handle = init_rs_char(8, FIELD_POLY, FIRST_ROOT, ROOT_STEP, PARITY_LENGTH, SHORTENING);
+      if (!d_rs_handle)
+        throw std::runtime_error("rs_superframe_decoder: RS init failed");
+    }
+
+    rs_superframe_decoder::~rs_superframe_decoder() {
+      free_rs_char(d_rs_handle);
+    }
+
+    void
+    rs_superframe_decoder::check_syndromes(const uint8_t *in) {
+      const int n = d_bit_rate_n;
+      int i = 0;
+#ifdef DAB_RS_X86
+      if (__builtin_cpu_supports("avx2"))
+        i = syndromes_avx2(in, n, i, n, &d_syndrome_error[0]);
+      if (__builtin_cpu_supports("ssse3")) {
+        i = syndromes_ssse3(in, n, i, n, &d_syndrome_error[0]);
+        if (i < n) {
+          // less than 16 codewords left: copy them into zero padded rows of 16 lanes
+          const int rest = n - i;
+          for (int pos = 0; pos < CODEWORD_LENGTH; pos++)
+            memcpy(&d_tail[pos * TAIL_LANES], in + pos * n + i, rest);
+          uint8_t error[TAIL_LANES];
+          syndromes_ssse3(&d_tail[0], TAIL_LANES, 0, TAIL_LANES, error);
+          memcpy(&d_syndrome_error[i], error, rest);
+          i = n;
+        }
+      }
+#endif
+      syndromes_generic(in, n, i, n, &d_syndrome_error[0]);
+    }
+
+    int
+    rs_superframe_decoder::decode(const uint8_t *in, uint8_t *out) {
+      const int n = d_bit_rate_n;
+      // the data bytes are the first 110 rows of the interleaved superframe
+      memcpy(out, in, DATA_LENGTH * n);
+      check_syndromes(in);
+
+      int corrected = 0;
+      d_uncorrectable = 0;
+      for (int i = 0; i < n; i++) {
+        if (!d_syndrome_error[i])
+          continue;
+        for (int pos = 0; pos < CODEWORD_LENGTH; pos++)
+          d_packet[pos] = in[pos * n + i];
+        int count = decode_rs_char(d_rs_handle, d_packet, d_corr_pos, 0);
+        if (count < 0) {
+          d_uncorrectable++;
+          continue;
+        }
+        corrected += count;
+        for (int j = 0; j < count; j++) {
+          // error positions are counted in the unshortened codeword
+          int pos = d_corr_pos[j] - SHORTENING;
+          if (pos >= 0 && pos < DATA_LENGTH)
+            out[pos * n + i] = d_packet[pos];
+        }
+      }
+      return corrected;
+    }
+
+  }
+}
@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_RS_SUPERFRAME_DECODER_H
+#define INCLUDED_DAB_RS_SUPERFRAME_DECODER_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief Reed-Solomon decoder for the superframes of a DAB+ sub-channel.
+ *
+ * A superframe of a sub-channel with bit_rate_n * 8 kbit/s holds bit_rate_n
+ * RS(120, 110, t=5) codewords, shortened from RS(255, 245) and byte interleaved:
+ * byte pos of codeword i is at position pos * bit_rate_n + i (ETSI TS 102 563 clause 6).
+ *
+ * Neighbouring codewords are in neighbouring bytes, so the syndromes of all codewords
+ * are computed at once, one codeword per byte lane (AVX2 or SSSE3 if the CPU supports it).
+ * The multiplication with the constant roots of the generator polynomial is a lookup
+ * of both nibbles in 16 entry tables. Only codewords with a nonzero syndrome go through
+ * the Berlekamp-Massey and Chien search of the KA9Q decoder.
+ */
+    class rs_superframe_decoder {
+    public:
+      /*!
+       * @param bit_rate_n Number of codewords per superframe (data rate in multiples of 8 kbit/s).
+       */
+      rs_superframe_decoder(int bit_rate_n);
+
+      ~rs_superframe_decoder();
+
+      /*! Number of parity bytes per codeword. */
+      static const int PARITY_LENGTH = 10;
+      /*! Length of a codeword. */
+      static const int CODEWORD_LENGTH = 120;
+
+      /*! \brief Decodes one superframe.
+       *
+       * @param in 120 * bit_rate_n bytes of the superframe with the parity bytes.
+       * @param out 110 * bit_rate_n corrected bytes of the superframe without the parity bytes.
+       * @return Number of corrected bytes.
+       */
+      int decode(const uint8_t *in, uint8_t *out);
+
+      /*! Number of codewords with uncorrectable errors in the last superframe. */
+      int uncorrectable() const { return d_uncorrectable; }
+
+      int bit_rate_n() const { return d_bit_rate_n; }
+
+    private:
+      // holds the KA9Q decoder handle, not copyable
+      rs_superframe_decoder(const rs_superframe_decoder &);
+
+      rs_superframe_decoder &operator=(const rs_superframe_decoder &);
+
+      /*! Sets d_syndrome_error[i] to a nonzero value if codeword i has a nonzero syndrome. */
+      void check_syndromes(const uint8_t *in);
+
+      /*! Number of lanes of the SSSE3 syndrome computation. */
+      static const int TAIL_LANES = 16;
+
+      int d_bit_rate_n;
+      void *d_rs_handle;
+      int d_uncorrectable;
+      std::vector<uint8_t> d_syndrome_error;
+      std::vector<uint8_t> d_tail;
+      /*!< The last codewords of the superframe in rows of TAIL_LANES bytes, the other lanes stay zero. */
+      uint8_t d_packet[CODEWORD_LENGTH];
+      int d_corr_pos[PARITY_LENGTH];
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_RS_SUPERFRAME_DECODER_H */
@@ -47,10 +47,7 @@ namespace gr {
             : gr::block("select_cus_vfvf",
                         gr::io_signature::make(1, 1, vlen * sizeof(float)),
                         gr::io_signature::make(1, 1, vlen * sizeof(float))),
-              d_vlen(vlen),
-              d_frame_len(frame_len),
-              d_address(address),
-              d_size(size) {
+              d_selector(vlen * sizeof(float), frame_len, address, size) {
     }
 
     /*
@@ -70,17 +67,8 @@ namespace gr {
                                        gr_vector_int &ninput_items,
                                        gr_vector_const_void_star &input_items,
                                        gr_vector_void_star &output_items) {
-      const float *in = (const float *) input_items[0];
-      float *out = (float *) output_items[0];
-      unsigned int nwritten = 0;
-
-      for (int i = 0; i < noutput_items; ++i) {
-        if (d_address <= (nitems_read(0) + i) % d_frame_len &&
-            (nitems_read(0) + i) % d_frame_len < d_address + d_size) {
-          //this cu is one of the selected subchannel -> copy it to ouput buffer
-          memcpy(&out[nwritten++ * d_vlen], &in[i * d_vlen], d_vlen * sizeof(float));
-        }
-      }
+      unsigned int nwritten = d_selector.select((const char *) input_items[0], (char *) output_items[0],
+                                                noutput_items);
       // Tell runtime system how many input items we consumed on
       // each input stream.
       consume_each(noutput_items);
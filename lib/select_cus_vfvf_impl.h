@@ -22,6 +22,7 @@
 #define INCLUDED_DAB_SELECT_CUS_VFVF_IMPL_H
 
 #include <dab/select_cus_vfvf.h>
+#include "cu_selector.h"
 
 namespace gr {
   namespace dab {
@@ -38,10 +39,7 @@ namespace gr {
  */
     class select_cus_vfvf_impl : public select_cus_vfvf {
     private:
-      unsigned int d_vlen;
-      unsigned int d_frame_len;
-      unsigned int d_address;
-      unsigned int d_size;
+      cu_selector d_selector;
 
     public:
       select_cus_vfvf_impl(unsigned int vlen, unsigned int frame_len,
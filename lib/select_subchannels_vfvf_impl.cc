@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include "select_subchannels_vfvf_impl.h"
+
+namespace gr {
+  namespace dab {
+
+    select_subchannels_vfvf::sptr
+    select_subchannels_vfvf::make(unsigned int vlen, unsigned int frame_len,
+                                  const std::vector<unsigned int> &addresses,
+                                  const std::vector<unsigned int> &sizes) {
+      return gnuradio::get_initial_sptr(new select_subchannels_vfvf_impl(vlen, frame_len, addresses, sizes));
+    }
+
+    /*
+     * The private constructor
+     */
+    select_subchannels_vfvf_impl::select_subchannels_vfvf_impl(unsigned int vlen,
+                                                               unsigned int frame_len,
+                                                               const std::vector<unsigned int> &addresses,
+                                                               const std::vector<unsigned int> &sizes)
+            : gr::block("select_subchannels_vfvf",
+                        gr::io_signature::make(1, 1, vlen * sizeof(float)),
+                        gr::io_signature::make(addresses.size(), addresses.size(), vlen * sizeof(float))) {
+      if (addresses.empty() || sizes.size() != addresses.size())
+        throw std::invalid_argument((boost::format("got %d addresses and %d sizes")
+                                     % addresses.size() % sizes.size()).str());
+      for (unsigned int s = 0; s < addresses.size(); s++) {
+        if (addresses[s] + sizes[s] > frame_len)
+          throw std::invalid_argument((boost::format("sub-channel (address %d, size %d) exceeds the frame length %d")
+                                       % addresses[s] % sizes[s] % frame_len).str());
+        d_selectors.push_back(cu_selector(vlen * sizeof(float), frame_len, addresses[s], sizes[s]));
+      }
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    select_subchannels_vfvf_impl::~select_subchannels_vfvf_impl() {
+    }
+
+    void
+    select_subchannels_vfvf_impl::forecast(int noutput_items,
+                                           gr_vector_int &ninput_items_required) {
+      ninput_items_required[0] = noutput_items;
+    }
+
+    int
+    select_subchannels_vfvf_impl::general_work(int noutput_items,
+                                               gr_vector_int &ninput_items,
+                                               gr_vector_const_void_star &input_items,
+                                               gr_vector_void_star &output_items) {
+      // no output gets more items than are consumed
+      const int nconsume = std::min(noutput_items, ninput_items[0]);
+      for (unsigned int s = 0; s < d_selectors.size(); s++) {
+        // Tell runtime system how many output items we produced on this output.
+        produce(s, d_selectors[s].select((const char *) input_items[0], (char *) output_items[s], nconsume));
+      }
+      // Tell runtime system how many input items we consumed on
+      // each input stream.
+      consume_each(nconsume);
+
+      return WORK_CALLED_PRODUCE;
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
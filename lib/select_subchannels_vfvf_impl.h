@@ -0,0 +1,64 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_SELECT_SUBCHANNELS_VFVF_IMPL_H
+#define INCLUDED_DAB_SELECT_SUBCHANNELS_VFVF_IMPL_H
+
+#include <dab/select_subchannels_vfvf.h>
+#include "cu_selector.h"
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief Selects the items of several sub-channels out of a stream of frames.
+ *
+ * Each output has a cu_selector (as select_cus_vfvf), which keeps the position
+ * in the current frame and copies the part of each frame that lies in the range
+ * of its sub-channel with one memcpy.
+ *
+ * @param vlen Vector size of input and output vectors.
+ * @param frame_len Length in items of a frame.
+ * @param addresses Number of the first item in each frame of each sub-channel.
+ * @param sizes Number of items in each frame of each sub-channel.
+ */
+    class select_subchannels_vfvf_impl : public select_subchannels_vfvf {
+    private:
+      std::vector<cu_selector> d_selectors; // one per sub-channel
+
+    public:
+      select_subchannels_vfvf_impl(unsigned int vlen, unsigned int frame_len,
+                                   const std::vector<unsigned int> &addresses,
+                                   const std::vector<unsigned int> &sizes);
+
+      ~select_subchannels_vfvf_impl();
+
+      // Where all the action really happens
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_SELECT_SUBCHANNELS_VFVF_IMPL_H */
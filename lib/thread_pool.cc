@@ -0,0 +1,97 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "thread_pool.h"
+#include <boost/bind.hpp>
+
+namespace gr {
+  namespace dab {
+
+    thread_pool::thread_pool(unsigned int num_threads)
+            : d_task(0),
+              d_next_task(0),
+              d_num_tasks(0),
+              d_pending(0),
+              d_stop(false) {
+      if (num_threads == 0)
+        num_threads = gr::thread::thread::hardware_concurrency();
+      d_num_workers = num_threads > 1 ? num_threads - 1 : 0;
+      for (unsigned int i = 0; i < d_num_workers; i++) {
+        d_workers.create_thread(boost::bind(&thread_pool::worker, this));
+      }
+    }
+
+    thread_pool::~thread_pool() {
+      {
+        gr::thread::scoped_lock lock(d_mutex);
+        d_stop = true;
+      }
+      d_work_available.notify_all();
+      d_workers.join_all();
+    }
+
+    void
+    thread_pool::execute(gr::thread::scoped_lock &lock) {
+      // takes tasks until none is left, the lock is released while a task runs
+      while (d_next_task < d_num_tasks) {
+        unsigned int t = d_next_task++;
+        lock.unlock();
+        (*d_task)(t);
+        lock.lock();
+        if (--d_pending == 0)
+          d_work_done.notify_all();
+      }
+    }
+
+    void
+    thread_pool::worker() {
+      gr::thread::scoped_lock lock(d_mutex);
+      while (true) {
+        while (!d_stop && d_next_task >= d_num_tasks)
+          d_work_available.wait(lock);
+        if (d_stop)
+          return;
+        execute(lock);
+      }
+    }
+
+    void
+    thread_pool::run(unsigned int num_tasks, const boost::function<void(unsigned int)> &task) {
+      if (d_num_workers == 0 || num_tasks < 2) {
+        for (unsigned int t = 0; t < num_tasks; t++)
+          task(t);
+        return;
+      }
+      gr::thread::scoped_lock lock(d_mutex);
+      d_task = &task;
+      d_next_task = 0;
+      d_num_tasks = num_tasks;
+      d_pending = num_tasks;
+      d_work_available.notify_all();
+      execute(lock);
+      while (d_pending > 0)
+        d_work_done.wait(lock);
+      d_task = 0;
+      d_num_tasks = 0;
+      d_next_task = 0;
+    }
+
+  }
+}
@@ -0,0 +1,70 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_THREAD_POOL_H
+#define INCLUDED_DAB_THREAD_POOL_H
+
+#include <gnuradio/thread/thread.h>
+#include <gnuradio/thread/thread_group.h>
+#include <boost/function.hpp>
+
+namespace gr {
+  namespace dab {
+/*! \brief Fixed set of worker threads for data parallel loops inside a block.
+ *
+ * run() distributes the tasks 0..num_tasks-1 to the workers and the calling
+ * thread, which takes tasks as well, and returns when all of them are done.
+ * Tasks are handed out in ascending order, so long tasks should come first.
+ *
+ * @param num_threads Total number of threads including the calling one,
+ * 0 for one per CPU core.
+ */
+    class thread_pool {
+    public:
+      explicit thread_pool(unsigned int num_threads);
+
+      ~thread_pool();
+
+      void run(unsigned int num_tasks, const boost::function<void(unsigned int)> &task);
+
+      /*! Number of threads working on a run() including the calling one. */
+      unsigned int num_threads() const { return d_num_workers + 1; }
+
+    private:
+      void worker();
+
+      void execute(gr::thread::scoped_lock &lock);
+
+      unsigned int d_num_workers;
+      gr::thread::thread_group d_workers;
+      gr::thread::mutex d_mutex;
+      gr::thread::condition_variable d_work_available;
+      gr::thread::condition_variable d_work_done;
+      const boost::function<void(unsigned int)> *d_task;
+      unsigned int d_next_task;
+      unsigned int d_num_tasks;
+      unsigned int d_pending;
+      bool d_stop;
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_THREAD_POOL_H */
@@ -42,12 +42,7 @@ namespace gr {
             : gr::sync_block("time_deinterleave_ff",
                              gr::io_signature::make(1, 1, sizeof(float)),
                              gr::io_signature::make(1, 1, sizeof(float))),
-              d_vector_length(vector_length),
-              d_scrambling_vector(scrambling_vector) {
-      d_scrambling_length = scrambling_vector.size(); // size of the scrambling vector
-      set_output_multiple(d_vector_length);
-      // set history (need for max delay of (scrambling_length-1) * 24ms)
-      set_history((d_scrambling_length - 1) * d_vector_length + 1);
+              d_deinterleaver(vector_length, scrambling_vector) {
     }
 
     /*
@@ -63,13 +58,7 @@ namespace gr {
       const float *in = (const float *) input_items[0];
       float *out = (float *) output_items[0];
 
-      for (int i = 0; i < noutput_items / d_vector_length; i++) {
-        // produce output vectors
-        for (int j = 0; j < d_vector_length; j++) {
-          *out++ = in[d_vector_length * (i + (d_scrambling_length - 1) - ((d_scrambling_length - 1) -
-                      d_scrambling_vector[j % d_scrambling_length])) + j];
-        }
-      }
+      d_deinterleaver.deinterleave(in, out, noutput_items);
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
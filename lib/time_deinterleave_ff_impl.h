@@ -22,6 +22,7 @@
 #define INCLUDED_DAB_TIME_DEINTERLEAVE_FF_IMPL_H
 
 #include <dab/time_deinterleave_ff.h>
+#include "time_deinterleaver.h"
 
 namespace gr {
   namespace dab {
@@ -31,6 +32,8 @@ namespace gr {
  * Applies convolutional deinterleaving to a vector with its max[vector_length] followers,
  * the scrambling_vector describes which vector element comes from which follower.
  * Delays the elements of a max delay of d_scrambling_length-1.
+ * The ring of CIF slots is kept by time_deinterleaver, so no history is
+ * needed and work() accepts any number of items.
  * More information to the interleaving rules on ETSI EN 300 401 chapter 12.
  * This deinterleaver restores a bitstream interleaved by the block time_interleave_bb.
  *
@@ -42,8 +45,7 @@ namespace gr {
     class time_deinterleave_ff_impl : public time_deinterleave_ff {
 
     private:
-      int d_scrambling_length, d_vector_length;
-      std::vector<unsigned char> d_scrambling_vector;
+      time_deinterleaver<float> d_deinterleaver;
 
     public:
       time_deinterleave_ff_impl(int vector_length,
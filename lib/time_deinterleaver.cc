@@ -0,0 +1,101 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "time_deinterleaver.h"
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+namespace gr {
+  namespace dab {
+
+    template<typename T>
+    time_deinterleaver<T>::time_deinterleaver(int vector_length,
+                                              const std::vector<unsigned char> &scrambling_vector)
+            : d_vector_length(vector_length),
+              d_scrambling_vector(scrambling_vector),
+              d_slot(0),
+              d_bit(0) {
+      d_scrambling_length = scrambling_vector.size(); // size of the scrambling vector
+      if (d_scrambling_length == 0 || vector_length <= 0)
+        throw std::invalid_argument("vector length and scrambling vector must not be empty");
+      for (int r = 0; r < d_scrambling_length; r++) {
+        if (scrambling_vector[r] >= d_scrambling_length)
+          throw std::invalid_argument((boost::format("scrambling vector entry %d exceeds the interleaver depth %d")
+                                       % (int) scrambling_vector[r] % d_scrambling_length).str());
+      }
+      // one slot per CIF of the interleaver depth, the CIFs before the first one are zero
+      d_ring.assign(d_scrambling_length * d_vector_length, 0);
+      d_read.resize(d_scrambling_length);
+      update_read_pointers();
+    }
+
+    template<typename T>
+    time_deinterleaver<T>::~time_deinterleaver() {
+    }
+
+    template<typename T>
+    void
+    time_deinterleaver<T>::update_read_pointers() {
+      // bit class r is delayed by (scrambling_length-1) - scrambling_vector[r] CIFs
+      for (int r = 0; r < d_scrambling_length; r++) {
+        int slot = (d_slot + 1 + d_scrambling_vector[r]) % d_scrambling_length;
+        d_read[r] = &d_ring[slot * d_vector_length];
+      }
+    }
+
+    template<typename T>
+    void
+    time_deinterleaver<T>::deinterleave(const T *in, T *out, int num_items) {
+      int n = 0;
+      while (n < num_items) {
+        // write the input once into the slot of the current CIF
+        const int num = std::min(d_vector_length - d_bit, num_items - n);
+        memcpy(&d_ring[d_slot * d_vector_length + d_bit], in + n, num * sizeof(T));
+        // read the output in groups of one scrambling vector length
+        int j = d_bit;
+        const int end = d_bit + num;
+        while (j < end) {
+          const int r = j % d_scrambling_length;
+          const int group = std::min(d_scrambling_length - r, end - j);
+          const T *const *src = &d_read[r];
+          for (int k = 0; k < group; k++) {
+            out[k] = src[k][j + k];
+          }
+          out += group;
+          j += group;
+        }
+        n += num;
+        d_bit += num;
+        if (d_bit == d_vector_length) {
+          // CIF complete, the oldest slot is overwritten next
+          d_bit = 0;
+          d_slot = (d_slot + 1) % d_scrambling_length;
+          update_read_pointers();
+        }
+      }
+    }
+
+    template class time_deinterleaver<float>;
+    template class time_deinterleaver<char>;
+
+  }
+}
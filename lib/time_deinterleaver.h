@@ -0,0 +1,64 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_TIME_DEINTERLEAVER_H
+#define INCLUDED_DAB_TIME_DEINTERLEAVER_H
+
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief Convolutional time deinterleaver of ETSI EN 300 401 chapter 12 on soft bits of type T.
+ *
+ * The last scrambling_length input vectors are kept in a ring of CIF slots;
+ * each input element is written once and every output element is read
+ * from the slot of its bit class, so no history is needed and
+ * deinterleave() accepts any number of elements.
+ * Shared by time_deinterleave_ff (float) and time_deinterleave_bb (char),
+ * instantiated for these two types only.
+ *
+ * @param vector_length Length of the input vectors.
+ * @param scrambling_vector Vector with scrambling parameters.
+ */
+    template<typename T>
+    class time_deinterleaver {
+    public:
+      time_deinterleaver(int vector_length, const std::vector<unsigned char> &scrambling_vector);
+
+      ~time_deinterleaver();
+
+      /*! \brief Deinterleaves num elements, the output is delayed by scrambling_length-1 vectors. */
+      void deinterleave(const T *in, T *out, int num);
+
+    private:
+      int d_scrambling_length, d_vector_length;
+      std::vector<unsigned char> d_scrambling_vector;
+      std::vector<T> d_ring; // last scrambling_length CIFs, one slot per CIF
+      std::vector<const T *> d_read; // read position of each bit class in the ring
+      int d_slot; // slot of the current CIF
+      int d_bit; // position inside the current CIF
+
+      void update_read_pointers();
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_TIME_DEINTERLEAVER_H */
@@ -0,0 +1,90 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "unpuncture_vbb_impl.h"
+#include <string.h>
+
+namespace gr {
+  namespace dab {
+
+    unpuncture_vbb::sptr
+    unpuncture_vbb::make(const std::vector<unsigned char> &puncturing_vector,
+                         int fillval) {
+      return gnuradio::get_initial_sptr(new unpuncture_vbb_impl(puncturing_vector, fillval));
+    }
+
+    unsigned int unpuncture_vbb_impl::ones(const std::vector<unsigned char> &puncturing_vector) {
+      unsigned int onescount = 0;
+      for (unsigned int i = 0; i < puncturing_vector.size(); i++) {
+        if (puncturing_vector[i] == 1)
+          onescount++;
+      }
+      return onescount;
+    }
+
+    /*
+     * The private constructor
+     */
+    unpuncture_vbb_impl::unpuncture_vbb_impl(
+            const std::vector<unsigned char> &puncturing_vector, int fillval)
+            : gr::sync_block("unpuncture_vbb",
+                             gr::io_signature::make(1, 1, sizeof(char) * ones(puncturing_vector)),
+                             gr::io_signature::make(1, 1, sizeof(char) * puncturing_vector.size())),
+              d_fillval(fillval) {
+      d_vlen_in = ones(puncturing_vector);
+      d_vlen_out = puncturing_vector.size();
+      for (unsigned int j = 0; j < d_vlen_out; j++) {
+        if (puncturing_vector[j] == 1)
+          d_positions.push_back(j);
+      }
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    unpuncture_vbb_impl::~unpuncture_vbb_impl() {
+    }
+
+    int
+    unpuncture_vbb_impl::work(int noutput_items,
+                              gr_vector_const_void_star &input_items,
+                              gr_vector_void_star &output_items) {
+      const char *in = (const char *) input_items[0];
+      char *out = (char *) output_items[0];
+
+      memset(out, d_fillval, noutput_items * d_vlen_out);
+      for (int i = 0; i < noutput_items; i++) {
+        for (unsigned int j = 0; j < d_vlen_in; j++) {
+          out[d_positions[j]] = in[j];
+        }
+        in += d_vlen_in;
+        out += d_vlen_out;
+      }
+
+      return noutput_items;
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
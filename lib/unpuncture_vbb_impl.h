@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_UNPUNCTURE_VBB_IMPL_H
+#define INCLUDED_DAB_UNPUNCTURE_VBB_IMPL_H
+
+#include <dab/unpuncture_vbb.h>
+
+namespace gr {
+  namespace dab {
+/*! \brief Unpuncturing of a sequence of 8 bit soft bits.
+ *
+ * The output vector is filled with fillval once per call, afterwards the
+ * input elements are written to the positions of the ones in the puncturing vector.
+ *
+ * @param puncturing_vector Vector with puncturing sequence,
+ * length of puncturing_vector is length of an output vector.
+ * @param fillval Value to fill in for a zero of the puncturing vector.
+ *
+ */
+    class unpuncture_vbb_impl : public unpuncture_vbb {
+    private:
+      static unsigned int ones(const std::vector<unsigned char> &puncturing_vector);
+
+      std::vector<unsigned int> d_positions; /*!< Output position of each input element. */
+      char d_fillval;
+      unsigned int d_vlen_in;
+      unsigned int d_vlen_out;
+
+    public:
+      unpuncture_vbb_impl(const std::vector<unsigned char> &puncturing_vector, int fillval);
+
+      ~unpuncture_vbb_impl();
+
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_UNPUNCTURE_VBB_IMPL_H */
@@ -31,10 +31,38 @@
 
 #include <gnuradio/io_signature.h>
 #include "unpuncture_vff_impl.h"
+#include <algorithm>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DAB_UNPUNCTURE_X86
+#include <immintrin.h>
+#endif
 
 namespace gr {
   namespace dab {
 
+#ifdef DAB_UNPUNCTURE_X86
+    namespace {
+      /*! For each mask of 8 outputs: lane k takes input element number popcount(mask & ((1 << k) - 1)). */
+      struct expand_table {
+        int32_t index[256][8] __attribute__((aligned(32)));
+
+        expand_table() {
+          for (int m = 0; m < 256; m++) {
+            int n = 0;
+            for (int k = 0; k < 8; k++) {
+              index[m][k] = n;
+              n += (m >> k) & 1;
+            }
+          }
+        }
+      };
+
+      const expand_table EXPAND;
+    }
+#endif
+
     unpuncture_vff::sptr
     unpuncture_vff::make(const std::vector<unsigned char> &puncturing_vector,
                          float fillval) {
@@ -58,28 +86,88 @@ namespace gr {
               d_puncturing_vector(puncturing_vector), d_fillval(fillval) {
       d_vlen_in = ones(puncturing_vector);
       d_vlen_out = puncturing_vector.size();
+      for (unsigned int j = 0; j < d_vlen_out; j++) {
+        if (puncturing_vector[j] == 1)
+          d_positions.push_back(j);
+      }
+      unsigned int offset = 0;
+      for (unsigned int g = 0; g < d_vlen_out / 8; g++) {
+        unsigned char mask = 0;
+        for (unsigned int k = 0; k < 8; k++) {
+          mask |= (puncturing_vector[8 * g + k] == 1) << k;
+        }
+        d_group_offsets.push_back(offset);
+        d_group_masks.push_back(mask);
+        offset += __builtin_popcount(mask);
+      }
+      d_group_offsets.push_back(offset);
+#ifdef DAB_UNPUNCTURE_X86
+      d_avx2 = __builtin_cpu_supports("avx2");
+#else
+      d_avx2 = false;
+#endif
     }
 
+    void
+    unpuncture_vff_impl::expand_scalar(const float *in, float *out, int noutput_items) {
+      for (int i = 0; i < noutput_items; i++) {
+        std::fill(out, out + d_vlen_out, d_fillval);
+        for (unsigned int j = 0; j < d_vlen_in; j++) {
+          out[d_positions[j]] = in[j];
+        }
+        in += d_vlen_in;
+        out += d_vlen_out;
+      }
+    }
+
+#ifdef DAB_UNPUNCTURE_X86
+    __attribute__((target("avx2"))) void
+    unpuncture_vff_impl::expand_avx2(const float *in, float *out, int noutput_items) {
+      const float *in_end = in + noutput_items * d_vlen_in;
+      const unsigned int num_groups = d_group_masks.size();
+      const __m256 fill = _mm256_set1_ps(d_fillval);
+      // moves bit k of the mask to the sign bit of lane k
+      const __m256i shifts = _mm256_setr_epi32(31, 30, 29, 28, 27, 26, 25, 24);
+      for (int i = 0; i < noutput_items; i++) {
+        unsigned int g = 0;
+        for (; g < num_groups; g++) {
+          const float *src = in + d_group_offsets[g];
+          // the last groups of the last vector would read behind the input
+          if (src + 8 > in_end)
+            break;
+          const int mask = d_group_masks[g];
+          __m256 v = _mm256_permutevar8x32_ps(_mm256_loadu_ps(src),
+                                              _mm256_load_si256((const __m256i *) EXPAND.index[mask]));
+          __m256 select = _mm256_castsi256_ps(_mm256_sllv_epi32(_mm256_set1_epi32(mask), shifts));
+          _mm256_storeu_ps(out + 8 * g, _mm256_blendv_ps(fill, v, select));
+        }
+        // remaining groups and the tail of the vector
+        std::fill(out + 8 * g, out + d_vlen_out, d_fillval);
+        for (unsigned int j = d_group_offsets[g]; j < d_vlen_in; j++) {
+          out[d_positions[j]] = in[j];
+        }
+        in += d_vlen_in;
+        out += d_vlen_out;
+      }
+    }
+#else
+    void
+    unpuncture_vff_impl::expand_avx2(const float *in, float *out, int noutput_items) {
+      expand_scalar(in, out, noutput_items);
+    }
+#endif
+
     int
     unpuncture_vff_impl::work(int noutput_items,
                               gr_vector_const_void_star &input_items,
                               gr_vector_void_star &output_items) {
-      int i;
-      unsigned int j;
-
       const float *in = (const float *) input_items[0];
       float *out = (float *) output_items[0];
 
-      for (i = 0; i < noutput_items; i++) {
-        for (j = 0; j < d_vlen_out; j++) {
-          if (d_puncturing_vector[j] == 1) {
-            *out++ = *in++;
-          }
-          else {
-            *out++ = d_fillval;
-          }
-        }
-      }
+      if (d_avx2)
+        expand_avx2(in, out, noutput_items);
+      else
+        expand_scalar(in, out, noutput_items);
 
       return noutput_items;
     }
@@ -35,15 +35,26 @@ namespace gr {
  * length of puncturing_vector is length of a stream sequence.
  * @param fillval Value to fill in for a zero of the puncturing vector.
  *
+ * The input elements are scattered through a precomputed table of output
+ * positions. If the CPU supports AVX2, each group of 8 output elements is
+ * built from the input with one permutation and a blend with fillval.
  */
     class unpuncture_vff_impl : public unpuncture_vff {
     private:
       unsigned int ones(const std::vector<unsigned char> &puncturing_vector);
 
+      void expand_scalar(const float *in, float *out, int noutput_items);
+
+      void expand_avx2(const float *in, float *out, int noutput_items);
+
       std::vector<unsigned char> d_puncturing_vector;
       float d_fillval;
       unsigned int d_vlen_in;
       unsigned int d_vlen_out;
+      std::vector<unsigned int> d_positions; // output position of each input element
+      std::vector<unsigned int> d_group_offsets; // first input element of each group of 8 outputs and of the tail
+      std::vector<unsigned char> d_group_masks; // puncturing vector of each group of 8 outputs
+      bool d_avx2;
 
     public:
       unpuncture_vff_impl(const std::vector<unsigned char> &puncturing_vector, float fillval);
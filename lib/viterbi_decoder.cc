@@ -0,0 +1,325 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "viterbi_decoder.h"
+#include <math.h>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define DAB_VITERBI_X86
+#include <immintrin.h>
+#endif
+
+/*
+ * Trellis of the DAB mother code (ETSI EN 300 401 chapter 11.1):
+ * The shift register holds the current input bit at bit 6 and the oldest bit at bit 0,
+ * the state is the register without the current input bit (6 bits).
+ * Old states 2i and 2i+1 lead to the new states i (input 0) and i+32 (input 1).
+ * All generator polynomials tap bit 0 and bit 6, so the 4 branches of such a butterfly
+ * only use the code symbol of (2i, input 0) and its complement. With correlation metrics
+ * the complement costs the negative metric and one value per butterfly and step is enough.
+ */
+
+namespace gr {
+  namespace dab {
+
+    namespace {
+      const int TAIL_BITS = 6;
+      const int NUM_STATES = 64;
+      const int NUM_BUTTERFLIES = 32;
+      // metric of states that are not reachable from the zero state
+      const int16_t UNREACHABLE = 16384;
+      // quantized mean absolute value of a soft bit
+      const float SOFT_BIT_MEAN = 32.0f;
+      // polynomials 133 and 171 and 145 (octal), the 4th polynomial equals the first one
+      const uint8_t POLYS[3] = {0x5b, 0x79, 0x65};
+
+      /*! For each butterfly i and polynomial p: -1 if the code bit of state 2i with input 0 is 1, else 0. */
+      struct branch_table {
+        int16_t mask[3][NUM_BUTTERFLIES];
+
+        branch_table() {
+          for (int p = 0; p < 3; p++) {
+            for (int i = 0; i < NUM_BUTTERFLIES; i++) {
+              mask[p][i] = (__builtin_popcount((2 * i) & POLYS[p]) & 1) ? -1 : 0;
+            }
+          }
+        }
+      };
+
+      const branch_table BRANCH;
+
+#ifndef DAB_VITERBI_X86
+      void
+      acs_generic(const int8_t *sym, int steps, uint64_t *dec) {
+        int16_t metric[NUM_STATES], next[NUM_STATES];
+        for (int s = 0; s < NUM_STATES; s++)
+          metric[s] = UNREACHABLE;
+        metric[0] = 0;
+
+        for (int k = 0; k < steps; k++, sym += 4) {
+          int y0 = sym[0] + sym[3], y1 = sym[1], y2 = sym[2];
+          uint64_t d = 0;
+          for (int i = 0; i < NUM_BUTTERFLIES; i++) {
+            int corr = ((y0 ^ BRANCH.mask[0][i]) - BRANCH.mask[0][i]) +
+                       ((y1 ^ BRANCH.mask[1][i]) - BRANCH.mask[1][i]) +
+                       ((y2 ^ BRANCH.mask[2][i]) - BRANCH.mask[2][i]);
+            int a = metric[2 * i] - corr, b = metric[2 * i + 1] + corr;
+            int c = metric[2 * i] + corr, e = metric[2 * i + 1] - corr;
+            next[i] = (int16_t)(a > b ? b : a);
+            next[i + 32] = (int16_t)(c > e ? e : c);
+            d |= (uint64_t)(a > b) << i;
+            d |= (uint64_t)(c > e) << (i + 32);
+          }
+          dec[k] = d;
+          int16_t norm = next[0];
+          for (int s = 1; s < NUM_STATES; s++)
+            if (next[s] < norm) norm = next[s];
+          for (int s = 0; s < NUM_STATES; s++)
+            metric[s] = next[s] - norm;
+        }
+      }
+#endif
+
+#ifdef DAB_VITERBI_X86
+      inline __m128i
+      even_lanes_sse2(__m128i a, __m128i b) {
+        return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                               _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+      }
+
+      inline __m128i
+      odd_lanes_sse2(__m128i a, __m128i b) {
+        return _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+      }
+
+      inline __m128i
+      hmin_sse2(__m128i x) {
+        x = _mm_min_epi16(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+        x = _mm_min_epi16(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_min_epi16(x, _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1)),
+                                                     _MM_SHUFFLE(2, 3, 0, 1)));
+      }
+
+      void
+      acs_sse2(const int8_t *sym, int steps, uint64_t *dec) {
+        // lane l of register r holds the even (E) or odd (O) state of butterfly 8r+l
+        __m128i E[4], O[4], M[3][4];
+        for (int r = 0; r < 4; r++) {
+          E[r] = O[r] = _mm_set1_epi16(UNREACHABLE);
+          for (int p = 0; p < 3; p++)
+            M[p][r] = _mm_loadu_si128((const __m128i *) &BRANCH.mask[p][8 * r]);
+        }
+        E[0] = _mm_insert_epi16(E[0], 0, 0);
+
+        for (int k = 0; k < steps; k++, sym += 4) {
+          __m128i y0 = _mm_set1_epi16((int16_t)(sym[0] + sym[3]));
+          __m128i y1 = _mm_set1_epi16(sym[1]);
+          __m128i y2 = _mm_set1_epi16(sym[2]);
+          __m128i L[4], H[4], DL[4], DH[4];
+          for (int r = 0; r < 4; r++) {
+            __m128i corr = _mm_add_epi16(
+                    _mm_add_epi16(_mm_sub_epi16(_mm_xor_si128(y0, M[0][r]), M[0][r]),
+                                  _mm_sub_epi16(_mm_xor_si128(y1, M[1][r]), M[1][r])),
+                    _mm_sub_epi16(_mm_xor_si128(y2, M[2][r]), M[2][r]));
+            __m128i a = _mm_subs_epi16(E[r], corr), b = _mm_adds_epi16(O[r], corr);
+            __m128i c = _mm_adds_epi16(E[r], corr), e = _mm_subs_epi16(O[r], corr);
+            L[r] = _mm_min_epi16(a, b);
+            H[r] = _mm_min_epi16(c, e);
+            DL[r] = _mm_cmpgt_epi16(a, b);
+            DH[r] = _mm_cmpgt_epi16(c, e);
+          }
+          uint64_t lo = (uint32_t) _mm_movemask_epi8(_mm_packs_epi16(DL[0], DL[1])) |
+                        ((uint32_t) _mm_movemask_epi8(_mm_packs_epi16(DL[2], DL[3])) << 16);
+          uint64_t hi = (uint32_t) _mm_movemask_epi8(_mm_packs_epi16(DH[0], DH[1])) |
+                        ((uint32_t) _mm_movemask_epi8(_mm_packs_epi16(DH[2], DH[3])) << 16);
+          dec[k] = lo | (hi << 32);
+
+          // L holds the new states 0..31, H the new states 32..63 in natural order
+          E[0] = even_lanes_sse2(L[0], L[1]);
+          E[1] = even_lanes_sse2(L[2], L[3]);
+          E[2] = even_lanes_sse2(H[0], H[1]);
+          E[3] = even_lanes_sse2(H[2], H[3]);
+          O[0] = odd_lanes_sse2(L[0], L[1]);
+          O[1] = odd_lanes_sse2(L[2], L[3]);
+          O[2] = odd_lanes_sse2(H[0], H[1]);
+          O[3] = odd_lanes_sse2(H[2], H[3]);
+
+          __m128i norm = _mm_min_epi16(_mm_min_epi16(_mm_min_epi16(L[0], L[1]), _mm_min_epi16(L[2], L[3])),
+                                       _mm_min_epi16(_mm_min_epi16(H[0], H[1]), _mm_min_epi16(H[2], H[3])));
+          norm = hmin_sse2(norm);
+          for (int r = 0; r < 4; r++) {
+            E[r] = _mm_sub_epi16(E[r], norm);
+            O[r] = _mm_sub_epi16(O[r], norm);
+          }
+        }
+      }
+
+      __attribute__((target("avx2"))) inline __m256i
+      fix_lanes_avx2(__m256i x) {
+        // undo the per 128 bit lane interleaving of the pack instructions
+        return _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 1, 2, 0));
+      }
+
+      __attribute__((target("avx2"))) void
+      acs_avx2(const int8_t *sym, int steps, uint64_t *dec) {
+        // lane l of register r holds the even (E) or odd (O) state of butterfly 16r+l
+        __m256i E[2], O[2], M[3][2];
+        for (int r = 0; r < 2; r++) {
+          E[r] = O[r] = _mm256_set1_epi16(UNREACHABLE);
+          for (int p = 0; p < 3; p++)
+            M[p][r] = _mm256_loadu_si256((const __m256i *) &BRANCH.mask[p][16 * r]);
+        }
+        E[0] = _mm256_insert_epi16(E[0], 0, 0);
+
+        for (int k = 0; k < steps; k++, sym += 4) {
+          __m256i y0 = _mm256_set1_epi16((int16_t)(sym[0] + sym[3]));
+          __m256i y1 = _mm256_set1_epi16(sym[1]);
+          __m256i y2 = _mm256_set1_epi16(sym[2]);
+          __m256i L[2], H[2], DL[2], DH[2];
+          for (int r = 0; r < 2; r++) {
+            __m256i corr = _mm256_add_epi16(
+                    _mm256_add_epi16(_mm256_sub_epi16(_mm256_xor_si256(y0, M[0][r]), M[0][r]),
+                                     _mm256_sub_epi16(_mm256_xor_si256(y1, M[1][r]), M[1][r])),
+                    _mm256_sub_epi16(_mm256_xor_si256(y2, M[2][r]), M[2][r]));
+            __m256i a = _mm256_subs_epi16(E[r], corr), b = _mm256_adds_epi16(O[r], corr);
+            __m256i c = _mm256_adds_epi16(E[r], corr), e = _mm256_subs_epi16(O[r], corr);
+            L[r] = _mm256_min_epi16(a, b);
+            H[r] = _mm256_min_epi16(c, e);
+            DL[r] = _mm256_cmpgt_epi16(a, b);
+            DH[r] = _mm256_cmpgt_epi16(c, e);
+          }
+          uint64_t lo = (uint32_t) _mm256_movemask_epi8(fix_lanes_avx2(_mm256_packs_epi16(DL[0], DL[1])));
+          uint64_t hi = (uint32_t) _mm256_movemask_epi8(fix_lanes_avx2(_mm256_packs_epi16(DH[0], DH[1])));
+          dec[k] = lo | (hi << 32);
+
+          E[0] = fix_lanes_avx2(_mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(L[0], 16), 16),
+                                                   _mm256_srai_epi32(_mm256_slli_epi32(L[1], 16), 16)));
+          E[1] = fix_lanes_avx2(_mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(H[0], 16), 16),
+                                                   _mm256_srai_epi32(_mm256_slli_epi32(H[1], 16), 16)));
+          O[0] = fix_lanes_avx2(_mm256_packs_epi32(_mm256_srai_epi32(L[0], 16), _mm256_srai_epi32(L[1], 16)));
+          O[1] = fix_lanes_avx2(_mm256_packs_epi32(_mm256_srai_epi32(H[0], 16), _mm256_srai_epi32(H[1], 16)));
+
+          __m256i m = _mm256_min_epi16(_mm256_min_epi16(L[0], L[1]), _mm256_min_epi16(H[0], H[1]));
+          __m128i m128 = hmin_sse2(_mm_min_epi16(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1)));
+          __m256i norm = _mm256_broadcastw_epi16(m128);
+          for (int r = 0; r < 2; r++) {
+            E[r] = _mm256_sub_epi16(E[r], norm);
+            O[r] = _mm256_sub_epi16(O[r], norm);
+          }
+        }
+      }
+#endif
+    }
+
+    viterbi_decoder::viterbi_decoder(int length,
+                                     const std::vector<unsigned char> &puncturing_vector)
+            : d_length(length) {
+      if (length <= 0)
+        throw std::invalid_argument("viterbi_decoder: length must be positive");
+      d_steps = length + TAIL_BITS;
+      // erased positions are never written and stay zero
+      d_symbols.assign(4 * d_steps, 0);
+      d_decisions.resize(d_steps);
+      if (puncturing_vector.empty()) {
+        d_input_length = 4 * d_steps;
+      } else {
+        if (puncturing_vector.size() != (size_t) (4 * d_steps))
+          throw std::invalid_argument("viterbi_decoder: puncturing vector must have 4*length+24 elements");
+        for (int i = 0; i < 4 * d_steps; i++) {
+          if (puncturing_vector[i] == 1)
+            d_positions.push_back(i);
+        }
+        d_input_length = d_positions.size();
+      }
+    }
+
+    viterbi_decoder::~viterbi_decoder() {
+    }
+
+    int
+    viterbi_decoder::input_length(int length, const std::vector<unsigned char> &puncturing_vector) {
+      if (puncturing_vector.empty())
+        return 4 * (length + TAIL_BITS);
+      return std::count(puncturing_vector.begin(), puncturing_vector.end(), 1);
+    }
+
+    void
+    viterbi_decoder::quantize(const float *in, int num) {
+      // scale the soft bits of this codeword to a fixed mean amplitude;
+      // the decisions of a correlation metric do not depend on a common scale
+      float sum = 0;
+      for (int i = 0; i < num; i++)
+        sum += fabsf(in[i]);
+      float scale = (sum > 0) ? SOFT_BIT_MEAN * num / sum : 0;
+      const int *pos = d_positions.empty() ? NULL : &d_positions[0];
+      for (int i = 0; i < num; i++) {
+        float v = in[i] * scale;
+        if (v > 127.0f) v = 127.0f;
+        if (v < -127.0f) v = -127.0f;
+        d_symbols[pos ? pos[i] : i] = (int8_t) lrintf(v);
+      }
+    }
+
+    void
+    viterbi_decoder::run_acs() {
+#ifdef DAB_VITERBI_X86
+      if (__builtin_cpu_supports("avx2")) {
+        acs_avx2(&d_symbols[0], d_steps, &d_decisions[0]);
+      } else {
+        acs_sse2(&d_symbols[0], d_steps, &d_decisions[0]);
+      }
+#else
+      acs_generic(&d_symbols[0], d_steps, &d_decisions[0]);
+#endif
+    }
+
+    void
+    viterbi_decoder::traceback(unsigned char *out) {
+      // the encoder is flushed with 6 zero bits -> trace back from state 0
+      int state = 0;
+      for (int k = d_steps - 1; k >= 0; k--) {
+        if (k < d_length)
+          out[k] = (unsigned char) (state >> 5);
+        state = ((state & 31) << 1) | (int) ((d_decisions[k] >> state) & 1);
+      }
+    }
+
+    void
+    viterbi_decoder::decode(const float *in, unsigned char *out) {
+      quantize(in, d_input_length);
+      run_acs();
+      traceback(out);
+    }
+
+    void
+    viterbi_decoder::decode(const int8_t *in, unsigned char *out) {
+      const int *pos = d_positions.empty() ? NULL : &d_positions[0];
+      for (int i = 0; i < d_input_length; i++) {
+        // keep the soft bits symmetric for the saturating metrics
+        d_symbols[pos ? pos[i] : i] = (in[i] == -128) ? (int8_t) -127 : in[i];
+      }
+      run_acs();
+      traceback(out);
+    }
+
+  }
+}
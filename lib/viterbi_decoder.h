@@ -0,0 +1,105 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_VITERBI_DECODER_H
+#define INCLUDED_DAB_VITERBI_DECODER_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace gr {
+  namespace dab {
+/*! \brief Viterbi decoder for the DAB mother code.
+ *
+ * Decodes the rate 1/4, constraint length 7 convolutional code of
+ * ETSI EN 300 401 chapter 11.1 with the octal generator polynomials
+ * 133, 171, 145, 133 (the same code conv_encoder_bb produces).
+ * The trellis starts and ends in the all zero state, the 6 tail bits are
+ * decoded but not written to the output.
+ *
+ * If a puncturing vector is given, the decoder reads punctured codewords
+ * directly. The soft bits are placed at their trellis positions through a
+ * precomputed index table; erased positions stay zero and do not contribute
+ * to any branch metric, so no unpunctured copy of the codeword is built.
+ *
+ * Soft bits are quantized per codeword to 8 bit and the 64 path metrics are
+ * kept as saturating 16 bit integers. The add-compare-select butterflies
+ * run with AVX2 or SSE2 if the CPU supports it, otherwise a scalar fallback
+ * is used. All paths take identical decisions.
+ */
+    class viterbi_decoder {
+    public:
+      /*!
+       * @param length Number of information bits per codeword (without tail bits).
+       * @param puncturing_vector Optional puncturing sequence of length 4*length+24,
+       * a 1 marks a transmitted bit, a 0 an erased bit. Empty for unpunctured input.
+       */
+      viterbi_decoder(int length,
+                      const std::vector<unsigned char> &puncturing_vector = std::vector<unsigned char>());
+
+      ~viterbi_decoder();
+
+      /*! \brief Decodes one codeword.
+       *
+       * @param in input_length() soft bits, positive values for logical 0,
+       * zero for an erasure.
+       * @param out length unpacked bits (one bit per byte).
+       */
+      void decode(const float *in, unsigned char *out);
+
+      /*! \brief Decodes one codeword of 8 bit soft bits.
+       *
+       * The soft bits are used as they are, without the scaling of the float version.
+       *
+       * @param in input_length() soft bits, positive values for logical 0,
+       * zero for an erasure. -128 is treated as -127.
+       * @param out length unpacked bits (one bit per byte).
+       */
+      void decode(const int8_t *in, unsigned char *out);
+
+      int length() const { return d_length; }
+
+      /*! Number of soft bits per codeword, 4*length+24 or the number of ones in the puncturing vector. */
+      int input_length() const { return d_input_length; }
+
+      /*! \brief Number of soft bits per codeword of a decoder with these parameters.
+       * For the io_signature of blocks, before the decoder is constructed.
+       */
+      static int input_length(int length, const std::vector<unsigned char> &puncturing_vector);
+
+    private:
+      void quantize(const float *in, int num);
+
+      void run_acs();
+
+      void traceback(unsigned char *out);
+
+      int d_length;
+      int d_steps;
+      int d_input_length;
+      std::vector<int> d_positions;
+      std::vector<int8_t> d_symbols;
+      std::vector<uint64_t> d_decisions;
+    };
+
+  }
+}
+
+#endif /* INCLUDED_DAB_VITERBI_DECODER_H */
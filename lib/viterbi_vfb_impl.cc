@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "viterbi_vfb_impl.h"
+
+namespace gr {
+  namespace dab {
+
+    viterbi_vfb::sptr
+    viterbi_vfb::make(int length, const std::vector<unsigned char> &puncturing_vector) {
+      return gnuradio::get_initial_sptr
+              (new viterbi_vfb_impl(length, puncturing_vector));
+    }
+
+    /*
+     * The private constructor
+     */
+    viterbi_vfb_impl::viterbi_vfb_impl(int length, const std::vector<unsigned char> &puncturing_vector)
+            : gr::sync_interpolator("viterbi_vfb",
+                                    gr::io_signature::make(1, 1, sizeof(float) *
+                                                                 viterbi_decoder::input_length(length,
+                                                                                               puncturing_vector)),
+                                    gr::io_signature::make(1, 1, sizeof(char)), length),
+              d_length(length),
+              d_decoder(length, puncturing_vector) {
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    viterbi_vfb_impl::~viterbi_vfb_impl() {
+    }
+
+    int
+    viterbi_vfb_impl::work(int noutput_items,
+                           gr_vector_const_void_star &input_items,
+                           gr_vector_void_star &output_items) {
+      const float *in = (const float *) input_items[0];
+      unsigned char *out = (unsigned char *) output_items[0];
+
+      for (int i = 0; i < noutput_items / d_length; i++) {
+        d_decoder.decode(in, out);
+        in += d_decoder.input_length();
+        out += d_length;
+      }
+
+      // Tell runtime system how many output items we produced.
+      return noutput_items;
+    }
+
+  } /* namespace dab */
+} /* namespace gr */
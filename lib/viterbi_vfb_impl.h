@@ -0,0 +1,57 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DAB_VITERBI_VFB_IMPL_H
+#define INCLUDED_DAB_VITERBI_VFB_IMPL_H
+
+#include <dab/viterbi_vfb.h>
+#include "viterbi_decoder.h"
+
+namespace gr {
+  namespace dab {
+/*! \brief Viterbi decoder for the DAB mother code.
+ *
+ * Each input vector is one codeword of the rate 1/4 convolutional code
+ * including the 24 soft bits of the tail, or the punctured version of it
+ * if a puncturing vector is given. Each codeword is decoded to
+ * length output bytes with one bit each.
+ *
+ * @param length Number of information bits per codeword.
+ * @param puncturing_vector Puncturing sequence of the codeword or empty.
+ */
+    class viterbi_vfb_impl : public viterbi_vfb {
+    private:
+      int d_length;
+      viterbi_decoder d_decoder;
+
+    public:
+      viterbi_vfb_impl(int length, const std::vector<unsigned char> &puncturing_vector);
+
+      ~viterbi_vfb_impl();
+
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace dab
+} // namespace gr
+
+#endif /* INCLUDED_DAB_VITERBI_VFB_IMPL_H */
@@ -9,6 +9,7 @@ import user_frontend
 import usrp_dab_rx
 import usrp_dab_tx
 import dab.constants as constants
+from dab.ensemble_cache import ensemble_cache
 import math
 import json
 import sip
@@ -50,9 +51,13 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
         self.audio_bit_rate = 16000
         self.volume = 80
         self.subch = -1
+        self.subch_ID = None
         self.dabplus = True
         self.need_new_init = True
         self.file_path = "None"
+        self.ensemble_cache = ensemble_cache()
+        # keep the whole MSC of the last CIFs, a newly selected service plays at once
+        self.warm_history = True
         self.src_is_USRP = True
         self.src_is_RTL = False
         self.receiver_running = False
@@ -387,12 +392,21 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
                 self.label_path.setStyleSheet('color: red')
             else:
                 self.label_path.setStyleSheet('color: black')
+                # start with the service of the last reception on this channel, if it is cached
+                entry = self.ensemble_cache.load(self.spinbox_frequency.value())
+                if entry is not None:
+                    subch = ensemble_cache.subchannel(entry, entry.get("selected"))
+                    if subch is not None:
+                        self.subch_ID = entry["selected"]
+                        self.set_subch_params(subch["address"], subch["size"], subch["protection"],
+                                              subch["dabplus"])
                 # set up and start flowgraph
                 self.my_receiver = usrp_dab_rx.usrp_dab_rx(
                     self.spin_dab_mode.value(), self.spinbox_frequency.value(),
                     self.bit_rate, self.address, self.size, self.protection,
                     self.audio_bit_rate, self.dabplus, self.src_is_USRP,
-                    self.src_is_RTL, self.file_path)
+                    self.src_is_RTL, self.file_path,
+                    warm_history=self.warm_history, cache=self.ensemble_cache, subch_ID=self.subch_ID)
                 self.my_receiver.set_volume(0)
                 self.my_receiver.start()
                 # status bar
@@ -440,6 +454,7 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
             self.audio_bit_rate = 16000
             self.volume = 80
             self.subch = -1
+            self.subch_ID = None
             self.dabplus = True
             self.need_new_init = True
             self.file_path = "None"
@@ -537,19 +552,9 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
                               {"programme_type": 0})
 
         # update sub-channel info for receiver
-        self.address = int(subch_data['address'])
-        self.size = int(subch_data['size'])
-        self.protection = int(subch_data['protection'])
-        conv_table = [12, 8, 6, 5]
-        self.bit_rate = self.size * 8 / conv_table[self.protection]
-        self.dabplus = service_data['DAB+']
-        if self.dabplus:
-            if self.bit_rate < 100:
-                self.audio_bit_rate = 48000
-            else:
-                self.audio_bit_rate = 32000
-        else:
-            self.audio_bit_rate = 48000
+        self.subch_ID = int(ID)
+        self.set_subch_params(int(subch_data['address']), int(subch_data['size']),
+                              int(subch_data['protection']), service_data['DAB+'])
 
         # display info to selected sub-channel
         # service info
@@ -571,6 +576,20 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
         self.statusBar.showMessage(
             "Play/Record the selected service component.")
 
+    def set_subch_params(self, address, size, protection, dabplus):
+        self.address = address
+        self.size = size
+        self.protection = protection
+        self.bit_rate = ensemble_cache.bit_rate(self.size, self.protection)
+        self.dabplus = dabplus
+        if self.dabplus:
+            if self.bit_rate < 100:
+                self.audio_bit_rate = 48000
+            else:
+                self.audio_bit_rate = 32000
+        else:
+            self.audio_bit_rate = 48000
+
     def snr_update(self):
         # display snr in progress bar if an instance of usrp_dab_rx is existing
         if hasattr(self, 'my_receiver') and self.receiver_running:
@@ -585,6 +604,9 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
                 self.setStyleSheet(
                     """QProgressBar::chunk { background: "red"; }""")
             self.lcd_snr.display(SNR)
+            # keep the ensemble cache up to date, the cached sub-channel may have moved
+            if self.my_receiver.update_ensemble_cache():
+                self.statusBar.showMessage("Sub-channel moved, receiver retuned.")
             if SNR > 40:
                 SNR = 20
             elif SNR < 0:
@@ -599,7 +621,15 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
     def play_audio(self):
         # play button pressed
         # if selected sub-channel is not the current sub-channel we have to reconfigure the receiver
-        if self.subch is not self.table_mci.currentRow():
+        if self.subch is not self.table_mci.currentRow() and self.my_receiver.is_dabplus == self.dabplus:
+            # same kind of audio: retune the running receiver, OFDM sync is kept
+            if self.my_receiver.set_subchannel(self.bit_rate, self.address, self.size, self.protection,
+                                               self.subch_ID):
+                self.subch = self.table_mci.currentRow()
+                self.statusBar.showMessage("Audio playing.")
+            else:
+                self.statusBar.showMessage("Sub-channel does not fit its bit rate, not retuned.")
+        elif self.subch is not self.table_mci.currentRow():
             self.subch = self.table_mci.currentRow()
             dev_mode_opened = False
             if self.dev_mode_active:
@@ -621,7 +651,10 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
                 self.src_is_USRP,
                 self.src_is_RTL,
                 self.file_path,
-                prev_src=self.temp_src)
+                prev_src=self.temp_src,
+                warm_history=self.warm_history,
+                cache=self.ensemble_cache,
+                subch_ID=self.subch_ID)
             self.my_receiver.set_volume(
                 float(self.slider_volume.value()) / 100)
             self.my_receiver.start()
@@ -666,7 +699,10 @@ class DABstep(QtGui.QMainWindow, user_frontend.Ui_MainWindow):
                 self.src_is_USRP,
                 self.src_is_RTL,
                 self.file_path,
-                prev_src=self.temp_src)
+                prev_src=self.temp_src,
+                warm_history=self.warm_history,
+                cache=self.ensemble_cache,
+                subch_ID=self.subch_ID)
 
             self.my_receiver.start()
         elif new_sampling_rate == -1:
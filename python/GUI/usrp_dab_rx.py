@@ -28,18 +28,27 @@ from gnuradio import audio, digital
 from gnuradio import qtgui
 from gnuradio import fft
 import osmosdr
+import pmt
 import dab
-import time, math
+import time, math, json
 
 
 class usrp_dab_rx(gr.top_block):
-    def __init__(self, dab_mode, frequency, bit_rate, address, size, protection, audio_bit_rate, dabplus, use_usrp, use_rtl, src_path, sink_path = "None", prev_src=None):
+    def __init__(self, dab_mode, frequency, bit_rate, address, size, protection, audio_bit_rate, dabplus, use_usrp, use_rtl, src_path, sink_path = "None", prev_src=None, warm_history=False, cache=None, subch_ID=None):
         gr.top_block.__init__(self)
 
         self.dab_mode = dab_mode
         self.verbose = False
         self.sample_rate = 2048e3
         self.dabplus = dabplus
+        self.is_dabplus = dabplus
+        self.warm_history = warm_history
+        # ensemble information of the last reception on this frequency, until the FIC tells better
+        self.cache = cache
+        self.cached = cache.load(frequency) if cache is not None else None
+        self.cache_version = -1
+        self.subch_ID = subch_ID
+        self.subch_config = (address, size, protection)
         self.use_usrp = use_usrp
         self.use_rtl = use_rtl
         self.src_path = src_path
@@ -109,7 +118,12 @@ class usrp_dab_rx(gr.top_block):
         ########################
         # OFDM demod
         ########################
-        self.demod = dab.ofdm_demod_cc(self.dab_params)
+        # only demodulate the OFDM symbols of the selected sub-channel,
+        # unless the whole MSC is kept for switching between sub-channels without delay
+        if self.warm_history:
+            self.demod = dab.ofdm_demod_cc(self.dab_params)
+        else:
+            self.demod = dab.ofdm_demod_cc(self.dab_params, self.dab_params.symbol_mask([(address, size)]))
 
         ########################
         # SNR measurement
@@ -127,11 +141,12 @@ class usrp_dab_rx(gr.top_block):
         # MSC decoder
         ########################
         if self.dabplus:
-            self.dabplus = dab.dabplus_audio_decoder_ff(self.dab_params, bit_rate, address, size, protection, True)
+            self.dabplus = dab.dabplus_audio_decoder_ff(self.dab_params, bit_rate, address, size, protection, True,
+                                                        warm_history=self.warm_history)
         else:
-            self.msc_dec = dab.msc_decode(self.dab_params, address, size, protection)
-            self.unpack = blocks.packed_to_unpacked_bb_make(1, gr.GR_MSB_FIRST)
-            self.mp2_dec = dab.mp2_decode_bs_make(bit_rate / 8)
+            self.msc_dec = dab.msc_decode_vcb_make(self.dab_params.num_carriers, address, size, protection,
+                                                   self.warm_history)
+            self.mp2_dec = dab.mp2_decode_bs_make(bit_rate / 8, False, True)
             self.s2f_left = blocks.short_to_float_make(1, 32767)
             self.s2f_right = blocks.short_to_float_make(1, 32767)
             self.gain_left = blocks.multiply_const_ff(1, 1)
@@ -156,8 +171,7 @@ class usrp_dab_rx(gr.top_block):
         if self.dabplus:
             self.connect((self.demod, 1), self.dabplus)
         else:
-            self.connect((self.demod, 0), (self.msc_dec, 0), self.unpack, self.mp2_dec)
-            self.connect((self.demod, 1), (self.msc_dec, 1))
+            self.connect((self.demod, 1), self.msc_dec, self.mp2_dec)
             self.connect((self.mp2_dec, 0), self.s2f_left, self.gain_left)
             self.connect((self.mp2_dec, 1), self.s2f_right, self.gain_right)
         self.connect((self.demod, 0), self.v2s_snr, self.constellation_plot)
@@ -181,20 +195,29 @@ class usrp_dab_rx(gr.top_block):
 ########################
 # getter methods
 ########################
+    def get_cached(self, key, live):
+        # the live JSON string of the FIC, the cached one as long as the FIC didn't deliver it yet
+        if live == "" and self.cached is not None and self.cached.get(key):
+            return json.dumps(self.cached[key])
+        return live
+
     def get_ensemble_info(self):
-        return self.fic_dec.get_ensemble_info()
+        return self.get_cached("ensemble", self.fic_dec.get_ensemble_info())
 
     def get_service_info(self):
-        return self.fic_dec.get_service_info()
+        return self.get_cached("services", self.fic_dec.get_service_info())
 
     def get_service_labels(self):
-        return self.fic_dec.get_service_labels()
+        return self.get_cached("service_labels", self.fic_dec.get_service_labels())
 
     def get_subch_info(self):
-        return self.fic_dec.get_subch_info()
+        return self.get_cached("subchannels", self.fic_dec.get_subch_info())
 
     def get_programme_type(self):
-        return self.fic_dec.get_programme_type()
+        return self.get_cached("programme_types", self.fic_dec.get_programme_type())
+
+    def get_ensemble_version(self):
+        return self.fic_dec.get_version()
 
     def get_sample_rate(self):
         return self.dabplus.get_sample_rate()
@@ -221,6 +244,66 @@ class usrp_dab_rx(gr.top_block):
             self.gain_left.set_k(volume)
             self.gain_right.set_k(volume)
 
+    def update_ensemble_cache(self):
+        # store the ensemble information of the FIC once it changed and check the selected
+        # sub-channel (possibly configured from the cache) against it, returns True if retuned
+        if self.cache is None:
+            return False
+        if self.get_ensemble_version() != self.cache_version:
+            live = [self.fic_dec.get_ensemble_info(), self.fic_dec.get_service_info(),
+                    self.fic_dec.get_service_labels(), self.fic_dec.get_subch_info(),
+                    self.fic_dec.get_programme_type()]
+            if live[1] == "" or live[2] == "" or live[3] == "":
+                # wait for the multiplex configuration and the labels
+                return False
+            self.cache_version = self.get_ensemble_version()
+            entry = dict(self.cached) if self.cached is not None else {}
+            for key, value in zip(dab.ensemble_cache.keys, live):
+                if value != "":
+                    entry[key] = json.loads(value)
+            if self.subch_ID is not None:
+                entry["selected"] = self.subch_ID
+            self.cache.save(self.frequency, entry)
+            self.cached = entry
+        if self.subch_ID is None or self.cached is None or self.cache_version == -1:
+            return False
+        # checked on every call, a failed retune is retried with the next update
+        subch = dab.ensemble_cache.subchannel(self.cached, self.subch_ID)
+        if subch is None or subch["dabplus"] != self.is_dabplus or \
+                (subch["address"], subch["size"], subch["protection"]) == self.subch_config:
+            return False
+        if self.verbose:
+            print("--> sub-channel " + str(self.subch_ID) + " moved, retuning")
+        return self.set_subchannel(subch["bit_rate"], subch["address"], subch["size"], subch["protection"])
+
+    def set_subchannel(self, bit_rate, address, size, protection, subch_ID=None):
+        # retune the running receiver to another sub-channel of the ensemble, returns False
+        # if the sub-channel does not carry bit_rate (msc_decode_vcb would reject it)
+        if size != bit_rate // 8 * self.dab_params.subch_size_multiple_n[protection]:
+            if self.verbose:
+                print("--> sub-channel (size " + str(size) + ", protection " + str(protection) +
+                      ") does not carry " + str(bit_rate) + " kbit/s, not retuned")
+            return False
+        if subch_ID is not None and subch_ID != self.subch_ID:
+            self.subch_ID = subch_ID
+            # store the new selection with the next update of the cache
+            self.cache_version = -1
+        if (address, size, protection) == self.subch_config:
+            return True
+        self.subch_config = (address, size, protection)
+        if not self.warm_history:
+            self.demod.set_symbol_mask(self.dab_params.symbol_mask([(address, size)]))
+        if self.is_dabplus:
+            self.dabplus.set_subchannel(bit_rate, address, size, protection)
+        else:
+            msg = pmt.make_dict()
+            msg = pmt.dict_add(msg, pmt.intern("address"), pmt.from_long(address))
+            msg = pmt.dict_add(msg, pmt.intern("size"), pmt.from_long(size))
+            msg = pmt.dict_add(msg, pmt.intern("protection"), pmt.from_long(protection))
+            msg = pmt.dict_add(msg, pmt.intern("bit_rate_n"), pmt.from_long(int(bit_rate / 8)))
+            self.msc_dec.to_basic_block()._post(pmt.intern("config"), msg)
+        return True
+
     def set_valve_closed(self, closed):
         self.valve_left.set_closed(closed)
         self.valve_right.set_closed(closed)
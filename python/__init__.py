@@ -37,5 +37,6 @@ from .msc_decode import *
 from .msc_encode import *
 from .transmitter_c import *
 from .dabplus_audio_decoder_ff import *
+from .ensemble_cache import *
 
 from . import constants
@@ -21,20 +21,27 @@
 
 from gnuradio import gr, blocks
 from gnuradio import filter
+import pmt
 import dab
 
 class dabplus_audio_decoder_ff(gr.hier_block2):
     """
     Hier block for decoding dab+ audio frames out of whole DAB transmission frame
     containing the following blocks:
-    -msc_decode: extract subchannel and decode it
+    -msc_decode_vcb: extract subchannel and decode it
     -firecode checker
     -Reed Solomon error repair
     -mp4 decoder
     See the single blocks for more details
+
+    The decoder can be retuned to another sub-channel of the ensemble while the flowgraph
+    keeps running, with set_subchannel() or a config message (see msc_decode_vcb).
+    The new sub-channel is decoded from the next CIF on. With warm_history, the last CIFs
+    of the whole MSC are kept, so that the time deinterleaver of the new sub-channel is
+    filled at once (the OFDM demodulator must not use a symbol mask then).
     """
 
-    def __init__(self, dab_params, bit_rate, address, subch_size, protection, output_float, verbose=False, debug=False):
+    def __init__(self, dab_params, bit_rate, address, subch_size, protection, output_float, verbose=False, debug=False, warm_history=False):
         if output_float: # map short samples to the range [-1,1] in floats
             gr.hier_block2.__init__(self,
                                     "dabplus_audio_decoder_ff",
@@ -46,7 +53,7 @@ class dabplus_audio_decoder_ff(gr.hier_block2):
             gr.hier_block2.__init__(self,
                                     "dabplus_audio_decoder_ff",
                                     # Input signature
-                                    gr.io_signature(1, 1, gr.sizeof_float * dab_params.num_carriers),
+                                    gr.io_signature(1, 1, gr.sizeof_gr_complex * dab_params.num_carriers),
                                     # Output signature
                                     gr.io_signature2(2, 2, gr.sizeof_short, gr.sizeof_short))
         self.dp = dab_params
@@ -66,7 +73,8 @@ class dabplus_audio_decoder_ff(gr.hier_block2):
         #     raise ValueError
 
         # MSC decoder extracts logical frames out of transmission frame and decodes it
-        self.msc_decoder = dab.msc_decode(self.dp, self.address, self.size, self.protection, self.verbose, self.debug)
+        self.msc_decoder = dab.msc_decode_vcb_make(self.dp.num_carriers, self.address, self.size, self.protection,
+                                                  warm_history)
         # firecode synchronizes to superframes and checks
         self.firecode = dab.firecode_check_bb_make(self.bit_rate_n)
         # Reed-Solomon error repair
@@ -76,6 +84,8 @@ class dabplus_audio_decoder_ff(gr.hier_block2):
 
         # connections
         self.connect(self, self.msc_decoder, self.firecode, self.rs, self.mp4)
+        self.message_port_register_hier_in("config")
+        self.msg_connect(self, "config", self.msc_decoder, "config")
 
         if self.output_float:
             # map short samples to the range [-1,1] in floats
@@ -90,6 +100,21 @@ class dabplus_audio_decoder_ff(gr.hier_block2):
             self.connect((self.mp4, 0), (self, 0))
             self.connect((self.mp4, 1), (self, 1))
 
+    def set_subchannel(self, bit_rate, address, subch_size, protection):
+        if subch_size != bit_rate // 8 * self.dp.subch_size_multiple_n[protection]:
+            raise ValueError("sub-channel (size %d, protection %d) does not carry %d kbit/s"
+                             % (subch_size, protection, bit_rate))
+        self.bit_rate_n = bit_rate / 8
+        self.address = address
+        self.size = subch_size
+        self.protection = protection
+        msg = pmt.make_dict()
+        msg = pmt.dict_add(msg, pmt.intern("address"), pmt.from_long(address))
+        msg = pmt.dict_add(msg, pmt.intern("size"), pmt.from_long(subch_size))
+        msg = pmt.dict_add(msg, pmt.intern("protection"), pmt.from_long(protection))
+        msg = pmt.dict_add(msg, pmt.intern("bit_rate_n"), pmt.from_long(int(self.bit_rate_n)))
+        self.msc_decoder.to_basic_block()._post(pmt.intern("config"), msg)
+
     def set_volume(self, volume):
         self.gain_left.set_k(volume)
         self.gain_right.set_k(volume)
@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Moritz Luca Schmid, Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import json
+import os
+import dab
+
+
+class ensemble_cache(object):
+    """
+    Ensemble information of the received channels, kept in a local file
+
+    For each center frequency, the information of fib_sink_vb (the decoded JSON of
+    get_ensemble_info, get_service_info, get_service_labels, get_subch_info and
+    get_programme_type) is stored together with the selected sub-channel ID. A receiver
+    can configure its MSC decoder from the cache right at the start and check the cached
+    sub-channel against the FIGs it receives.
+
+    The default file is $XDG_CACHE_HOME/gr-dab/ensembles.json (~/.cache/gr-dab/ensembles.json).
+    """
+    keys = ("ensemble", "services", "service_labels", "subchannels", "programme_types")
+
+    def __init__(self, path=None):
+        if path is None:
+            cache_dir = os.environ.get("XDG_CACHE_HOME", os.path.join(os.path.expanduser("~"), ".cache"))
+            path = os.path.join(cache_dir, "gr-dab", "ensembles.json")
+        self.path = path
+
+    def _read(self):
+        try:
+            with open(self.path) as f:
+                entries = json.load(f)
+            return entries if isinstance(entries, dict) else {}
+        except (IOError, OSError, ValueError):
+            # no cache yet or a broken file, start over
+            return {}
+
+    @staticmethod
+    def _key(frequency):
+        return str(int(round(frequency)))
+
+    def load(self, frequency):
+        """ returns the cached entry of the channel at frequency (Hz) or None """
+        return self._read().get(self._key(frequency))
+
+    def save(self, frequency, entry):
+        """ stores the entry of the channel at frequency (Hz) """
+        entries = self._read()
+        entries[self._key(frequency)] = entry
+        directory = os.path.dirname(self.path)
+        if directory and not os.path.isdir(directory):
+            os.makedirs(directory)
+        # write to a temporary file first, so that a crash never leaves a truncated cache
+        tmp_path = self.path + ".tmp"
+        with open(tmp_path, "w") as f:
+            json.dump(entries, f, sort_keys=True)
+        os.rename(tmp_path, self.path)
+
+    @staticmethod
+    def bit_rate(size, protection):
+        """ bit rate (kbit/s) of an EEP-A sub-channel with size CUs """
+        return size * 8 // dab.dab_parameters.subch_size_multiple_n[protection]
+
+    @staticmethod
+    def subchannel(entry, ID):
+        """
+        returns the configuration of sub-channel ID of an entry as dict with address, size,
+        protection, bit_rate (kbit/s) and dabplus, or None if the entry does not know it
+        """
+        if entry is None:
+            return None
+        subch = next((s for s in entry.get("subchannels", []) if s["ID"] == ID), None)
+        service = next((s for s in entry.get("services", []) if s["ID"] == ID), None)
+        if subch is None or service is None:
+            return None
+        return {"address": subch["address"],
+                "size": subch["size"],
+                "protection": subch["protection"],
+                "bit_rate": ensemble_cache.bit_rate(subch["size"], subch["protection"]),
+                "dabplus": service["DAB+"]}
@@ -19,20 +19,21 @@
 # Boston, MA 02110-1301, USA.
 #
 
-from gnuradio import gr, trellis, blocks
+from gnuradio import gr
 from . import dab_swig as dab
-from math import sqrt
 
 class fic_decode_vc(gr.hier_block2):
     """
     @brief block to decode FIBs (fast information blocks) from the FIC (fast information channel) of a demodulated DAB signal
 
     - get demodulated FIC OFDM symbols from transmission frame
-    - do convolutional decoding
-    - undo energy dispersal
+    - do convolutional decoding, undo energy dispersal and check the CRC (fic_decode_vb)
     - get FIC information
+
+    With duty_cycle > 1, only every duty_cycle-th frame is decoded once the
+    ensemble information did not change for a while (see fic_decode_vb).
     """
-    def __init__(self, dab_params):
+    def __init__(self, dab_params, duty_cycle=1):
         gr.hier_block2.__init__(self,
             "fic_decode_vc",
             gr.io_signature(1, 1, gr.sizeof_gr_complex * dab_params.num_carriers),  # Input signature
@@ -40,72 +41,20 @@ class fic_decode_vc(gr.hier_block2):
 
         self.dp = dab_params
 
-        # complex to intereaved float for convolutional decoding
-        self.c2f = dab.complex_to_interleaved_float_vcf_make(self.dp.num_carriers)
-
-        # FIB block partitioning
-        self.v2s = blocks.vector_to_stream_make(gr.sizeof_float, self.dp.num_carriers * 2)
-        self.s2v = blocks.stream_to_vector_make(gr.sizeof_float, self.dp.fic_punctured_codeword_length)
-
-        # unpuncturing
-        self.unpuncture = dab.unpuncture_vff(self.dp.assembled_fic_puncturing_sequence, 0)
-
-        # convolutional coding
-        self.fsm = trellis.fsm(1, 4, [133, 171, 145, 133])  # OK (dumped to text and verified partially)
-        self.conv_v2s = blocks.vector_to_stream(gr.sizeof_float, self.dp.fic_conv_codeword_length)
-        table = [
-            0, 0, 0, 0,
-            0, 0, 0, 1,
-            0, 0, 1, 0,
-            0, 0, 1, 1,
-            0, 1, 0, 0,
-            0, 1, 0, 1,
-            0, 1, 1, 0,
-            0, 1, 1, 1,
-            1, 0, 0, 0,
-            1, 0, 0, 1,
-            1, 0, 1, 0,
-            1, 0, 1, 1,
-            1, 1, 0, 0,
-            1, 1, 0, 1,
-            1, 1, 1, 0,
-            1, 1, 1, 1
-        ]
-        assert (len(table) / 4 == self.fsm.O())
-        table = [(1 - 2 * x) / sqrt(2) for x in table]
-        self.conv_decode = trellis.viterbi_combined_fb(self.fsm, 774, 0, 0, 4, table, trellis.TRELLIS_EUCLIDEAN)
-        # self.conv_s2v = blocks.stream_to_vector(gr.sizeof_char, 774)
-        print(self.dp.fic_conv_codeword_length, self.dp.conv_code_add_bits_input)
-        self.conv_prune = dab.prune(gr.sizeof_char, self.dp.fic_conv_codeword_length // 4, 0,
-                                    self.dp.conv_code_add_bits_input)
-
-        # energy dispersal
-        self.prbs_src = blocks.vector_source_b(self.dp.prbs(self.dp.energy_dispersal_fic_vector_length), True)
-        # self.energy_v2s = blocks.vector_to_stream(gr.sizeof_char, self.dp.energy_dispersal_fic_vector_length)
-        self.add_mod_2 = blocks.xor_bb()
-        self.energy_s2v = blocks.stream_to_vector(gr.sizeof_char, self.dp.energy_dispersal_fic_vector_length)
-
-        # connect all
-        self.nullsink = blocks.null_sink(gr.sizeof_char)
-        self.pack = blocks.unpacked_to_packed_bb(1, gr.GR_MSB_FIRST)
-        self.fibout = blocks.stream_to_vector(1, 32)
-        # self.filesink = gr.file_sink(gr.sizeof_char, "debug/fic.dat")
-        self.fibsink = dab.fib_sink_vb()
+        # channel decoding and CRC check of the FIBs of a frame
+        self.fic_decoder = dab.fic_decode_vb_make(self.dp.mode, duty_cycle)
 
+        # FIB interpretation
+        self.fibsink = dab.fib_sink_vb()
 
         self.connect((self, 0),
-                     self.c2f,
-                     self.v2s,
-                     self.s2v,
-                     self.unpuncture,
-                     self.conv_v2s,
-                     self.conv_decode,
-                     self.conv_prune,
-                     self.add_mod_2,
-                     self.pack,
-                     self.fibout,
+                     self.fic_decoder,
                      self.fibsink)
-        self.connect(self.prbs_src, (self.add_mod_2, 1))
+
+        # changes of the ensemble database, also resume full rate FIC decoding
+        self.message_port_register_hier_out("ensemble")
+        self.msg_connect(self.fibsink, "ensemble", self, "ensemble")
+        self.msg_connect(self.fibsink, "ensemble", self.fic_decoder, "ensemble")
 
     def get_ensemble_info(self):
         return self.fibsink.get_ensemble_info()
@@ -122,5 +71,11 @@ class fic_decode_vc(gr.hier_block2):
     def get_programme_type(self):
         return self.fibsink.get_programme_type()
 
+    def get_version(self):
+        return self.fibsink.get_version()
+
     def get_crc_passed(self):
-        return self.fibsink.get_crc_passed()
+        return self.fic_decoder.get_crc_passed()
+
+    def get_duty_cycling(self):
+        return self.fic_decoder.get_duty_cycling()
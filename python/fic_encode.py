@@ -47,14 +47,11 @@ class fic_encode(gr.hier_block2):
         self.s2v_crc = blocks.stream_to_vector(gr.sizeof_char, 32)
         self.crc16 = dab.crc16_bb(32, 0x1021, 0xffff)
         self.v2s_crc = blocks.vector_to_stream(gr.sizeof_char, 32)
-        self.packed_to_unpacked_crc = blocks.packed_to_unpacked_bb_make(1, gr.GR_MSB_FIRST)
 
         # energy dispersal
-        self.prbs_src = blocks.vector_source_b(self.dp.prbs(self.dp.energy_dispersal_fic_vector_length), True)
-        self.add_mod_2 = blocks.xor_bb()
+        self.energy_dispersal = dab.energy_dispersal_bb_make(self.dp.energy_dispersal_fic_vector_length)
 
         # convolutional encoder
-        self.conv_pack = blocks.unpacked_to_packed_bb_make(1, gr.GR_MSB_FIRST)
         self.conv_encoder = dab.conv_encoder_bb_make(self.dp.energy_dispersal_fic_vector_length/8)
         self.conv_unpack = blocks.packed_to_unpacked_bb_make(1, gr.GR_MSB_FIRST)
 
@@ -71,14 +68,9 @@ class fic_encode(gr.hier_block2):
                      self.s2v_crc,
                      self.crc16,
                      self.v2s_crc,
-                     self.packed_to_unpacked_crc,
-                     (self.add_mod_2, 0),
-                     self.conv_pack,
+                     self.energy_dispersal,
                      self.conv_encoder,
                      self.conv_unpack,
                      self.puncture,
                      self.unpacked_to_packed_encoded,
                      self)
-
-        #connect prbs
-        self.connect(self.prbs_src, (self.add_mod_2, 1))
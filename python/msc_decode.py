@@ -19,9 +19,8 @@
 # Boston, MA 02110-1301, USA.
 #
 
-from gnuradio import gr, blocks, trellis
+from gnuradio import gr, blocks
 import dab
-from math import sqrt
 
 class msc_decode(gr.hier_block2):
     """
@@ -34,9 +33,12 @@ class msc_decode(gr.hier_block2):
     - do convolutional decoding
     - undo energy dispersal
     - output data stream of one subchannel (packed bytes)
+
+    With softbit_scale > 0, the soft bits are quantized to 8 bit (value * softbit_scale)
+    and selected, deinterleaved and decoded as 8 bit integers instead of floats.
     """
 
-    def __init__(self, dab_params, address, size, protection, verbose=False, debug=False):
+    def __init__(self, dab_params, address, size, protection, verbose=False, debug=False, softbit_scale=0):
         gr.hier_block2.__init__(self,
                                 "msc_decode",
                                 # Input signature
@@ -77,57 +79,43 @@ class msc_decode(gr.hier_block2):
         #sanity check
         assert(6*self.n == self.puncturing_L1[self.protect] + self.puncturing_L2[self.protect])
 
-        # complex to interleaved float (part of the qpsk demodulation)
-        self.softbit_interleaver = dab.complex_to_interleaved_float_vcf(self.dp.num_carriers)
+        if softbit_scale > 0:
+            # 8 bit soft decision path
+            self.softbit_size = gr.sizeof_char
+            self.softbit_interleaver = dab.complex_to_interleaved_char_vcb(self.dp.num_carriers, softbit_scale)
+        else:
+            # complex to interleaved float (part of the qpsk demodulation)
+            self.softbit_size = gr.sizeof_float
+            self.softbit_interleaver = dab.complex_to_interleaved_float_vcf(self.dp.num_carriers)
 
         # repartition vectors in capacity units (CUs) and select a sub-channel
-        self.v2s_repart_to_cus = blocks.vector_to_stream_make(gr.sizeof_float, self.dp.num_carriers*2)
-        self.s2v_repart_to_cus = blocks.stream_to_vector_make(gr.sizeof_float, self.dp.msc_cu_size)
-        self.select_subch = dab.select_cus_vfvf_make(self.dp.msc_cu_size, self.dp.num_cus, self.address, self.size)
+        self.v2s_repart_to_cus = blocks.vector_to_stream_make(self.softbit_size, self.dp.num_carriers*2)
+        self.s2v_repart_to_cus = blocks.stream_to_vector_make(self.softbit_size, self.dp.msc_cu_size)
+        if softbit_scale > 0:
+            self.select_subch = dab.select_cus_vbvb_make(self.dp.msc_cu_size, self.dp.num_cus, self.address, self.size)
+        else:
+            self.select_subch = dab.select_cus_vfvf_make(self.dp.msc_cu_size, self.dp.num_cus, self.address, self.size)
 
         # time deinterleaving
-        self.time_v2s = blocks.vector_to_stream_make(gr.sizeof_float, self.dp.msc_cu_size)
-        self.time_deinterleaver = dab.time_deinterleave_ff_make(self.dp.msc_cu_size * self.size, self.dp.scrambling_vector)
-
-        # unpuncture
-        self.unpuncture_s2v = blocks.stream_to_vector(gr.sizeof_float, self.msc_punctured_codeword_length)
-        self.unpuncture = dab.unpuncture_vff_make(self.assembled_msc_puncturing_sequence, 0)
-        self.unpuncture_v2s = blocks.vector_to_stream(gr.sizeof_float, self.msc_conv_codeword_length)
-
-        # convolutional decoding
-        self.fsm = trellis.fsm(1, 4, [133, 171, 145, 133])  # OK (dumped to text and verified partially)
-        table = [
-            0, 0, 0, 0,
-            0, 0, 0, 1,
-            0, 0, 1, 0,
-            0, 0, 1, 1,
-            0, 1, 0, 0,
-            0, 1, 0, 1,
-            0, 1, 1, 0,
-            0, 1, 1, 1,
-            1, 0, 0, 0,
-            1, 0, 0, 1,
-            1, 0, 1, 0,
-            1, 0, 1, 1,
-            1, 1, 0, 0,
-            1, 1, 0, 1,
-            1, 1, 1, 0,
-            1, 1, 1, 1
-        ]
-        assert (len(table) / 4 == self.fsm.O())
-        table = [(1 - 2 * x) / sqrt(2) for x in table]
-        self.conv_decode = trellis.viterbi_combined_fb(self.fsm, self.msc_I + self.dp.conv_code_add_bits_input, 0, 0, 4, table, trellis.TRELLIS_EUCLIDEAN)
-        self.conv_s2v = blocks.stream_to_vector(gr.sizeof_char, self.msc_I + self.dp.conv_code_add_bits_input)
-        self.conv_prune = dab.prune(gr.sizeof_char, self.msc_conv_codeword_length / 4, 0,
-                                            self.dp.conv_code_add_bits_input)
+        self.time_v2s = blocks.vector_to_stream_make(self.softbit_size, self.dp.msc_cu_size)
+        if softbit_scale > 0:
+            self.time_deinterleaver = dab.time_deinterleave_bb_make(self.dp.msc_cu_size * self.size, self.dp.scrambling_vector)
+        else:
+            self.time_deinterleaver = dab.time_deinterleave_ff_make(self.dp.msc_cu_size * self.size, self.dp.scrambling_vector)
 
-        #energy descramble
-        self.prbs_src = blocks.vector_source_b(self.dp.prbs(self.msc_I), True)
-        self.add_mod_2 = blocks.xor_bb()
+        # convolutional decoding of the punctured codewords
+        self.conv_s2v = blocks.stream_to_vector(self.softbit_size, self.msc_punctured_codeword_length)
+        if softbit_scale > 0:
+            self.conv_decode = dab.viterbi_vbb_make(self.msc_I, self.assembled_msc_puncturing_sequence)
+        else:
+            self.conv_decode = dab.viterbi_vfb_make(self.msc_I, self.assembled_msc_puncturing_sequence)
 
         #pack bits
         self.pack_bits = blocks.unpacked_to_packed_bb_make(1, gr.GR_MSB_FIRST)
 
+        #energy descramble
+        self.energy_dispersal = dab.energy_dispersal_bb_make(self.msc_I)
+
         # connect blocks
         self.connect(
                      self,
@@ -137,15 +125,11 @@ class msc_decode(gr.hier_block2):
                      self.select_subch,
                      self.time_v2s,
                      self.time_deinterleaver,
-                     self.unpuncture_s2v,
-                     self.unpuncture,
-                     self.unpuncture_v2s,
+                     self.conv_s2v,
                      self.conv_decode,
-                     self.conv_prune,
-                     self.add_mod_2,
                      self.pack_bits,
+                     self.energy_dispersal,
                      (self))
-        self.connect(self.prbs_src, (self.add_mod_2, 1))
 
 
 #debug
@@ -166,22 +150,10 @@ class msc_decode(gr.hier_block2):
             self.sink_subch_time_deinterleaved = blocks.file_sink_make(gr.sizeof_float, "debug/subch_time_deinterleaved.dat")
             self.connect(self.time_deinterleaver, self.sink_subch_time_deinterleaved)
 
-            #sub channel unpunctured
-            self.sink_subch_unpunctured = blocks.file_sink_make(gr.sizeof_float, "debug/subch_unpunctured.dat")
-            self.connect(self.unpuncture, self.sink_subch_unpunctured)
-
             # sub channel convolutional decoded
             self.sink_subch_decoded = blocks.file_sink_make(gr.sizeof_char, "debug/subch_decoded.dat")
             self.connect(self.conv_decode, self.sink_subch_decoded)
 
-            # sub channel convolutional decoded
-            self.sink_subch_pruned = blocks.file_sink_make(gr.sizeof_char, "debug/subch_pruned.dat")
-            self.connect(self.conv_prune, self.sink_subch_pruned)
-
-            # sub channel energy dispersal undone unpacked
-            self.sink_subch_energy_disp_undone = blocks.file_sink_make(gr.sizeof_char, "debug/subch_energy_disp_undone_unpacked.dat")
-            self.connect(self.add_mod_2, self.sink_subch_energy_disp_undone)
-
             # sub channel energy dispersal undone packed
             self.sink_subch_energy_disp_undone_packed = blocks.file_sink_make(gr.sizeof_char, "debug/subch_energy_disp_undone_packed.dat")
-            self.connect(self.pack_bits, self.sink_subch_energy_disp_undone_packed)
+            self.connect(self.energy_dispersal, self.sink_subch_energy_disp_undone_packed)
@@ -28,7 +28,6 @@ class msc_encode(gr.hier_block2):
     @brief block to encode the logical frames of a sub-channel produced by an MPEG source
 
     -get packed bytes from source
-    -unpack bytes
     -energy dispersal
     -convolutional encoding
     -puncturing
@@ -45,15 +44,10 @@ class msc_encode(gr.hier_block2):
         self.msc_I = self.n * 192
         self.protect = protection
 
-        # unpack
-        self.unpack = blocks.packed_to_unpacked_bb_make(1, gr.GR_MSB_FIRST)
-
         # energy dispersal
-        self.prbs_src = blocks.vector_source_b(self.dp.prbs(self.msc_I), True)
-        self.add_mod_2 = blocks.xor_bb()
+        self.energy_dispersal = dab.energy_dispersal_bb_make(self.msc_I)
 
         # convolutional encoder
-        self.conv_pack = blocks.unpacked_to_packed_bb_make(1, gr.GR_MSB_FIRST)
         self.conv_encoder = dab.conv_encoder_bb_make(self.msc_I / 8)
         self.conv_unpack = blocks.packed_to_unpacked_bb_make(1, gr.GR_MSB_FIRST)
 
@@ -94,9 +88,7 @@ class msc_encode(gr.hier_block2):
 
         # connect everything
         self.connect(self,
-                     self.unpack,
-                     self.add_mod_2,
-                     self.conv_pack,
+                     self.energy_dispersal,
                      self.conv_encoder,
                      self.conv_unpack,
                      self.puncture,
@@ -105,6 +97,4 @@ class msc_encode(gr.hier_block2):
                      self.v2s_time_interleave,
                      self.unpacked_to_packed_encoded,
                      self)
-        # connect prbs
-        self.connect(self.prbs_src, (self.add_mod_2, 1))
 
@@ -18,9 +18,7 @@
 # 
 
 from gnuradio import gr, blocks
-from gnuradio import fft
 from gnuradio import digital
-from math import sqrt
 import dab
 
 class ofdm_demod_cc(gr.hier_block2):
@@ -35,8 +33,12 @@ class ofdm_demod_cc(gr.hier_block2):
     - frequency deinterleaving
     - demux into FIC and MSC
     - output of complex qpsk symbols, separated after FIC and MSC
+
+    With a symbol mask (see dab_parameters.symbol_mask), the MSC symbols which are not needed
+    for the selected sub-channels are dropped right after the synchronization and skip the
+    FFT and everything after it. They are filled with zeros at the MSC output.
     """
-    def __init__(self, dab_params):
+    def __init__(self, dab_params, symbol_mask=[]):
         gr.hier_block2.__init__(self,
             "ofdm_demod_cc",
             gr.io_signature(1, 1, gr.sizeof_gr_complex),  # Input signature
@@ -48,40 +50,31 @@ class ofdm_demod_cc(gr.hier_block2):
         self.sync = dab.ofdm_synchronization_cvf_make(self.dp.fft_length,
                                                       self.dp.cp_length,
                                                       self.dp.fft_length,
-                                                      self.dp.symbols_per_frame)
+                                                      self.dp.symbols_per_frame,
+                                                      symbol_mask)
 
-        # FFT
+        # FFT, coarse frequency correction (sub-carrier assignment), differential phasor
+        # and frequency deinterleaving in one pass per symbol, written directly to the FIC or MSC output
         self.s2v_fft = blocks.stream_to_vector_make(gr.sizeof_gr_complex, self.dp.fft_length)
-        self.fft = fft.fft_vcc(self.dp.fft_length, True, [], True)
-        self.multiply = blocks.multiply_const_vcc([1.0/sqrt(2048)]*self.dp.fft_length)
-
-        # coarse frequency correction (sub-carrier assignment)
-        self.coarse_freq_corr = dab.ofdm_coarse_frequency_correction_vcvc_make(self.dp.fft_length,
-                                                                               self.dp.num_carriers,
-                                                                               self.dp.cp_length)
-
-        # differential phasor
-        self.differential_phasor = dab.diff_phasor_vcc_make(1536)
-
-        # frequency deinterleaving
-        self.frequency_deinterleaver = dab.frequency_interleaver_vcc_make(self.dp.frequency_deinterleaving_sequence_array)
-
-        # demux into FIC and MSC
-        self.demux = dab.demux_cc_make(self.dp.num_carriers, self.dp.num_fic_syms, self.dp.num_msc_syms)
+        self.demod = dab.ofdm_demod_demux_vcvc_make(self.dp.fft_length,
+                                                    self.dp.num_carriers,
+                                                    self.dp.frequency_deinterleaving_sequence_array,
+                                                    self.dp.num_fic_syms,
+                                                    self.dp.num_msc_syms,
+                                                    symbol_mask)
 
         self.connect(
             self,
             self.sync,
             self.s2v_fft,
-            self.fft,
-            self.multiply,
-            self.coarse_freq_corr,
-            self.differential_phasor,
-            self.frequency_deinterleaver,
-            self.demux,
+            self.demod,
             (self, 0)
         )
-        self.connect((self.demux, 1), (self, 1))
+        self.connect((self.demod, 1), (self, 1))
+
+    def set_symbol_mask(self, symbol_mask):
+        # the demux takes the mask of each frame from its "Start" tag
+        self.sync.set_symbol_mask(symbol_mask)
 
     def get_snr(self):
-        return self.coarse_freq_corr.get_snr()
+        return self.demod.get_snr()
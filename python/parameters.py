@@ -443,6 +443,30 @@ class dab_parameters:
             sequence.append(newbit)
         return sequence
 
+    def symbol_mask(self, subchannels):
+        """
+        mask of the OFDM symbols of a frame which are needed to decode the given sub-channels
+
+        The phase reference symbol and the FIC symbols are always needed. An MSC symbol is needed
+        if it carries CUs of one of the sub-channels or if it is the reference of the
+        differential demodulation of such a symbol.
+
+        @param subchannels list of (address, size) tuples of the sub-channels in CUs
+        @return list with one entry (1 or 0) per OFDM symbol of the frame (without the NULL symbol)
+        """
+        bits_per_symbol = 2 * self.num_carriers
+        msc_mask = [0] * self.num_msc_syms
+        for (address, size) in subchannels:
+            assert (size > 0 and address + size <= self.num_cus)
+            for cif in range(0, self.num_cifs):
+                first_bit = cif * self.cif_bits + address * self.msc_cu_size
+                last_bit = cif * self.cif_bits + (address + size) * self.msc_cu_size - 1
+                for sym in range(first_bit // bits_per_symbol, last_bit // bits_per_symbol + 1):
+                    msc_mask[sym] = 1
+        mask = [1] * (1 + self.num_fic_syms) + msc_mask
+        # differential demodulation needs the previous symbol
+        return [1 if mask[i] or (i + 1 < len(mask) and mask[i + 1]) else 0 for i in range(0, len(mask))]
+
 class receiver_parameters:
     """
     @brief Parameters for the receiver, independent of the DAB standard
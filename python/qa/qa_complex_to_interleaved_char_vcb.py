@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+
+class qa_complex_to_interleaved_char_vcb (gr_unittest.TestCase):
+    """
+    @brief QA for the 8 bit soft bit conversion
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def convert(self, data, length, scale):
+        src = blocks.vector_source_c(data)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, length)
+        c2c = dab.complex_to_interleaved_char_vcb_make(length, scale)
+        v2s = blocks.vector_to_stream_make(gr.sizeof_char, 2 * length)
+        c2f = blocks.char_to_float_make()
+        dst = blocks.vector_sink_f()
+        self.tb.connect(src, s2v, c2c, v2s, c2f, dst)
+        self.tb.run()
+        return dst.data()
+
+    def test_001_t(self):
+        """
+        real parts first, then imaginary parts, scaled and rounded
+        """
+        data = (0.5+0.25j, -0.5-1j, 1.2j, -0.1+0j,   1-1j, 0.3+0.7j, -0.7+0.2j, 0.02-0.02j)
+        expected_result = (32, -32, 0, -6, 16, -64, 77, 0,   64, 19, -45, 1, -64, 45, 13, -1)
+        result = self.convert(data, 4, 64)
+        self.assertEqual(expected_result, result)
+
+    def test_002_t(self):
+        """
+        values outside of the 8 bit range saturate
+        """
+        data = (3-3j, 0.5+1j)
+        expected_result = (127, 50, -128, 100)
+        result = self.convert(data, 2, 100)
+        self.assertEqual(expected_result, result)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_complex_to_interleaved_char_vcb, "qa_complex_to_interleaved_char_vcb.xml")
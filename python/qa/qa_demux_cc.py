@@ -0,0 +1,127 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+from parameters import dab_parameters
+import pmt
+
+class qa_demux_cc (gr_unittest.TestCase):
+    """
+    @brief QA for the demux of FIC and MSC symbols
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def start_tag(self, offset, mask=None):
+        tag = gr.tag_t()
+        tag.offset = offset
+        tag.key = pmt.intern("Start")
+        if mask is None:
+            tag.value = pmt.from_float(0)
+        else:
+            # as written by ofdm_synchronization_cvf: phase and the mask of the frame
+            tag.value = pmt.cons(pmt.from_float(0), pmt.init_u8vector(len(mask), mask))
+        return tag
+
+    def frame(self, frame_number, mask):
+        # symbol k of the frame has the value 100*frame_number + k in all elements
+        return [[complex(100 * frame_number + k)] * 4 for k in range(0, len(mask)) if mask[k]]
+
+    def run_demux(self, num_frames, mask):
+        symbols = []
+        tags = []
+        for f in range(0, num_frames):
+            tags.append(self.start_tag(len(symbols)))
+            symbols += self.frame(f, mask)
+        src = blocks.vector_source_c([x for sym in symbols for x in sym], False, 4, tags)
+        demux = dab.demux_cc_make(4, 2, 4, 0, mask)
+        fic_sink = blocks.vector_sink_c(4)
+        msc_sink = blocks.vector_sink_c(4)
+        self.tb.connect(src, demux, fic_sink)
+        self.tb.connect((demux, 1), msc_sink)
+        self.tb.run()
+        return (fic_sink.data(), msc_sink.data())
+
+    def test_001_t(self):
+        """
+        all symbols of 3 frames with 2 FIC and 4 MSC symbols
+        """
+        mask = [1] * 7
+        (fic, msc) = self.run_demux(3, mask)
+        self.assertComplexTuplesAlmostEqual(fic, [complex(100 * f + k) for f in range(0, 3) for k in [1, 2] for _ in range(0, 4)])
+        self.assertComplexTuplesAlmostEqual(msc, [complex(100 * f + k) for f in range(0, 3) for k in [3, 4, 5, 6] for _ in range(0, 4)])
+
+    def test_002_t(self):
+        """
+        MSC symbols which are left out by the symbol mask are filled in at the MSC output
+        """
+        mask = [1, 1, 1, 0, 1, 0, 1]
+        (fic, msc) = self.run_demux(3, mask)
+        self.assertComplexTuplesAlmostEqual(fic, [complex(100 * f + k) for f in range(0, 3) for k in [1, 2] for _ in range(0, 4)])
+        self.assertComplexTuplesAlmostEqual(msc, [complex(100 * f + k) if mask[k] else 0
+                                                  for f in range(0, 3) for k in [3, 4, 5, 6] for _ in range(0, 4)])
+
+    def test_003_t(self):
+        """
+        the symbol mask of dab_parameters selects the symbols of a sub-channel and their predecessors
+        """
+        dp = dab_parameters(1, 2048000, False)
+        # 54 CUs at address 0 occupy the first 1.125 MSC symbols of each of the 4 CIFs
+        mask = dp.symbol_mask([(0, 54)])
+        self.assertEqual(len(mask), dp.symbols_per_frame)
+        expected = [0] * dp.symbols_per_frame
+        for k in [0, 1, 2, 3, 4, 5, 21, 22, 23, 39, 40, 41, 57, 58, 59]:
+            expected[k] = 1
+        self.assertEqual(mask, expected)
+
+    def test_004_t(self):
+        """
+        the mask in the "Start" tag of each frame is applied to that frame, not the own mask of the block
+        """
+        masks = [[1] * 7, [1, 1, 1, 0, 1, 0, 1], [1, 1, 1, 1, 0, 0, 0], []]
+        symbols = []
+        tags = []
+        for f in range(len(masks)):
+            tags.append(self.start_tag(len(symbols), masks[f]))
+            symbols += self.frame(f, masks[f] or [1] * 7)
+        src = blocks.vector_source_c([x for sym in symbols for x in sym], False, 4, tags)
+        demux = dab.demux_cc_make(4, 2, 4, 0, [1, 1, 1, 1, 1, 1, 0])
+        fic_sink = blocks.vector_sink_c(4)
+        msc_sink = blocks.vector_sink_c(4)
+        self.tb.connect(src, demux, fic_sink)
+        self.tb.connect((demux, 1), msc_sink)
+        self.tb.run()
+        self.assertComplexTuplesAlmostEqual(fic_sink.data(), [complex(100 * f + k) for f in range(0, 4)
+                                                              for k in [1, 2] for _ in range(0, 4)])
+        self.assertComplexTuplesAlmostEqual(msc_sink.data(), [complex(100 * f + k) if (masks[f] or [1] * 7)[k] else 0
+                                                              for f in range(0, 4) for k in [3, 4, 5, 6]
+                                                              for _ in range(0, 4)])
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_demux_cc, "qa_demux_cc.xml")
@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+from parameters import dab_parameters
+import random
+
+class qa_energy_dispersal_bb (gr_unittest.TestCase):
+    """
+    @brief QA for the packed byte energy dispersal block
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+        self.dp = dab_parameters(1, 2048000, False)
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_001_t(self):
+        """
+        reference data of the FIC energy dispersal
+        """
+        energy_dispersal_undone = (0x05, 0x00, 0x10, 0xea, 0x04, 0x24, 0x06, 0x02, 0xd3, 0xa6, 0x01, 0x3f, 0x06, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4c, 0x89)
+        energy_dispersal_done = (0x02, 0xBE, 0x3E, 0x8E, 0x16, 0xB9, 0xA5, 0xCD, 0x48, 0xB3, 0x22, 0xB2, 0xAD, 0x76, 0x88, 0x80, 0x42, 0x30, 0x9C, 0xAB, 0x0D, 0xE9, 0xB9, 0x14, 0x2B, 0x4F, 0xD9, 0x25, 0xBF, 0x26, 0xEA, 0xE9)
+        src = blocks.vector_source_b(energy_dispersal_undone)
+        energy_dispersal = dab.energy_dispersal_bb_make(self.dp.energy_dispersal_fic_vector_length)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, energy_dispersal, dst)
+        self.tb.run()
+        self.assertEqual(energy_dispersal_done, dst.data())
+
+    def test_002_t(self):
+        """
+        several logical frames of a 48 kbit/s sub-channel against the unpacked bit chain
+        """
+        msc_I = 6 * 192
+        data = tuple([random.randint(0, 255) for _ in range(msc_I // 8 * 5)])
+        src = blocks.vector_source_b(data)
+        energy_dispersal = dab.energy_dispersal_bb_make(msc_I)
+        dst = blocks.vector_sink_b()
+        unpack = blocks.packed_to_unpacked_bb(1, gr.GR_MSB_FIRST)
+        prbs_src = blocks.vector_source_b(self.dp.prbs(msc_I), True)
+        add_mod_2 = blocks.xor_bb()
+        pack = blocks.unpacked_to_packed_bb(1, gr.GR_MSB_FIRST)
+        ref = blocks.vector_sink_b()
+        self.tb.connect(src, energy_dispersal, dst)
+        self.tb.connect(src, unpack, add_mod_2, pack, ref)
+        self.tb.connect(prbs_src, (add_mod_2, 1))
+        self.tb.run()
+        self.assertEqual(ref.data(), dst.data())
+
+    def test_003_t(self):
+        """
+        scrambling twice restores the data
+        """
+        data = tuple([random.randint(0, 255) for _ in range(1000)])
+        src = blocks.vector_source_b(data)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, dab.energy_dispersal_bb_make(768), dab.energy_dispersal_bb_make(768), dst)
+        self.tb.run()
+        self.assertEqual(data, dst.data())
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_energy_dispersal_bb, "qa_energy_dispersal_bb.xml")
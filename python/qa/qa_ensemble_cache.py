@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Moritz Luca Schmid, Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr_unittest
+from ensemble_cache import ensemble_cache
+import os
+import shutil
+import tempfile
+
+class qa_ensemble_cache (gr_unittest.TestCase):
+    """
+    @brief QA for the ensemble cache of the receivers
+    """
+
+    def setUp (self):
+        self.dir = tempfile.mkdtemp()
+        self.cache = ensemble_cache(os.path.join(self.dir, "gr-dab", "ensembles.json"))
+        self.entry = {"ensemble": {"SWR_BW_N        ": {"country_ID": 1}},
+                      "services": [{"reference": 736, "ID": 2, "primary": True, "DAB+": True},
+                                   {"reference": 234, "ID": 5, "primary": True, "DAB+": False},
+                                   {"reference": 837, "ID": 7, "primary": True, "DAB+": True}],
+                      "service_labels": [{"label": "SWR1_BW         ", "reference": 736}],
+                      "subchannels": [{"ID": 2, "address": 54, "protection": 2, "size": 84},
+                                      {"ID": 5, "address": 138, "protection": 2, "size": 96},
+                                      {"ID": 7, "address": 234, "protection": 3, "size": 48}],
+                      "selected": 2}
+
+    def tearDown (self):
+        shutil.rmtree(self.dir)
+
+    def test_001_t (self):
+        """
+        entries are stored per center frequency
+        """
+        self.assertEqual(self.cache.load(227.36e6), None)
+        self.cache.save(227.36e6, self.entry)
+        self.cache.save(222.064e6, {"selected": 7})
+        cache = ensemble_cache(self.cache.path)
+        self.assertEqual(cache.load(227360000), self.entry)
+        self.assertEqual(cache.load(222.064e6), {"selected": 7})
+        self.assertEqual(cache.load(218.64e6), None)
+
+    def test_002_t (self):
+        """
+        sub-channel configuration out of an entry
+        """
+        self.assertEqual(ensemble_cache.subchannel(self.entry, 2),
+                         {"address": 54, "size": 84, "protection": 2, "bit_rate": 112, "dabplus": True})
+        self.assertEqual(ensemble_cache.subchannel(self.entry, 5)["dabplus"], False)
+        # protection level 4-A has 4 CUs per 8 kbit/s
+        self.assertEqual(ensemble_cache.subchannel(self.entry, 7),
+                         {"address": 234, "size": 48, "protection": 3, "bit_rate": 96, "dabplus": True})
+        self.assertEqual(ensemble_cache.subchannel(self.entry, 3), None)
+        self.assertEqual(ensemble_cache.subchannel(None, 2), None)
+
+    def test_003_t (self):
+        """
+        a broken cache file is replaced
+        """
+        os.makedirs(os.path.dirname(self.cache.path))
+        with open(self.cache.path, "w") as f:
+            f.write("{\"227360000\": [")
+        self.assertEqual(self.cache.load(227.36e6), None)
+        self.cache.save(227.36e6, self.entry)
+        self.assertEqual(self.cache.load(227.36e6), self.entry)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ensemble_cache, "qa_ensemble_cache.xml")
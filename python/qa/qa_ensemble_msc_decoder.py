@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+from . import dab_swig as dab
+from parameters import dab_parameters
+import random
+
+class qa_ensemble_msc_decoder (gr_unittest.TestCase):
+    """
+    @brief QA for the ensemble MSC decoder
+
+    This class implements a test bench to verify the corresponding C++ class
+    against one single block MSC decoder per sub-channel.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+        self.dp = dab_parameters(1, 2048000, False)
+
+    def tearDown (self):
+        self.tb = None
+
+    def compare_with_single_decoders(self, addresses, sizes, protections, num_cifs, num_threads):
+        syms_per_cif = self.dp.num_cus * self.dp.msc_cu_size // (2 * self.dp.num_carriers)
+        data = [complex(random.gauss(0, 1), random.gauss(0, 1))
+                for _ in range(num_cifs * syms_per_cif * self.dp.num_carriers)]
+        src = blocks.vector_source_c(data)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, self.dp.num_carriers)
+        ensemble = dab.ensemble_msc_decoder_make(self.dp.num_carriers, addresses, sizes, protections, num_threads)
+        debug = blocks.message_debug()
+        self.tb.connect(src, s2v, ensemble)
+        self.tb.msg_connect(ensemble, "subchannels", debug, "store")
+        sinks = []
+        for address, size, protection in zip(addresses, sizes, protections):
+            sink = blocks.vector_sink_b()
+            self.tb.connect(s2v, dab.msc_decode_vcb_make(self.dp.num_carriers, address, size, protection), sink)
+            sinks.append(sink)
+        self.tb.run()
+        self.assertEqual(debug.num_messages(), num_cifs * len(addresses))
+        frames = [[] for _ in addresses]
+        for i in range(debug.num_messages()):
+            msg = debug.get_message(i)
+            meta = pmt.car(msg)
+            index = pmt.to_long(pmt.dict_ref(meta, pmt.intern("subch_index"), pmt.PMT_NIL))
+            self.assertEqual(index, i % len(addresses))
+            self.assertEqual(pmt.to_long(pmt.dict_ref(meta, pmt.intern("address"), pmt.PMT_NIL)), addresses[index])
+            frames[index].extend(pmt.u8vector_elements(pmt.cdr(msg)))
+        for index, sink in enumerate(sinks):
+            self.assertEqual(tuple(frames[index]), sink.data())
+
+    def test_001_t(self):
+        """
+        three sub-channels, more CIFs than the time interleaver depth
+        """
+        self.compare_with_single_decoders([54, 0, 200], [84, 24, 32], [2, 0, 3], 20, 3)
+
+    def test_002_t(self):
+        """
+        overlapping sub-channels decoded on the calling thread only
+        """
+        self.compare_with_single_decoders([0, 48], [96, 48], [2, 1], 17, 1)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ensemble_msc_decoder, "qa_ensemble_msc_decoder.xml")
@@ -22,6 +22,31 @@
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 from . import dab_swig as dab
+import json
+import pmt
+
+
+def fig(fig_type, body):
+    return [(fig_type << 5) | len(body)] + body
+
+
+def fib(figs):
+    data = sum(figs, [])
+    if len(data) < 30:
+        data += [0xff]
+    data += [0] * (30 - len(data))
+    crc = 0xffff
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xffff
+    crc ^= 0xffff
+    return data + [crc >> 8, crc & 0xff]
+
+
+def label(text):
+    return [ord(c) for c in text.ljust(16)] + [0xff, 0x00]
 
 class qa_fib_sink_vb (gr_unittest.TestCase):
     """
@@ -50,5 +75,41 @@ class qa_fib_sink_vb (gr_unittest.TestCase):
         self.tb.run()
         pass
 
+    def test_002_t (self):
+        """
+        ensemble database: JSON on request and one message per change
+        """
+        fibs = [
+            # ensemble 0x10EA, sub-channel 2 (EEP 3-A, 84 CUs at 54), sub-channel 3 (UEP table index 12 at 300)
+            fib([fig(0, [0x00, 0x10, 0xEA, 0x00, 0x05, 0x00]),
+                 fig(0, [0x01, 2 << 2, 54, 0x88, 84, (3 << 2) | 1, 44, 12])]),
+            # service 0xD3A6: DAB+ audio in sub-channel 2 (primary), data in sub-channel 3; programme type 10
+            fib([fig(0, [0x02, 0xD3, 0xA6, 0x02, 0x3F, (2 << 2) | 2, 0x45, 3 << 2]),
+                 fig(0, [0x11, 0xD3, 0xA6, 0x00, 0x0A])]),
+            fib([fig(1, [0x01, 0xD3, 0xA6] + label("SWR1 BW"))]),
+            fib([fig(1, [0x00, 0x10, 0xEA] + label("SWR BW N"))])]
+        data = sum(fibs, []) * 10
+        src = blocks.vector_source_b(data)
+        fibout = blocks.stream_to_vector(1, 32)
+        fibsink = dab.fib_sink_vb()
+        debug = blocks.message_debug()
+        self.tb.connect(src, fibout, fibsink)
+        self.tb.msg_connect(fibsink, "ensemble", debug, "store")
+        self.tb.run()
+        # repeated FIGs are no changes
+        self.assertEqual(debug.num_messages(), 8)
+        self.assertEqual(fibsink.get_version(), 8)
+        # complete with the ensemble label, the last FIG
+        complete = [pmt.to_bool(pmt.dict_ref(debug.get_message(i), pmt.intern("complete"), pmt.PMT_F))
+                    for i in range(8)]
+        self.assertEqual(complete, [False] * 7 + [True])
+        self.assertTrue(fibsink.get_crc_passed())
+        self.assertEqual(json.loads(fibsink.get_ensemble_info()), {"SWR BW N        ": {"country_ID": 1}})
+        self.assertEqual(json.loads(fibsink.get_service_info()),
+                         [{"reference": 934, "ID": 2, "primary": True, "DAB+": True}])
+        self.assertEqual(json.loads(fibsink.get_service_labels()), [{"label": "SWR1 BW         ", "reference": 934}])
+        self.assertEqual(json.loads(fibsink.get_subch_info()), [{"ID": 2, "address": 54, "protection": 2, "size": 84}])
+        self.assertEqual(json.loads(fibsink.get_programme_type()), [{"reference": 934, "programme_type": 10}])
+
 if __name__ == '__main__':
     gr_unittest.run(qa_fib_sink_vb, "qa_fib_sink_vb.xml")
@@ -0,0 +1,220 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+from parameters import dab_parameters
+from fic_encode import fic_encode
+import pmt
+import random
+
+class qa_fic_decode_vb (gr_unittest.TestCase):
+    """
+    @brief QA for the single block FIC decoder
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_001_t(self):
+        """
+        loopback: fic_encode - qpsk mapper - fic_decode_vb for 3 frames in mode I
+        """
+        dp = dab_parameters(1, 2048000, False)
+        num_fibs = 3 * dp.num_fibs
+        fib_data = [[random.randint(0, 255) for _ in range(30)] for _ in range(num_fibs)]
+        # the CRC is inserted by fic_encode
+        bits = [(byte >> (7 - i)) & 1 for fib in fib_data for byte in fib + [0, 0] for i in range(8)]
+        src = blocks.vector_source_b(bits)
+        encoder = fic_encode(dp)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_char, dp.num_carriers // 4)
+        mapper = dab.qpsk_mapper_vbvc_make(dp.num_carriers)
+        decoder = dab.fic_decode_vb_make(1)
+        sink = blocks.vector_sink_b(32)
+        msg_sink = blocks.message_debug()
+        self.tb.connect(src, encoder, s2v, mapper, decoder, sink)
+        self.tb.msg_connect(decoder, "fib", msg_sink, "store")
+        self.tb.run()
+        result = sink.data()
+        self.assertEqual(len(result), 32 * num_fibs)
+        for i in range(num_fibs):
+            self.assertEqual(tuple(fib_data[i]), result[32 * i:32 * i + 30])
+        self.assertEqual(msg_sink.num_messages(), num_fibs)
+        self.assertTrue(decoder.get_crc_passed())
+
+    def test_002_t(self):
+        """
+        FIBs with a wrong CRC are dropped
+        """
+        dp = dab_parameters(1, 2048000, False)
+        src = blocks.vector_source_c([1 + 1j] * dp.num_fic_syms * dp.num_carriers)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, dp.num_carriers)
+        decoder = dab.fic_decode_vb_make(1)
+        sink = blocks.vector_sink_b(32)
+        self.tb.connect(src, s2v, decoder, sink)
+        self.tb.run()
+        self.assertEqual(len(sink.data()), 0)
+        self.assertFalse(decoder.get_crc_passed())
+
+    def test_003_t(self):
+        """
+        low power mode: every 4th frame is decoded after about 10 s without change
+        """
+        dp = dab_parameters(1, 2048000, False)
+        num_frames = 120
+        # empty FIBs, only the end marker
+        fib = [0xff] + [0] * 29
+        bits = [(byte >> (7 - i)) & 1 for byte in fib + [0, 0] for i in range(8)] * (num_frames * dp.num_fibs)
+        src = blocks.vector_source_b(bits)
+        encoder = fic_encode(dp)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_char, dp.num_carriers // 4)
+        mapper = dab.qpsk_mapper_vbvc_make(dp.num_carriers)
+        decoder = dab.fic_decode_vb_make(1, 4)
+        sink = blocks.vector_sink_b(32)
+        self.tb.connect(src, encoder, s2v, mapper, decoder, sink)
+        self.ensemble_message(decoder, True)
+        self.tb.run()
+        # 417 CIFs (105 frames) at full rate, then the frames 108, 112 and 116
+        self.assertEqual(len(sink.data()), 32 * dp.num_fibs * (105 + 3))
+        self.assertTrue(decoder.get_duty_cycling())
+
+    # helpers for the resume conditions of the low power mode, in mode I
+    # (4 CIFs with 3 FIBs per frame)
+
+    def ensemble_message(self, decoder, complete):
+        # as published by fib_sink_vb, handled before the first call to general_work
+        msg = pmt.make_dict()
+        msg = pmt.dict_add(msg, pmt.intern("type"), pmt.intern("service_label"))
+        msg = pmt.dict_add(msg, pmt.intern("complete"), pmt.from_bool(complete))
+        decoder.to_basic_block()._post(pmt.intern("ensemble"), msg)
+
+    def frame_fibs(self, frame, cif_offset=0, change=0):
+        # a FIG 0/0 with the CIF counter in the first FIB of each CIF, the other FIBs are empty
+        fibs = []
+        for c in range(4):
+            cif_count = (4 * frame + c + cif_offset) % 5000
+            fig00 = [0x05, 0x00, 0x10, 0xEA, (change << 6) | (cif_count // 250), cif_count % 250]
+            fibs += [fig00 + [0xff] + [0] * 23] + [[0xff] + [0] * 29] * 2
+        return fibs
+
+    def encode(self, fibs):
+        dp = dab_parameters(1, 2048000, False)
+        bits = [(byte >> (7 - i)) & 1 for fib in fibs for byte in fib + [0, 0] for i in range(8)]
+        tb = gr.top_block()
+        src = blocks.vector_source_b(bits)
+        encoder = fic_encode(dp)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_char, dp.num_carriers // 4)
+        mapper = dab.qpsk_mapper_vbvc_make(dp.num_carriers)
+        v2s = blocks.vector_to_stream(gr.sizeof_gr_complex, dp.num_carriers)
+        sink = blocks.vector_sink_c()
+        tb.connect(src, encoder, s2v, mapper, v2s, sink)
+        tb.run()
+        # 3 FIC symbols per frame
+        data = sink.data()
+        return [data[i:i + 3 * 1536] for i in range(0, len(data), 3 * 1536)]
+
+    def decode(self, decoder, frames):
+        tb = gr.top_block()
+        src = blocks.vector_source_c([x for frame in frames for x in frame])
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, 1536)
+        sink = blocks.vector_sink_b(32)
+        tb.connect(src, s2v, decoder, sink)
+        tb.run()
+        return sink.data()
+
+    def check_resume(self, fibs, frames, frame_112_fibs=12):
+        """
+        full rate for the frames 0 to 104, in the low power mode the frames 108 and 112
+        are decoded; the resume condition is in frame 112, so every following frame
+        must be decoded again
+        """
+        decoder = dab.fic_decode_vb_make(1, 4)
+        self.ensemble_message(decoder, True)
+        result = self.decode(decoder, frames)
+        self.assertFalse(decoder.get_duty_cycling())
+        num_following = len(frames) - 113
+        self.assertEqual(len(result), 32 * (105 * 12 + 12 + frame_112_fibs + 12 * num_following))
+        result = result[len(result) - 32 * 12 * num_following:]
+        for i in range(12 * num_following):
+            self.assertEqual(tuple(fibs[113 * 12 + i]), result[32 * i:32 * i + 30])
+
+    def test_004_t(self):
+        """
+        no low power mode without a complete ensemble database
+        """
+        fibs = sum([self.frame_fibs(f) for f in range(120)], [])
+        frames = self.encode(fibs)
+        decoder = dab.fic_decode_vb_make(1, 4)
+        self.ensemble_message(decoder, False)
+        result = self.decode(decoder, frames)
+        self.assertFalse(decoder.get_duty_cycling())
+        self.assertEqual(len(result), 32 * 12 * 120)
+
+    def test_005_t(self):
+        """
+        the change flags of FIG 0/0 end the low power mode
+        """
+        fibs = sum([self.frame_fibs(f, change=(1 if f == 112 else 0)) for f in range(130)], [])
+        self.check_resume(fibs, self.encode(fibs))
+
+    def test_006_t(self):
+        """
+        a discontinuity of the CIF counter of FIG 0/0 ends the low power mode
+        """
+        fibs = sum([self.frame_fibs(f, cif_offset=(100 if f >= 110 else 0)) for f in range(130)], [])
+        self.check_resume(fibs, self.encode(fibs))
+
+    def test_007_t(self):
+        """
+        a streak of FIBs with CRC errors ends the low power mode
+        """
+        fibs = sum([self.frame_fibs(f) for f in range(130)], [])
+        frames = self.encode(fibs)
+        # frame 112 is lost, none of its FIBs passes the CRC check
+        frames[112] = [1 + 1j] * len(frames[112])
+        self.check_resume(fibs, frames, frame_112_fibs=0)
+
+    def test_008_t(self):
+        """
+        a change of the ensemble database ends the low power mode
+        """
+        fibs = sum([self.frame_fibs(f) for f in range(130)], [])
+        frames = self.encode(fibs)
+        decoder = dab.fic_decode_vb_make(1, 4)
+        self.ensemble_message(decoder, True)
+        self.assertEqual(len(self.decode(decoder, frames[:112])), 32 * (105 * 12 + 12))
+        self.assertTrue(decoder.get_duty_cycling())
+        # the message arrives before frame 112, which and all following are decoded
+        self.ensemble_message(decoder, True)
+        result = self.decode(decoder, frames[112:])
+        self.assertFalse(decoder.get_duty_cycling())
+        self.assertEqual(len(result), 32 * 12 * (130 - 112))
+        for i in range(12 * (130 - 112)):
+            self.assertEqual(tuple(fibs[112 * 12 + i]), result[32 * i:32 * i + 30])
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_fic_decode_vb, "qa_fic_decode_vb.xml")
@@ -0,0 +1,120 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+import pmt
+import random
+
+class qa_firecode_check_bb (gr_unittest.TestCase):
+    """
+    @brief QA for the superframe synchronization with the fire code
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+        random.seed(0)
+
+    def tearDown (self):
+        self.tb = None
+
+    def firecode(self, data):
+        # remainder of data(x) * x^16 modulo g(x) = 1+x+x^2+x^3+x^5+x^11+x^12+x^13+x^14+x^16
+        m = 0
+        for b in data:
+            m = (m << 8) | b
+        m <<= 16
+        g = 0x1782F
+        for bit in range(m.bit_length() - 1, 15, -1):
+            if (m >> bit) & 1:
+                m ^= g << (bit - 16)
+        return [m >> 8, m & 0xff]
+
+    def superframe(self, bit_rate_n, valid=True):
+        data = [random.randint(0, 255) for _ in range(5 * 24 * bit_rate_n - 2)]
+        parity = self.firecode(data[0:9])
+        if not valid:
+            parity[0] ^= 0x01
+        return parity + data
+
+    def frame(self, bit_rate_n):
+        return [random.randint(0, 255) for _ in range(24 * bit_rate_n)]
+
+    def run_sync(self, bit_rate_n, max_misses, data):
+        src = blocks.vector_source_b(data)
+        firecode = dab.firecode_check_bb_make(bit_rate_n, max_misses)
+        sink = blocks.vector_sink_b()
+        self.tb.connect(src, firecode, sink)
+        self.tb.run()
+        tags = [(t.offset, pmt.to_bool(t.value)) for t in sink.tags() if pmt.symbol_to_string(t.key) == "superframe_start"]
+        return (sink.data(), tags)
+
+    def test_001_t(self):
+        """
+        acquisition after 2 frames without sync and tracking over a failed fire code
+        """
+        n = 2
+        superframes = [self.superframe(n) for _ in range(4)] + [self.superframe(n, False)] + \
+                      [self.superframe(n) for _ in range(2)]
+        data = self.frame(n) + self.frame(n) + [b for sf in superframes for b in sf]
+        (out, tags) = self.run_sync(n, 2, data)
+        self.assertEqual(out, tuple([b for sf in superframes for b in sf]))
+        self.assertEqual(tags, [(k * 120 * n, k != 4) for k in range(7)])
+
+    def test_002_t(self):
+        """
+        loss of sync after an inserted logical frame and new acquisition
+        """
+        n = 3
+        superframes = [self.superframe(n) for _ in range(4)]
+        data = superframes[0] + superframes[1] + self.frame(n) + superframes[2] + superframes[3]
+        (out, tags) = self.run_sync(n, 0, data)
+        self.assertEqual(out, tuple([b for sf in superframes for b in sf]))
+        self.assertEqual(tags, [(k * 120 * n, True) for k in range(4)])
+
+    def test_003_t(self):
+        """
+        retune to another sub-channel behind 2 logical frames of an incomplete superframe
+        """
+        old = [self.superframe(2) for _ in range(3)]
+        new = [self.superframe(3) for _ in range(2)]
+        data = [b for sf in old for b in sf] + self.frame(2) + self.frame(2)
+        tag = gr.tag_t()
+        tag.offset = len(data)
+        tag.key = pmt.intern("bit_rate_n")
+        tag.value = pmt.from_long(3)
+        data += [b for sf in new for b in sf]
+        src = blocks.vector_source_b(data, False, 1, [tag])
+        firecode = dab.firecode_check_bb_make(2, 2)
+        sink = blocks.vector_sink_b()
+        self.tb.connect(src, firecode, sink)
+        self.tb.run()
+        self.assertEqual(sink.data(), tuple([b for sf in old + new for b in sf]))
+        tags = [(t.offset, pmt.symbol_to_string(t.key)) for t in sink.tags()]
+        self.assertEqual(sorted(tags), [(0, "superframe_start"), (240, "superframe_start"), (480, "superframe_start"),
+                                        (720, "bit_rate_n"), (720, "superframe_start"), (1080, "superframe_start")])
+        self.assertEqual([pmt.to_long(t.value) for t in sink.tags() if pmt.symbol_to_string(t.key) == "bit_rate_n"], [3])
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_firecode_check_bb, "qa_firecode_check_bb.xml")
@@ -22,6 +22,10 @@
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 import os
+import math
+import pmt
+import struct
+import zlib
 from . import dab_swig as dab
 
 class qa_mp2_decode_bs (gr_unittest.TestCase):
@@ -49,6 +53,124 @@ class qa_mp2_decode_bs (gr_unittest.TestCase):
             log.set_level("WARN")
         pass
 
+    def mp2_frame(self, samples, bit_rate=64):
+        # MPEG-2 LSF layer II frame with 64 (or 48) kbit/s, 24 kHz, mono and no CRC,
+        # only subband 0 is allocated (31 levels, scalefactor index 6)
+        bits = []
+
+        def put(value, length):
+            bits.extend([(value >> (length - 1 - i)) & 1 for i in range(length)])
+
+        put(0xFFF5, 16)  # syncword, MPEG-2, layer II, no CRC
+        put(bit_rate // 8, 4)  # bit rate index: 6 is 48 kbit/s, 8 is 64 kbit/s
+        put(1, 2)  # 24 kHz
+        put(0, 2)  # no padding, private bit
+        put(0xC, 4)  # mono
+        put(0, 4)  # copyright, original, emphasis
+        put(5, 4)  # allocation of subband 0
+        put(0, 3 * 4 + 7 * 3 + 19 * 2)  # subbands 1 to 29 are not allocated
+        put(2, 2)  # scfsi: one scalefactor for all parts
+        put(6, 6)  # scalefactor
+        for s in samples:  # 3 parts * 4 granules * 3 samples
+            put(s, 5)
+        put(0, 6 * bit_rate * 8 - len(bits))
+        return bits
+
+    def mp2_stream(self, num_frames, bit_rate=64):
+        bits = []
+        for f in range(num_frames):
+            bits += self.mp2_frame([int(round(15 + 14 * math.sin(0.3 * (36 * f + n)))) for n in range(36)], bit_rate)
+        return bits
+
+    def pack(self, bits):
+        return [sum(bits[8 * i + k] << (7 - k) for k in range(8)) for i in range(len(bits) // 8)]
+
+    def decode(self, fixed_point, bits, packed=False, tags=(), bit_rate_n=8):
+        src = blocks.vector_source_b(bits, False, 1, tags)
+        mp2_decode = dab.mp2_decode_bs_make(bit_rate_n, fixed_point, packed)
+        sinks = [blocks.vector_sink_s(), blocks.vector_sink_s(), blocks.vector_sink_f(), blocks.vector_sink_f()]
+        self.tb.connect(src, mp2_decode)
+        for i in range(4):
+            self.tb.connect((mp2_decode, i), sinks[i])
+        self.tb.run()
+        return [sink.data() for sink in sinks]
+
+# the float synthesis is close to the fixed-point synthesis
+    def test_002_t (self):
+        bits = self.mp2_stream(8)
+        fixed = self.decode(True, bits)
+        self.tb = gr.top_block()
+        floating = self.decode(False, bits)
+        self.assertEqual(len(fixed[0]), 8 * 1152)
+        self.assertEqual(len(floating[0]), 8 * 1152)
+        self.assertGreater(max(fixed[0]), 1000)
+        for ch in range(2):
+            # the fixed-point matrixing coefficients have 8 bit, allow 1 % of full scale
+            self.assertLess(max(abs(a - b) for a, b in zip(fixed[ch], floating[ch])), 328)
+            # the float output of the float synthesis is rounded to the 16 bit output
+            self.assertLessEqual(max(abs(f * 32768 - s) for f, s in zip(floating[ch + 2], floating[ch])), 0.5 + 1e-3)
+            # the float output of the fixed-point synthesis is the scaled 16 bit output
+            self.assertFloatTuplesAlmostEqual(fixed[ch + 2], [s / 32768.0 for s in fixed[ch]], 6)
+
+
+# packed input gives the same output as unpacked input, also with garbage in front and a broken header
+    def test_003_t (self):
+        bits = self.mp2_stream(8)
+        unpacked = self.decode(False, bits)
+        data = self.pack(bits)
+        self.tb = gr.top_block()
+        packed = self.decode(False, data, True)
+        self.assertEqual(packed[0], unpacked[0])
+        self.assertEqual(packed[1], unpacked[1])
+        data[3 * 384] = 0x00
+        self.tb = gr.top_block()
+        packed = self.decode(False, [0x12, 0xFF, 0xF4, 0x00, 0x47] + data, True)
+        self.assertEqual(len(packed[0]), 7 * 1152)
+        self.assertEqual(packed[0][:3 * 1152], unpacked[0][:3 * 1152])
+        # the frame behind the lost one still sees the old synthesis history
+        self.assertEqual(packed[0][4 * 1152:], unpacked[0][5 * 1152:])
+
+# a retuned sub-channel on packed input, the incomplete frame in front of the "bit_rate_n" tag is dropped
+    def test_004_t (self):
+        old = self.pack(self.mp2_stream(4))
+        new = self.pack(self.mp2_stream(5, 48))
+        old_decoded = self.decode(False, old, True)
+        self.tb = gr.top_block()
+        new_decoded = self.decode(False, new, True, bit_rate_n=6)
+        tag = gr.tag_t()
+        tag.offset = len(old) + 200
+        tag.key = pmt.intern("bit_rate_n")
+        tag.value = pmt.from_long(6)
+        self.tb = gr.top_block()
+        retuned = self.decode(False, old + old[0:200] + new, True, [tag])
+        self.assertEqual(len(old_decoded[0]), 4 * 1152)
+        self.assertEqual(len(retuned[0]), 9 * 1152)
+        self.assertEqual(retuned[0][:4 * 1152], old_decoded[0])
+        # the first frame of the new sub-channel still sees the synthesis history of the old one
+        self.assertEqual(retuned[0][5 * 1152:], new_decoded[0][1152:])
+
+# packed input with frames at a bit offset falls back to the bitwise search, the next header confirms each frame
+    def test_005_t (self):
+        bits = self.mp2_stream(8)
+        unpacked = self.decode(False, bits)
+        self.tb = gr.top_block()
+        packed = self.decode(False, self.pack([0, 1, 1] + bits + [0] * 5), True)
+        # the last frame has no header behind it
+        self.assertEqual(len(packed[0]), 7 * 1152)
+        self.assertEqual(packed[0], unpacked[0][:7 * 1152])
+        self.assertEqual(packed[1], unpacked[1][:7 * 1152])
+
+# the fixed-point synthesis gives bit exactly the output of the original decoder (before the float synthesis)
+    def test_006_t (self):
+        bits = self.mp2_stream(8)
+        fixed = self.decode(True, bits)
+        self.assertEqual(len(fixed[0]), 8 * 1152)
+        self.assertEqual(fixed[0][1152:1160], (-4221, -4280, -4307, -4323, -4325, -4285, -4193, -4091))
+        for ch in range(2):
+            self.assertEqual(zlib.crc32(struct.pack("<%dh" % len(fixed[ch]), *fixed[ch])) & 0xffffffff, 3556418361)
+        self.tb = gr.top_block()
+        self.assertEqual(self.decode(True, self.pack(bits), True)[:2], fixed[:2])
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_mp2_decode_bs, "qa_mp2_decode_bs.xml")
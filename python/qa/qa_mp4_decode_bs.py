@@ -23,6 +23,7 @@ from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 from gnuradio import audio
 import os
+import pmt
 from . import dab_swig as dab
 
 class qa_mp4_decode_bs (gr_unittest.TestCase):
@@ -56,6 +57,59 @@ class qa_mp4_decode_bs (gr_unittest.TestCase):
             log.set_level("WARN")
         pass
 
+    def crc16(self, data):
+        crc = 0xffff
+        for b in data:
+            crc ^= b << 8
+            for _ in range(8):
+                crc = ((crc << 1) ^ 0x1021) & 0xffff if crc & 0x8000 else (crc << 1) & 0xffff
+        return crc ^ 0xffff
+
+    def superframe(self, bit_rate_n, sbr):
+        # DAB+ superframe with mono 32 kHz AUs without (4 AUs) or with SBR (2 AUs), each AU
+        # is a silent AAC frame: SCE with global gain 100 and max_sfb 0, END
+        num_aus = 2 if sbr else 4
+        size = 110 * bit_rate_n
+        header_size = 5 if sbr else 8
+        au_size = (size - header_size) // num_aus
+        starts = [header_size + i * au_size for i in range(num_aus)] + [size]
+        bits = [(a >> (11 - k)) & 1 for a in starts[1:num_aus] for k in range(12)]
+        bits += [0] * (8 * (header_size - 3) - len(bits))
+        # the fire code is not checked by the decoder, dac_rate 0
+        sf = [0, 0, 0x20 if sbr else 0x00] + [sum(bits[8 * i + k] << (7 - k) for k in range(8))
+                                             for i in range(header_size - 3)]
+        for i in range(num_aus):
+            au = [0x00, 0xC8, 0x00, 0x07] + [0] * (starts[i + 1] - starts[i] - 6)
+            crc = self.crc16(au)
+            sf += au + [crc >> 8, crc & 0xff]
+        return sf
+
+    def decode(self, bit_rate_n, data, tags=()):
+        tb = gr.top_block()
+        src = blocks.vector_source_b(data, False, 1, tags)
+        mp4 = dab.mp4_decode_bs_make(bit_rate_n)
+        left = blocks.vector_sink_s()
+        right = blocks.vector_sink_s()
+        tb.connect(src, mp4, left)
+        tb.connect((mp4, 1), right)
+        tb.run()
+        return (left.data(), right.data())
+
+# a "bit_rate_n" tag in the middle of a superframe drops it and reopens the AAC decoder
+    def test_002_t (self):
+        old = [b for _ in range(3) for b in self.superframe(2, False)]
+        new = [b for _ in range(3) for b in self.superframe(3, True)]
+        tag = gr.tag_t()
+        tag.offset = len(old) + 100
+        tag.key = pmt.intern("bit_rate_n")
+        tag.value = pmt.from_long(3)
+        (old_left, old_right) = self.decode(2, old)
+        (new_left, new_right) = self.decode(3, new)
+        (left, right) = self.decode(2, old + old[0:100] + new, [tag])
+        self.assertGreater(len(new_left), 0)
+        self.assertEqual(left, old_left + new_left)
+        self.assertEqual(right, old_right + new_right)
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_mp4_decode_bs, "qa_mp4_decode_bs.xml")
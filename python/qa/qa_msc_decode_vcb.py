@@ -0,0 +1,165 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+import pmt
+from parameters import dab_parameters
+from msc_decode import msc_decode
+import random
+
+class qa_msc_decode_vcb (gr_unittest.TestCase):
+    """
+    @brief QA for the single block MSC decoder
+
+    This class implements a test bench to verify the corresponding C++ class
+    against the hier block msc_decode.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+        self.dp = dab_parameters(1, 2048000, False)
+
+    def tearDown (self):
+        self.tb = None
+
+    def compare_with_hier_block(self, address, size, protection, num_cifs):
+        syms_per_cif = self.dp.num_cus * self.dp.msc_cu_size // (2 * self.dp.num_carriers)
+        data = [complex(random.gauss(0, 1), random.gauss(0, 1))
+                for _ in range(num_cifs * syms_per_cif * self.dp.num_carriers)]
+        src = blocks.vector_source_c(data)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, self.dp.num_carriers)
+        fused = dab.msc_decode_vcb_make(self.dp.num_carriers, address, size, protection)
+        hier = msc_decode(self.dp, address, size, protection)
+        fused_sink = blocks.vector_sink_b()
+        hier_sink = blocks.vector_sink_b()
+        self.tb.connect(src, s2v, fused, fused_sink)
+        self.tb.connect(s2v, hier, hier_sink)
+        self.tb.run()
+        self.assertEqual(len(fused_sink.data()), num_cifs * size // self.dp.subch_size_multiple_n[protection] * 24)
+        self.assertEqual(hier_sink.data(), fused_sink.data())
+
+    def test_001_t(self):
+        """
+        protection level 3-A, more CIFs than the time interleaver depth
+        """
+        self.compare_with_hier_block(54, 84, 2, 20)
+
+    def test_002_t(self):
+        """
+        protection level 1-A at the start of the CIF
+        """
+        self.compare_with_hier_block(0, 24, 0, 18)
+
+    def test_003_t(self):
+        """
+        retune to another sub-channel with a config message
+        """
+        syms_per_cif = self.dp.num_cus * self.dp.msc_cu_size // (2 * self.dp.num_carriers)
+        num_cifs = 18
+        data = [complex(random.gauss(0, 1), random.gauss(0, 1))
+                for _ in range(num_cifs * syms_per_cif * self.dp.num_carriers)]
+        src = blocks.vector_source_c(data)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, self.dp.num_carriers)
+        retuned = dab.msc_decode_vcb_make(self.dp.num_carriers, 0, 24, 0)
+        direct = dab.msc_decode_vcb_make(self.dp.num_carriers, 54, 84, 2)
+        retuned_sink = blocks.vector_sink_b()
+        direct_sink = blocks.vector_sink_b()
+        self.tb.connect(src, s2v, retuned, retuned_sink)
+        self.tb.connect(s2v, direct, direct_sink)
+        msg = pmt.make_dict()
+        msg = pmt.dict_add(msg, pmt.intern("address"), pmt.from_long(54))
+        msg = pmt.dict_add(msg, pmt.intern("size"), pmt.from_long(84))
+        msg = pmt.dict_add(msg, pmt.intern("protection"), pmt.from_long(2))
+        msg = pmt.dict_add(msg, pmt.intern("bit_rate_n"), pmt.from_long(14))
+        # queued messages are handled before the first call to general_work
+        retuned.to_basic_block()._post(pmt.intern("config"), msg)
+        self.tb.run()
+        self.assertEqual(direct_sink.data(), retuned_sink.data())
+        tags = retuned_sink.tags()
+        self.assertEqual(len(tags), 1)
+        self.assertEqual(tags[0].offset, 0)
+        self.assertEqual(pmt.symbol_to_string(tags[0].key), "bit_rate_n")
+        self.assertEqual(pmt.to_long(tags[0].value), 14)
+
+    def decode(self, data, address, size, protection, msg=None, warm_history=False):
+        tb = gr.top_block()
+        src = blocks.vector_source_c(data)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, self.dp.num_carriers)
+        decoder = dab.msc_decode_vcb_make(self.dp.num_carriers, address, size, protection, warm_history)
+        sink = blocks.vector_sink_b()
+        tb.connect(src, s2v, decoder, sink)
+        if msg is not None:
+            decoder.to_basic_block()._post(pmt.intern("config"), msg)
+        tb.run()
+        return sink
+
+    def test_004_t(self):
+        """
+        retune from the 22nd CIF on, the CIFs before are decoded with the old sub-channel
+        """
+        cif_len = self.dp.num_cus * self.dp.msc_cu_size // 2
+        num_cifs = 40
+        retune_cif = 21
+        data = [complex(random.gauss(0, 1), random.gauss(0, 1)) for _ in range(num_cifs * cif_len)]
+        msg = pmt.make_dict()
+        msg = pmt.dict_add(msg, pmt.intern("address"), pmt.from_long(54))
+        msg = pmt.dict_add(msg, pmt.intern("size"), pmt.from_long(84))
+        msg = pmt.dict_add(msg, pmt.intern("protection"), pmt.from_long(2))
+        msg = pmt.dict_add(msg, pmt.intern("bit_rate_n"), pmt.from_long(14))
+        msg = pmt.dict_add(msg, pmt.intern("cif"), pmt.from_long(retune_cif))
+        retuned = self.decode(data, 0, 24, 0, msg)
+        old = self.decode(data[:retune_cif * cif_len], 0, 24, 0)
+        new = self.decode(data[retune_cif * cif_len:], 54, 84, 2)
+        self.assertEqual(len(old.data()), retune_cif * 48)
+        self.assertEqual(retuned.data(), old.data() + new.data())
+        tags = retuned.tags()
+        self.assertEqual(len(tags), 1)
+        self.assertEqual(tags[0].offset, retune_cif * 48)
+        self.assertEqual(pmt.to_long(tags[0].value), 14)
+
+    def test_005_t(self):
+        """
+        retune mid-stream with warm_history, the first logical frame of the new sub-channel
+        is the one of a decoder that ran on it from the start
+        """
+        cif_len = self.dp.num_cus * self.dp.msc_cu_size // 2
+        num_cifs = 40
+        retune_cif = 21
+        # clean signal, the 8 bit history does not change any decision
+        data = [complex(random.choice((-1, 1)), random.choice((-1, 1))) for _ in range(num_cifs * cif_len)]
+        msg = pmt.make_dict()
+        msg = pmt.dict_add(msg, pmt.intern("address"), pmt.from_long(54))
+        msg = pmt.dict_add(msg, pmt.intern("size"), pmt.from_long(84))
+        msg = pmt.dict_add(msg, pmt.intern("protection"), pmt.from_long(2))
+        msg = pmt.dict_add(msg, pmt.intern("bit_rate_n"), pmt.from_long(14))
+        msg = pmt.dict_add(msg, pmt.intern("cif"), pmt.from_long(retune_cif))
+        retuned = self.decode(data, 0, 24, 0, msg, warm_history=True).data()
+        old = self.decode(data[:retune_cif * cif_len], 0, 24, 0).data()
+        direct = self.decode(data, 54, 84, 2).data()
+        self.assertEqual(len(retuned), retune_cif * 48 + (num_cifs - retune_cif) * 336)
+        self.assertEqual(retuned[:retune_cif * 48], old)
+        self.assertEqual(retuned[retune_cif * 48:retune_cif * 48 + 336], direct[retune_cif * 336:(retune_cif + 1) * 336])
+        self.assertEqual(retuned[retune_cif * 48:], direct[retune_cif * 336:])
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_msc_decode_vcb, "qa_msc_decode_vcb.xml")
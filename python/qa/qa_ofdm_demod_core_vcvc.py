@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks, fft
+from . import dab_swig as dab
+from parameters import dab_parameters
+from math import sqrt
+import pmt
+import numpy
+import random
+
+class qa_ofdm_demod_core_vcvc (gr_unittest.TestCase):
+    """
+    @brief QA for the fused OFDM demodulator core
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_001_t(self):
+        """
+        same output as fft_vcc - multiply_const_vcc - ofdm_coarse_frequency_correction_vcvc -
+        diff_phasor_vcc - frequency_interleaver_vcc for 2 frames of 10 symbols in mode II
+        """
+        dp = dab_parameters(2, 2048000, False)
+        num_symbols = 20
+        random.seed(0)
+        numpy.random.seed(0)
+        # random QPSK symbols on the carriers, shifted by 3 sub-carriers, plus noise
+        data = []
+        for _ in range(num_symbols):
+            spectrum = numpy.zeros(dp.fft_length, dtype=complex)
+            for k in range(-dp.num_carriers // 2, dp.num_carriers // 2 + 1):
+                if k != 0:
+                    spectrum[(k + 3) % dp.fft_length] = complex(random.choice([-1, 1]), random.choice([-1, 1]))
+            data += list(numpy.fft.ifft(spectrum) * dp.fft_length / 20.0 +
+                         numpy.random.normal(0, 0.1, dp.fft_length))
+        tags = []
+        for offset in [0, 10 * dp.fft_length]:
+            tag = gr.tag_t()
+            tag.offset = offset
+            tag.key = pmt.intern("Start")
+            tag.value = pmt.from_float(0)
+            tags.append(tag)
+        src = blocks.vector_source_c(data, False, 1, tags)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, dp.fft_length)
+        # single block chain as in former versions of ofdm_demod_cc
+        fft_block = fft.fft_vcc(dp.fft_length, True, [], True)
+        multiply = blocks.multiply_const_vcc([1.0 / sqrt(2048)] * dp.fft_length)
+        coarse_freq_corr = dab.ofdm_coarse_frequency_correction_vcvc_make(dp.fft_length, dp.num_carriers, dp.cp_length)
+        diff_phasor = dab.diff_phasor_vcc_make(dp.num_carriers)
+        deinterleaver = dab.frequency_interleaver_vcc_make(dp.frequency_deinterleaving_sequence_array)
+        ref_sink = blocks.vector_sink_c(dp.num_carriers)
+        # fused block
+        demod_core = dab.ofdm_demod_core_vcvc_make(dp.fft_length, dp.num_carriers,
+                                                   dp.frequency_deinterleaving_sequence_array)
+        sink = blocks.vector_sink_c(dp.num_carriers)
+        self.tb.connect(src, s2v, fft_block, multiply, coarse_freq_corr, diff_phasor, deinterleaver, ref_sink)
+        self.tb.connect(s2v, demod_core, sink)
+        self.tb.run()
+        self.assertEqual(len(sink.data()), num_symbols * dp.num_carriers)
+        self.assertComplexTuplesAlmostEqual(sink.data(), ref_sink.data(), 4)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ofdm_demod_core_vcvc, "qa_ofdm_demod_core_vcvc.xml")
@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+import pmt
+import numpy
+import random
+
+class qa_ofdm_demod_demux_vcvc (gr_unittest.TestCase):
+    """
+    @brief QA for the OFDM demodulator with FIC/MSC demux
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def run_both(self, mask, lost_symbols):
+        """
+        4 frames of 2 FIC and 4 MSC symbols through ofdm_demod_demux_vcvc and
+        through ofdm_demod_core_vcvc - demux_cc
+        """
+        fft_length = 64
+        num_carriers = 48
+        random.seed(0)
+        numpy.random.seed(0)
+        sequence = list(range(num_carriers))
+        random.shuffle(sequence)
+        data = []
+        tags = []
+        num_symbols = 0
+        for f in range(4):
+            for k in range(len(mask)):
+                if not mask[k] or (f, k) in lost_symbols:
+                    continue
+                if k == 0:
+                    tag = gr.tag_t()
+                    tag.offset = num_symbols * fft_length
+                    tag.key = pmt.intern("Start")
+                    tag.value = pmt.from_float(0)
+                    tags.append(tag)
+                spectrum = numpy.zeros(fft_length, dtype=complex)
+                for c in range(-num_carriers // 2, num_carriers // 2 + 1):
+                    if c != 0:
+                        spectrum[(c + 2) % fft_length] = complex(random.choice([-1, 1]), random.choice([-1, 1]))
+                data += list(numpy.fft.ifft(spectrum) * fft_length / 20.0 +
+                             numpy.random.normal(0, 0.1, fft_length))
+                num_symbols += 1
+        src = blocks.vector_source_c(data, False, 1, tags)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_gr_complex, fft_length)
+        demod_core = dab.ofdm_demod_core_vcvc_make(fft_length, num_carriers, sequence)
+        demux = dab.demux_cc_make(num_carriers, 2, 4, 0, mask)
+        ref_fic = blocks.vector_sink_c(num_carriers)
+        ref_msc = blocks.vector_sink_c(num_carriers)
+        demod = dab.ofdm_demod_demux_vcvc_make(fft_length, num_carriers, sequence, 2, 4, mask)
+        fic = blocks.vector_sink_c(num_carriers)
+        msc = blocks.vector_sink_c(num_carriers)
+        self.tb.connect(src, s2v, demod_core, demux, ref_fic)
+        self.tb.connect((demux, 1), ref_msc)
+        self.tb.connect(s2v, demod, fic)
+        self.tb.connect((demod, 1), msc)
+        self.tb.run()
+        self.assertEqual(len(fic.data()), 4 * 2 * num_carriers)
+        self.assertComplexTuplesAlmostEqual(fic.data(), ref_fic.data(), 4)
+        self.assertComplexTuplesAlmostEqual(msc.data(), ref_msc.data(), 4)
+
+    def test_001_t(self):
+        """
+        all symbols of the frames
+        """
+        self.run_both([1] * 7, [])
+
+    def test_002_t(self):
+        """
+        MSC symbols left out by the symbol mask and a symbol lost in the third frame
+        """
+        self.run_both([1, 1, 1, 0, 1, 0, 1], [(2, 4)])
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ofdm_demod_demux_vcvc, "qa_ofdm_demod_demux_vcvc.xml")
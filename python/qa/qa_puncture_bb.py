@@ -22,6 +22,7 @@
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 from . import dab_swig as dab
+import random
 
 class qa_puncture_bb (gr_unittest.TestCase):
     """
@@ -60,6 +61,21 @@ class qa_puncture_bb (gr_unittest.TestCase):
         result_data = dst.data()
         self.assertEqual(exp_res, result_data)
 
+    def puncture(self, punc_seq, src_data):
+        src = blocks.vector_source_b(src_data)
+        puncture = dab.puncture_bb_make(punc_seq)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, puncture, dst)
+        self.tb.run()
+        return dst.data()
+
+    def test_003_puncture_ff(self):
+        # a puncturing vector whose length is no multiple of the groups of 8 of the index tables
+        punc_seq = [random.randint(0, 1) for _ in range(101)] + [1]
+        src_data = [random.randint(0, 255) for _ in range(len(punc_seq) * 50)]
+        exp_res = tuple(x for (i, x) in enumerate(src_data) if punc_seq[i % len(punc_seq)])
+        self.assertEqual(exp_res, self.puncture(punc_seq, src_data))
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_puncture_bb, "qa_puncture_bb.xml")
@@ -23,6 +23,8 @@ from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 from . import dab_swig as dab
 import os
+import random
+import pmt
 
 class qa_reed_solomon_decode_bb (gr_unittest.TestCase):
 
@@ -59,6 +61,94 @@ class qa_reed_solomon_decode_bb (gr_unittest.TestCase):
         data = self.sink.data()
         self.assertEqual(data, self.prbs)
 
+    def test_002_t(self):
+        """
+        3 superframes of 40 interleaved codewords, with up to 5 byte errors in some of them
+        """
+        bit_rate_n = 40
+        random.seed(0)
+        payload = tuple([random.randint(0, 255) for _ in range(3 * bit_rate_n * 110)])
+        src = blocks.vector_source_b(payload)
+        rs_encoder = dab.reed_solomon_encode_bb_make(bit_rate_n)
+        encoded = blocks.vector_sink_b_make()
+        self.tb.connect(src, rs_encoder, encoded)
+        self.tb.run()
+        corrupted = list(encoded.data())
+        self.assertEqual(len(corrupted), 3 * bit_rate_n * 120)
+        # byte pos of codeword i of superframe f is at f * 120 * bit_rate_n + pos * bit_rate_n + i
+        for f in range(3):
+            for i in [0, 17, 31, 32, 39]:
+                for pos in random.sample(range(120), (i + f) % 5 + 1):
+                    corrupted[f * 120 * bit_rate_n + pos * bit_rate_n + i] ^= random.randint(1, 255)
+        tb = gr.top_block()
+        src = blocks.vector_source_b(corrupted)
+        rs_decoder = dab.reed_solomon_decode_bb_make(bit_rate_n)
+        sink = blocks.vector_sink_b_make()
+        tb.connect(src, rs_decoder, sink)
+        tb.run()
+        self.assertEqual(sink.data(), payload)
+
+    def test_003_t(self):
+        """
+        alignment to superframe_start tags, 17 bytes before the second superframe are dropped
+        """
+        bit_rate_n = 3
+        random.seed(1)
+        payload = tuple([random.randint(0, 255) for _ in range(3 * bit_rate_n * 110)])
+        src = blocks.vector_source_b(payload)
+        rs_encoder = dab.reed_solomon_encode_bb_make(bit_rate_n)
+        encoded = blocks.vector_sink_b_make()
+        self.tb.connect(src, rs_encoder, encoded)
+        self.tb.run()
+        superframe_size = 120 * bit_rate_n
+        data = list(encoded.data())
+        data = data[0:superframe_size] + [0] * 17 + data[superframe_size:]
+        tags = []
+        for offset in [0, superframe_size + 17, 2 * superframe_size + 17]:
+            tag = gr.tag_t()
+            tag.offset = offset
+            tag.key = pmt.intern("superframe_start")
+            tag.value = pmt.PMT_T
+            tags.append(tag)
+        tb = gr.top_block()
+        src = blocks.vector_source_b(data, False, 1, tags)
+        rs_decoder = dab.reed_solomon_decode_bb_make(bit_rate_n)
+        sink = blocks.vector_sink_b_make()
+        tb.connect(src, rs_decoder, sink)
+        tb.run()
+        self.assertEqual(sink.data(), payload)
+        self.assertEqual([t.offset for t in sink.tags()], [0, 110 * bit_rate_n, 220 * bit_rate_n])
+
+    def encode(self, bit_rate_n, payload):
+        tb = gr.top_block()
+        src = blocks.vector_source_b(payload)
+        rs_encoder = dab.reed_solomon_encode_bb_make(bit_rate_n)
+        sink = blocks.vector_sink_b_make()
+        tb.connect(src, rs_encoder, sink)
+        tb.run()
+        return list(sink.data())
+
+    def test_004_t(self):
+        """
+        retune from bit_rate_n 3 to 2 in the middle of a superframe, its first 100 bytes are dropped
+        """
+        random.seed(2)
+        old = tuple([random.randint(0, 255) for _ in range(2 * 3 * 110)])
+        new = tuple([random.randint(0, 255) for _ in range(2 * 2 * 110)])
+        old_encoded = self.encode(3, old)
+        data = old_encoded + old_encoded[0:100] + self.encode(2, new)
+        tag = gr.tag_t()
+        tag.offset = len(old_encoded) + 100
+        tag.key = pmt.intern("bit_rate_n")
+        tag.value = pmt.from_long(2)
+        src = blocks.vector_source_b(data, False, 1, [tag])
+        rs_decoder = dab.reed_solomon_decode_bb_make(3)
+        sink = blocks.vector_sink_b_make()
+        self.tb.connect(src, rs_decoder, sink)
+        self.tb.run()
+        self.assertEqual(sink.data(), old + new)
+        self.assertEqual([(t.offset, pmt.to_long(t.value)) for t in sink.tags()], [(len(old), 2)])
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_reed_solomon_decode_bb, "qa_reed_solomon_decode_bb.xml")
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+
+class qa_select_subchannels_vfvf (gr_unittest.TestCase):
+    """
+    @brief QA for the multi sub-channel select cus block
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_001_t(self):
+        vector01 = (1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16)
+        expected_results = ((1, 2, 3, 4, 9, 10, 11, 12), (5, 6, 7, 8, 13, 14, 15, 16))
+        src = blocks.vector_source_f(vector01)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_float, 4)
+        select = dab.select_subchannels_vfvf_make(4, 2, [0, 1], [1, 1])
+        self.tb.connect(src, s2v, select)
+        dsts = []
+        for i in range(2):
+            v2s = blocks.vector_to_stream_make(gr.sizeof_float, 4)
+            dst = blocks.vector_sink_f()
+            self.tb.connect((select, i), v2s, dst)
+            dsts.append(dst)
+        self.tb.run()
+        for dst, expected_result in zip(dsts, expected_results):
+            self.assertEqual(expected_result, dst.data())
+
+    def test_002_t(self):
+        """
+        compare every output with a select_cus_vfvf of the same sub-channel
+        """
+        frame_len = 54
+        addresses = [0, 10, 30, 12, 50]
+        sizes = [10, 20, 24, 3, 4]
+        data = tuple(range(2 * frame_len * 25))
+        src = blocks.vector_source_f(data)
+        s2v = blocks.stream_to_vector_make(gr.sizeof_float, 2)
+        select = dab.select_subchannels_vfvf_make(2, frame_len, addresses, sizes)
+        self.tb.connect(src, s2v, select)
+        pairs = []
+        for i in range(len(addresses)):
+            dst = blocks.vector_sink_f(2)
+            ref = blocks.vector_sink_f(2)
+            self.tb.connect((select, i), dst)
+            self.tb.connect(s2v, dab.select_cus_vfvf_make(2, frame_len, addresses[i], sizes[i]), ref)
+            pairs.append((dst, ref))
+        self.tb.run()
+        for i, (dst, ref) in enumerate(pairs):
+            self.assertEqual(len(dst.data()), 2 * 25 * sizes[i])
+            self.assertEqual(ref.data(), dst.data())
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_select_subchannels_vfvf, "qa_select_subchannels_vfvf.xml")
@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+
+class qa_time_deinterleave_bb (gr_unittest.TestCase):
+    """
+    @brief QA for the 8 bit time deinterleave block
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_001_t(self):
+        vector01 =          (1, 0, 3, 0, 5, 0,   7, 2, 9, 4, 11, 6,   13, 8, 15, 10, 17, 12)
+        expected_result =   (0, 0, 0, 0, 0, 0,   1, 2, 3, 4,  5, 6,    7, 8,  9, 10, 11, 12)
+        src = blocks.vector_source_b(vector01, True)
+        time_deinterleaver = dab.time_deinterleave_bb_make(6, [0, 1])
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, time_deinterleaver, blocks.head_make(gr.sizeof_char, 6*3), dst)
+        self.tb.run()
+        result = dst.data()
+        self.assertEqual(expected_result, result)
+
+    def test_002_t(self):
+        vector01 =          (1, 0, 0, 0,  5, 4, 0, 0,  9, 8, 3, 0,  13, 12, 7, 2)
+        expected_result =   (0, 0, 0, 0,  0, 4, 0, 0,  0, 8, 0, 0,   1, 12, 3, 0)
+        src = blocks.vector_source_b(vector01, True)
+        time_deinterleaver = dab.time_deinterleave_bb_make(4, [0, 3, 2, 1])
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, time_deinterleaver, blocks.head_make(gr.sizeof_char, 4*4), dst)
+        self.tb.run()
+        result = dst.data()
+        self.assertEqual(expected_result, result)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_time_deinterleave_bb, "qa_time_deinterleave_bb.xml")
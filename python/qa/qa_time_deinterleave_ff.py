@@ -77,7 +77,7 @@ class qa_time_deinterleave_ff (gr_unittest.TestCase):
         expected_result =   (0,0,0,4,0,0,0,8,0,0,0,12,0,0,0,16,0,0,3,4,0,0,7,8,0,0,11,12,0,0,15,16)
         src = blocks.vector_source_b(vector01, True)
         b2f = blocks.char_to_float_make()
-        time_deinterleaver = dab.time_deinterleave_ff_make(16, [0, 1, 2, 4])
+        time_deinterleaver = dab.time_deinterleave_ff_make(16, [0, 1, 2, 3])
         dst = blocks.vector_sink_f()
         self.tb.connect(src, b2f, time_deinterleaver, blocks.head_make(gr.sizeof_float, 16*2), dst)
         self.tb.run()
@@ -22,6 +22,7 @@
 from gnuradio import gr, gr_unittest, blocks
 from . import dab_swig as dab
 import cmath
+import random
 
 
 class qa_unpuncture_vff(gr_unittest.TestCase):
@@ -65,6 +66,24 @@ class qa_unpuncture_vff(gr_unittest.TestCase):
         result_data = dst.data()
         self.assertFloatTuplesAlmostEqual(exp_res, result_data)
 
+    def unpuncture(self, punc_seq, src_data):
+        src = blocks.vector_source_f(src_data)
+        s2v = blocks.stream_to_vector(gr.sizeof_float, sum(punc_seq))
+        unpuncture_vff = dab.unpuncture_vff(punc_seq, 77)
+        v2s = blocks.vector_to_stream(gr.sizeof_float, len(punc_seq))
+        dst = blocks.vector_sink_f()
+        self.tb.connect(src, s2v, unpuncture_vff, v2s, dst)
+        self.tb.run()
+        return dst.data()
+
+    def test_003_unpuncture_vff(self):
+        # a puncturing vector whose length is no multiple of the groups of 8 of the index tables
+        punc_seq = [random.randint(0, 1) for _ in range(101)] + [1]
+        src_data = [random.gauss(0, 1) for _ in range(sum(punc_seq) * 50)]
+        data = iter(src_data)
+        exp_res = [next(data) if p else 77 for _ in range(50) for p in punc_seq]
+        self.assertFloatTuplesAlmostEqual(exp_res, self.unpuncture(punc_seq, src_data), 6)
+
 
 if __name__ == '__main__':
     gr_unittest.main()
@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2018 Communications Engineering Lab (CEL) / Karlsruhe Institute of Technology (KIT).
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from . import dab_swig as dab
+from parameters import dab_parameters
+import random
+
+class qa_viterbi_vbb (gr_unittest.TestCase):
+    """
+    @brief QA for the 8 bit viterbi decoder block
+
+    This class implements a test bench to verify the corresponding C++ class.
+    """
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def encode_and_decode(self, data, framesize, soft, puncturing_vector=[]):
+        src = blocks.vector_source_b(data)
+        encoder = dab.conv_encoder_bb_make(framesize)
+        unpack = blocks.packed_to_unpacked_bb_make(1, gr.GR_MSB_FIRST)
+        b2f = blocks.char_to_float_make()
+        # map bit 0 to +soft and bit 1 to -soft
+        mult = blocks.multiply_const_ff(-2 * soft)
+        add = blocks.add_const_ff(soft)
+        f2c = blocks.float_to_char_make()
+        viterbi = dab.viterbi_vbb_make(framesize * 8, puncturing_vector)
+        sink = blocks.vector_sink_b()
+        if puncturing_vector:
+            puncture = dab.puncture_bb_make(puncturing_vector)
+            s2v = blocks.stream_to_vector_make(gr.sizeof_char, sum(puncturing_vector))
+            self.tb.connect(src, encoder, unpack, puncture, b2f, mult, add, f2c, s2v, viterbi, sink)
+        else:
+            s2v = blocks.stream_to_vector_make(gr.sizeof_char, 4 * framesize * 8 + 24)
+            self.tb.connect(src, encoder, unpack, b2f, mult, add, f2c, s2v, viterbi, sink)
+        self.tb.run()
+        return sink.data()
+
+    def test_001_t(self):
+        """
+        decode the reference frame of the convolutional encoder QA
+        """
+        data = (0x05, 0x00)
+        expected_result = (0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0)
+        result = self.encode_and_decode(data, 2, 64)
+        self.assertEqual(expected_result, result)
+
+    def test_002_t(self):
+        """
+        decode several FIC sized codewords with saturated soft bits
+        """
+        data = tuple([random.randint(0, 255) for _ in range(96 * 5)])
+        expected_result = tuple([(byte >> (7 - i)) & 1 for byte in data for i in range(8)])
+        result = self.encode_and_decode(data, 96, 500)
+        self.assertEqual(expected_result, result)
+
+    def test_003_t(self):
+        """
+        decode punctured FIC codewords without unpuncturing them first
+        """
+        dp = dab_parameters(1, 208.064e6, False)
+        data = tuple([random.randint(0, 255) for _ in range(96 * 5)])
+        expected_result = tuple([(byte >> (7 - i)) & 1 for byte in data for i in range(8)])
+        result = self.encode_and_decode(data, 96, 20, dp.assembled_fic_puncturing_sequence)
+        self.assertEqual(expected_result, result)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_viterbi_vbb, "qa_viterbi_vbb.xml")
@@ -38,6 +38,19 @@
 #include "dab/demux_cc.h"
 #include "dab/select_cus_vfvf.h"
 #include "dab/qpsk_mapper_vbvc.h"
+#include "dab/viterbi_vfb.h"
+#include "dab/msc_decode_vcb.h"
+#include "dab/fic_decode_vb.h"
+#include "dab/ofdm_demod_core_vcvc.h"
+#include "dab/complex_to_interleaved_char_vcb.h"
+#include "dab/select_cus_vbvb.h"
+#include "dab/time_deinterleave_bb.h"
+#include "dab/unpuncture_vbb.h"
+#include "dab/viterbi_vbb.h"
+#include "dab/ensemble_msc_decoder.h"
+#include "dab/select_subchannels_vfvf.h"
+#include "dab/energy_dispersal_bb.h"
+#include "dab/ofdm_demod_demux_vcvc.h"
 %}
 
 
@@ -116,3 +129,29 @@ GR_SWIG_BLOCK_MAGIC2(dab, demux_cc);
 GR_SWIG_BLOCK_MAGIC2(dab, select_cus_vfvf);
 %include "dab/qpsk_mapper_vbvc.h"
 GR_SWIG_BLOCK_MAGIC2(dab, qpsk_mapper_vbvc);
+%include "dab/viterbi_vfb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, viterbi_vfb);
+%include "dab/msc_decode_vcb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, msc_decode_vcb);
+%include "dab/fic_decode_vb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, fic_decode_vb);
+%include "dab/ofdm_demod_core_vcvc.h"
+GR_SWIG_BLOCK_MAGIC2(dab, ofdm_demod_core_vcvc);
+%include "dab/complex_to_interleaved_char_vcb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, complex_to_interleaved_char_vcb);
+%include "dab/select_cus_vbvb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, select_cus_vbvb);
+%include "dab/time_deinterleave_bb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, time_deinterleave_bb);
+%include "dab/unpuncture_vbb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, unpuncture_vbb);
+%include "dab/viterbi_vbb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, viterbi_vbb);
+%include "dab/ensemble_msc_decoder.h"
+GR_SWIG_BLOCK_MAGIC2(dab, ensemble_msc_decoder);
+%include "dab/select_subchannels_vfvf.h"
+GR_SWIG_BLOCK_MAGIC2(dab, select_subchannels_vfvf);
+%include "dab/energy_dispersal_bb.h"
+GR_SWIG_BLOCK_MAGIC2(dab, energy_dispersal_bb);
+%include "dab/ofdm_demod_demux_vcvc.h"
+GR_SWIG_BLOCK_MAGIC2(dab, ofdm_demod_demux_vcvc);